@@ -0,0 +1,536 @@
+#include <sirius.h>
+#include <fstream>
+#include <functional>
+#include <regex>
+
+using namespace sirius;
+
+/* micro-benchmarks of the performance critical kernels on a synthetic unit cell */
+
+/// Parameters of the benchmark run.
+struct bench_params
+{
+    /// Number of primitive cells along each lattice direction.
+    int cell_size{2};
+    /// Lattice constant of the primitive cell.
+    double a{5};
+    /// Plane-wave cutoff of the density and potential.
+    double pw_cutoff{20};
+    /// Cutoff of the |G+k| vectors of the wave-functions.
+    double gk_cutoff{6};
+    /// Number of bands.
+    int num_bands{100};
+    /// Number of warm-up calls of the kernel.
+    int warmup{1};
+    /// Number of timed calls of the kernel.
+    int repeat{5};
+    /// Processing unit.
+    std::string processing_unit{"cpu"};
+};
+
+/// Work performed by a single call of the benchmarked kernel.
+struct bench_work
+{
+    double flops{0};
+    double bytes{0};
+};
+
+/// Time the kernel and collect the performance figures.
+/** Kernel is called bench_params::warmup times without timing and then bench_params::repeat times. Each timed
+ *  call is also recorded by a utils::timer, so the output is readable by the scripts in apps/timers. */
+inline json run_kernel(std::string label__, bench_params const& p__, bench_work w__, std::function<void(void)> f__)
+{
+    auto& comm = Communicator::world();
+
+    for (int i = 0; i < p__.warmup; i++) {
+        f__();
+    }
+    comm.barrier();
+
+    std::vector<double> t(p__.repeat);
+    for (int i = 0; i < p__.repeat; i++) {
+        comm.barrier();
+        double t0 = -omp_get_wtime();
+        {
+            utils::timer t1("sirius_bench::" + label__);
+            f__();
+            if (acc::num_devices()) {
+                acc::sync();
+            }
+        }
+        comm.barrier();
+        t[i] = t0 + omp_get_wtime();
+    }
+
+    double tmin = *std::min_element(t.begin(), t.end());
+    double tmax = *std::max_element(t.begin(), t.end());
+    double tavg = std::accumulate(t.begin(), t.end(), 0.0) / std::max(p__.repeat, 1);
+
+    /* the work is given per rank; performance is reported for the whole communicator */
+    comm.allreduce(&w__.flops, 1);
+    comm.allreduce(&w__.bytes, 1);
+
+    json dict;
+    dict["repeat"]   = p__.repeat;
+    dict["time"]     = {{"min", tmin}, {"avg", tavg}, {"max", tmax}};
+    dict["flops"]    = w__.flops;
+    dict["bytes"]    = w__.bytes;
+    dict["GFlops"]   = (tavg > 0) ? w__.flops / tavg / 1e9 : 0;
+    dict["GB/s"]     = (tavg > 0) ? w__.bytes / tavg / 1e9 : 0;
+
+    if (comm.rank() == 0) {
+        printf("%-36s  time (min/avg/max): %10.6f %10.6f %10.6f sec.,  %10.3f GFlops,  %10.3f GB/s\n",
+               label__.c_str(), tmin, tavg, tmax, dict["GFlops"].get<double>(), dict["GB/s"].get<double>());
+    }
+    return std::move(dict);
+}
+
+/// Create a simple cubic supercell of synthetic ultrasoft atoms.
+/** Each primitive cell contains one atom with s- and p- beta-projectors and augmentation charge, so all
+ *  non-local and augmentation kernels are exercised. */
+std::unique_ptr<Simulation_context> create_context(bench_params const& p__)
+{
+    std::unique_ptr<Simulation_context> ctx(new Simulation_context(
+        "{\"parameters\" : {\"electronic_structure_method\" : \"pseudopotential\"}}", Communicator::world()));
+
+    ctx->set_processing_unit(p__.processing_unit);
+    ctx->set_pw_cutoff(p__.pw_cutoff);
+    ctx->set_gk_cutoff(p__.gk_cutoff);
+    ctx->num_bands(p__.num_bands);
+
+    double L = p__.a * p__.cell_size;
+    ctx->unit_cell().set_lattice_vectors({{L, 0, 0}, {0, L, 0}, {0, 0, L}});
+
+    ctx->unit_cell().add_atom_type("X");
+    auto& atype = ctx->unit_cell().atom_type(0);
+    atype.zn(4);
+    atype.set_radial_grid(radial_grid_t::lin_exp, 1000, 0, 2, 6);
+
+    std::vector<double> beta(atype.num_mt_points());
+    for (int l = 0; l <= 1; l++) {
+        for (int i = 0; i < atype.num_mt_points(); i++) {
+            double x = atype.radial_grid(i);
+            beta[i] = std::pow(x, l + 1) * std::exp(-x) * (4 - x * x);
+        }
+        atype.add_beta_radial_function(l, beta);
+    }
+    /* augmentation charge for all allowed (idxrf1, idxrf2, l) combinations */
+    std::vector<double> qrf(atype.num_mt_points());
+    for (int l2 = 0; l2 <= 1; l2++) {
+        for (int l1 = 0; l1 <= l2; l1++) {
+            for (int l = std::abs(l1 - l2); l <= l1 + l2; l += 2) {
+                for (int i = 0; i < atype.num_mt_points(); i++) {
+                    double x = atype.radial_grid(i);
+                    qrf[i] = std::pow(x, l + 2) * std::exp(-2 * x);
+                }
+                atype.add_q_radial_function(l1, l2, l, qrf);
+            }
+        }
+    }
+
+    for (int i0 = 0; i0 < p__.cell_size; i0++) {
+        for (int i1 = 0; i1 < p__.cell_size; i1++) {
+            for (int i2 = 0; i2 < p__.cell_size; i2++) {
+                ctx->unit_cell().add_atom("X", {double(i0) / p__.cell_size, double(i1) / p__.cell_size,
+                                                double(i2) / p__.cell_size});
+            }
+        }
+    }
+    ctx->initialize();
+
+    return std::move(ctx);
+}
+
+/// Floating point operations of a complex 3D FFT of a given size.
+inline double fft_flops(size_t size__)
+{
+    return 5.0 * size__ * std::log2(static_cast<double>(size__));
+}
+
+/// Fill wave-functions with random numbers and move them to the device memory if needed.
+inline void init_wf(Simulation_context const& ctx__, Wave_functions& wf__)
+{
+    wf__.pw_coeffs(0).prime() = [](int64_t i0, int64_t i1){return utils::random<double_complex>();};
+    if (is_device_memory(ctx__.preferred_memory_t())) {
+        wf__.allocate(spin_idx(0), ctx__.preferred_memory_t());
+        wf__.copy_to(spin_idx(0), ctx__.preferred_memory_t(), 0, wf__.num_wf());
+    }
+}
+
+/// Benchmark of the coarse-grid FFT.
+template <int direction>
+json bench_fft3d(Simulation_context& ctx__, K_point& kp__, bench_params const& p__)
+{
+    auto& fft = ctx__.fft_coarse();
+    auto& gvp = ctx__.gvec_coarse_partition();
+
+    fft.prepare(gvp);
+
+    mdarray<double_complex, 1> f(gvp.gvec_count_fft());
+    f = [](int64_t i){return utils::random<double_complex>();};
+
+    bench_work w;
+    w.flops = fft_flops(fft.size()) / fft.comm().size();
+    w.bytes = 2.0 * sizeof(double_complex) * fft.local_size();
+
+    auto r = run_kernel(direction == 1 ? "fft3d_backward" : "fft3d_forward", p__, w, [&]() {
+        fft.transform<direction>(f.at(memory_t::host));
+    });
+
+    fft.dismiss();
+
+    return std::move(r);
+}
+
+/// Benchmark of the local part of the Hamiltonian.
+json bench_apply_h(Simulation_context& ctx__, K_point& kp__, bench_params const& p__)
+{
+    int n = p__.num_bands;
+    Wave_functions phi(kp__.gkvec_partition(), n, ctx__.preferred_memory_t());
+    Wave_functions hphi(kp__.gkvec_partition(), n, ctx__.preferred_memory_t());
+    init_wf(ctx__, phi);
+    if (is_device_memory(ctx__.preferred_memory_t())) {
+        hphi.allocate(spin_idx(0), ctx__.preferred_memory_t());
+    }
+
+    auto& fft = ctx__.fft_coarse();
+    Local_operator hloc(ctx__, fft, ctx__.gvec_coarse_partition());
+    fft.prepare(kp__.gkvec_partition());
+    hloc.prepare(kp__.gkvec_partition());
+
+    bench_work w;
+    w.flops = n * (2 * fft_flops(fft.size()) + 6.0 * fft.size()) / fft.comm().size();
+    w.bytes = n * (4.0 * sizeof(double_complex) * fft.local_size() + sizeof(double) * fft.local_size());
+
+    auto r = run_kernel("local_operator_apply_h", p__, w, [&]() {
+        hloc.apply_h(0, phi, hphi, 0, n);
+    });
+
+    hloc.dismiss();
+    fft.dismiss();
+
+    return std::move(r);
+}
+
+/// Benchmark of the <beta|phi> inner product or the application of |beta>D<beta|phi>.
+template <bool apply>
+json bench_beta(Simulation_context& ctx__, K_point& kp__, bench_params const& p__)
+{
+    int n = p__.num_bands;
+    Wave_functions phi(kp__.gkvec_partition(), n, ctx__.preferred_memory_t());
+    Wave_functions hphi(kp__.gkvec_partition(), n, ctx__.preferred_memory_t());
+    init_wf(ctx__, phi);
+    if (is_device_memory(ctx__.preferred_memory_t())) {
+        hphi.allocate(spin_idx(0), ctx__.preferred_memory_t());
+    }
+
+    auto& bp = kp__.beta_projectors();
+    bp.prepare();
+
+    D_operator<double_complex> d_op(ctx__);
+
+    bench_work w;
+    double ngk = kp__.num_gkvec_loc();
+    double nbeta = ctx__.unit_cell().mt_lo_basis_size();
+    w.flops = 8.0 * nbeta * n * ngk;
+    w.bytes = sizeof(double_complex) * (nbeta * ngk + 2.0 * n * ngk + nbeta * n);
+
+    std::string label = apply ? "beta_projectors_apply" : "beta_projectors_inner";
+
+    auto r = run_kernel(label, p__, w, [&]() {
+        for (int ichunk = 0; ichunk < bp.num_chunks(); ichunk++) {
+            bp.generate(ichunk);
+            auto beta_phi = bp.inner<double_complex>(ichunk, phi, 0, 0, n);
+            if (apply) {
+                d_op.apply(ichunk, 0, hphi, 0, n, bp, beta_phi);
+            }
+        }
+    });
+
+    bp.dismiss();
+
+    return std::move(r);
+}
+
+/// Benchmark of the distributed wave-function kernels: inner(), transform() and orthogonalize().
+template <int kernel>
+json bench_wf(Simulation_context& ctx__, K_point& kp__, bench_params const& p__)
+{
+    auto mem = ctx__.preferred_memory_t();
+    auto la  = ctx__.blas_linalg_t();
+
+    int n = p__.num_bands;
+    Wave_functions phi(kp__.gkvec_partition(), 2 * n, mem);
+    Wave_functions tmp(kp__.gkvec_partition(), 2 * n, mem);
+    init_wf(ctx__, phi);
+    if (is_device_memory(mem)) {
+        tmp.allocate(spin_idx(0), mem);
+    }
+
+    int bs = ctx__.cyclic_block_size();
+    dmatrix<double_complex> ovlp(2 * n, 2 * n, ctx__.blacs_grid(), bs, bs);
+    if (is_device_memory(mem)) {
+        ovlp.allocate(mem);
+    }
+
+    double ngk = kp__.num_gkvec_loc();
+
+    bench_work w;
+    json r;
+    switch (kernel) {
+        case 0: {
+            w.flops = 8.0 * n * n * ngk;
+            w.bytes = sizeof(double_complex) * (2.0 * n * ngk + n * n);
+            r = run_kernel("wf_inner", p__, w, [&]() {
+                inner(mem, la, 0, phi, 0, n, phi, n, n, ovlp, 0, 0);
+            });
+            break;
+        }
+        case 1: {
+            for (int j = 0; j < ovlp.num_cols_local(); j++) {
+                for (int i = 0; i < ovlp.num_rows_local(); i++) {
+                    ovlp(i, j) = utils::random<double_complex>();
+                }
+            }
+            if (is_device_memory(mem)) {
+                ovlp.copy_to(mem);
+            }
+            w.flops = 8.0 * n * n * ngk;
+            w.bytes = sizeof(double_complex) * (2.0 * n * ngk + n * n);
+            r = run_kernel("wf_transform", p__, w, [&]() {
+                transform<double_complex>(mem, la, 0, {&phi}, 0, n, ovlp, 0, 0, {&tmp}, 0, n);
+            });
+            break;
+        }
+        case 2: {
+            /* orthogonalize the second block of n functions to the first one and to itself;
+               first block is orthonormalized only once */
+            orthogonalize<double_complex, 0, 0>(mem, la, 0, {&phi}, 0, n, ovlp, tmp);
+            /* inner products with the N and n blocks and transformation */
+            w.flops = 8.0 * ngk * (2.0 * n * n + n * n + 2.0 * n * n) + 8.0 * n * n * n / 3;
+            w.bytes = sizeof(double_complex) * (6.0 * n * ngk + 2.0 * n * n);
+            r = run_kernel("wf_orthogonalize", p__, w, [&]() {
+                orthogonalize<double_complex, 0, 0>(mem, la, 0, {&phi}, n, n, ovlp, tmp);
+            });
+            break;
+        }
+    }
+
+    return std::move(r);
+}
+
+/// Benchmark of the symmetrization of the plane-wave coefficients of a scalar function.
+json bench_symmetrize_function(Simulation_context& ctx__, K_point& kp__, bench_params const& p__)
+{
+    auto& remap_gvec = ctx__.remap_gvec();
+
+    mdarray<double_complex, 1> f(ctx__.gvec().count());
+    f = [](int64_t i){return utils::random<double_complex>();};
+
+    int nsym = ctx__.unit_cell().symmetry().num_mag_sym();
+
+    bench_work w;
+    w.flops = 14.0 * nsym * ctx__.gvec().count();
+    w.bytes = 2.0 * sizeof(double_complex) * nsym * ctx__.gvec().count();
+
+    return run_kernel("symmetrize_function", p__, w, [&]() {
+        ctx__.unit_cell().symmetry().symmetrize_function(f.at(memory_t::host), remap_gvec, ctx__.sym_phase_factors());
+    });
+}
+
+/// Benchmark of the density mixers.
+/** Mixer is fed with the plane-wave coefficients of a random density and the time of a single mix() call is
+ *  measured after the history is filled. */
+template <typename M>
+json bench_mixer(Simulation_context& ctx__, K_point& kp__, bench_params const& p__)
+{
+    int ng = ctx__.gvec().count();
+    int max_history{8};
+
+    std::unique_ptr<Mixer<double_complex>> mixer;
+    if (std::is_same<M, Linear_mixer<double_complex>>::value) {
+        mixer = std::unique_ptr<Mixer<double_complex>>(new Linear_mixer<double_complex>(0, ng, 0.5, ctx__.comm()));
+    }
+    if (std::is_same<M, Broyden1<double_complex>>::value) {
+        mixer = std::unique_ptr<Mixer<double_complex>>(
+            new Broyden1<double_complex>(0, ng, max_history, 0.5, 0.1, 1.0, ctx__.comm()));
+    }
+    if (std::is_same<M, Broyden2<double_complex>>::value) {
+        mixer = std::unique_ptr<Mixer<double_complex>>(
+            new Broyden2<double_complex>(0, ng, max_history, 0.5, 0.1, 1e-6, 1.0, ctx__.comm()));
+    }
+
+    auto input = [&]() {
+        for (int ig = 0; ig < ng; ig++) {
+            mixer->input_local(ig, utils::random<double_complex>());
+        }
+    };
+
+    input();
+    mixer->initialize();
+    for (int i = 0; i < max_history; i++) {
+        input();
+        mixer->mix(1e-16);
+    }
+
+    bench_work w;
+    w.flops = 8.0 * 2 * max_history * ng;
+    w.bytes = sizeof(double_complex) * 2 * max_history * ng;
+
+    std::string label = std::is_same<M, Linear_mixer<double_complex>>::value ? "mixer_linear" :
+        (std::is_same<M, Broyden1<double_complex>>::value ? "mixer_broyden1" : "mixer_broyden2");
+
+    return run_kernel(label, p__, w, [&]() {
+        input();
+        mixer->mix(1e-16);
+    });
+}
+
+/// Benchmark of the generation of the augmentation charge.
+json bench_generate_rho_aug(Simulation_context& ctx__, K_point& kp__, bench_params const& p__)
+{
+    Density rho(ctx__);
+    auto& dm = rho.density_matrix();
+    for (size_t i = 0; i < dm.size(); i++) {
+        dm[i] = utils::random<double_complex>();
+    }
+
+    mdarray<double_complex, 2> rho_aug(ctx__.gvec().count(), ctx__.num_mag_dims() + 1);
+    if (ctx__.processing_unit() == device_t::GPU) {
+        rho_aug.allocate(memory_t::device);
+    }
+
+    double ng = ctx__.gvec().count();
+    bench_work w;
+    for (int iat = 0; iat < ctx__.unit_cell().num_atom_types(); iat++) {
+        auto& type = ctx__.unit_cell().atom_type(iat);
+        double nqlm = type.mt_basis_size() * (type.mt_basis_size() + 1) / 2;
+        double na = type.num_atoms();
+        /* phase factors, dm(G) = sum_a dm_a exp(-iGr_a) and rho(G) = sum Q(G) dm(G) */
+        w.flops += 8.0 * na * ng + 4.0 * nqlm * na * ng + 8.0 * nqlm * ng;
+        w.bytes += 16.0 * (na * ng + 2 * nqlm * ng);
+    }
+
+    return run_kernel("generate_rho_aug", p__, w, [&]() {
+        switch (ctx__.processing_unit()) {
+            case device_t::CPU: {
+                rho.generate_rho_aug<device_t::CPU>(rho_aug);
+                break;
+            }
+            case device_t::GPU: {
+                rho.generate_rho_aug<device_t::GPU>(rho_aug);
+                break;
+            }
+        }
+    });
+}
+
+using bench_func_t = std::function<json(Simulation_context&, K_point&, bench_params const&)>;
+
+/// Registry of the available benchmarks.
+std::vector<std::pair<std::string, bench_func_t>> const& bench_registry()
+{
+    static std::vector<std::pair<std::string, bench_func_t>> reg = {
+        {"fft3d_forward",                  bench_fft3d<-1>},
+        {"fft3d_backward",                 bench_fft3d<1>},
+        {"local_operator_apply_h",         bench_apply_h},
+        {"beta_projectors_inner",          bench_beta<false>},
+        {"beta_projectors_apply",          bench_beta<true>},
+        {"wf_inner",                       bench_wf<0>},
+        {"wf_transform",                   bench_wf<1>},
+        {"wf_orthogonalize",               bench_wf<2>},
+        {"symmetrize_function",            bench_symmetrize_function},
+        {"mixer_linear",                   bench_mixer<Linear_mixer<double_complex>>},
+        {"mixer_broyden1",                 bench_mixer<Broyden1<double_complex>>},
+        {"mixer_broyden2",                 bench_mixer<Broyden2<double_complex>>},
+        {"generate_rho_aug",               bench_generate_rho_aug}
+    };
+    return reg;
+}
+
+void run_benchmarks(bench_params const& p__, std::string filter__, std::string output_file__)
+{
+    auto ctx = create_context(p__);
+
+    /* a single k-point provides |G+k| vectors and beta-projectors */
+    K_point_set kset(*ctx, std::vector<int>({1, 1, 1}), std::vector<int>({0, 0, 0}), false);
+    auto& kp = *kset[0];
+
+    auto& comm = Communicator::world();
+    if (comm.rank() == 0) {
+        printf("number of atoms          : %i\n", ctx->unit_cell().num_atoms());
+        printf("number of bands          : %i\n", p__.num_bands);
+        printf("number of G-vectors      : %i\n", ctx->gvec().num_gvec());
+        printf("number of G+k vectors    : %i\n", kp.num_gkvec());
+        printf("number of beta-projectors: %i\n", ctx->unit_cell().mt_lo_basis_size());
+        printf("coarse FFT grid          : %i %i %i\n", ctx->fft_coarse().size(0), ctx->fft_coarse().size(1),
+               ctx->fft_coarse().size(2));
+        printf("number of symmetries     : %i\n", ctx->unit_cell().symmetry().num_mag_sym());
+    }
+
+    json dict;
+    dict["params"] = {{"cell_size", p__.cell_size},
+                      {"num_atoms", ctx->unit_cell().num_atoms()},
+                      {"pw_cutoff", p__.pw_cutoff},
+                      {"gk_cutoff", p__.gk_cutoff},
+                      {"num_bands", p__.num_bands},
+                      {"warmup", p__.warmup},
+                      {"repeat", p__.repeat},
+                      {"processing_unit", p__.processing_unit},
+                      {"num_ranks", comm.size()},
+                      {"num_threads", omp_get_max_threads()}};
+
+    std::regex re(filter__);
+    for (auto& e: bench_registry()) {
+        if (std::regex_search(e.first, re)) {
+            dict["benchmarks"][e.first] = e.second(*ctx, kp, p__);
+        }
+    }
+
+    if (comm.rank() == 0) {
+        dict["flat"] = utils::timer::serialize();
+        std::ofstream ofs(output_file__, std::ofstream::out | std::ofstream::trunc);
+        ofs << dict.dump(4);
+    }
+}
+
+int main(int argn, char** argv)
+{
+    cmd_args args;
+    args.register_key("--cell_size=", "{int} number of primitive cells along each lattice direction");
+    args.register_key("--pw_cutoff=", "{double} plane-wave cutoff of density and potential");
+    args.register_key("--gk_cutoff=", "{double} cutoff of |G+k| vectors of the wave-functions");
+    args.register_key("--num_bands=", "{int} number of bands");
+    args.register_key("--warmup=", "{int} number of warm-up calls of each kernel");
+    args.register_key("--repeat=", "{int} number of timed calls of each kernel");
+    args.register_key("--processing_unit=", "{string} type of processing unit (cpu or gpu)");
+    args.register_key("--filter=", "{string} regular expression to select the benchmarks");
+    args.register_key("--output=", "{string} name of the output JSON file");
+    args.register_key("--list", "list available benchmarks");
+
+    args.parse_args(argn, argv);
+    if (args.exist("help")) {
+        printf("Usage: %s [options]\n", argv[0]);
+        args.print_help();
+        return 0;
+    }
+    if (args.exist("list")) {
+        for (auto& e: bench_registry()) {
+            printf("%s\n", e.first.c_str());
+        }
+        return 0;
+    }
+
+    bench_params p;
+    p.cell_size       = args.value<int>("cell_size", p.cell_size);
+    p.pw_cutoff       = args.value<double>("pw_cutoff", p.pw_cutoff);
+    p.gk_cutoff       = args.value<double>("gk_cutoff", p.gk_cutoff);
+    p.num_bands       = args.value<int>("num_bands", p.num_bands);
+    p.warmup          = args.value<int>("warmup", p.warmup);
+    p.repeat          = args.value<int>("repeat", p.repeat);
+    p.processing_unit = args.value<std::string>("processing_unit", p.processing_unit);
+
+    sirius::initialize(1);
+    run_benchmarks(p, args.value<std::string>("filter", ".*"), args.value<std::string>("output", "bench.json"));
+    sirius::finalize();
+}
@@ -96,6 +96,35 @@ double ground_state(Simulation_context& ctx,
         }
     }
 
+    /* short steepest descent relaxation; used to check the extrapolation between the ionic steps */
+    auto relax_steps = args.value<int>("relax_steps", 0);
+    if (relax_steps) {
+        auto step_size = args.value<double>("relax_step_size", 0.5);
+        std::vector<int> num_scf_iter({result.value("num_scf_iterations", inp.num_dft_iter_)});
+        for (int istep = 0; istep < relax_steps; istep++) {
+            auto& forces = dft.forces().calc_forces_total();
+            for (int ia = 0; ia < ctx.unit_cell().num_atoms(); ia++) {
+                auto& atom = ctx.unit_cell().atom(ia);
+                auto r = ctx.unit_cell().get_cartesian_coordinates(atom.position());
+                for (int x: {0, 1, 2}) {
+                    r[x] += step_size * forces(x, ia);
+                }
+                atom.set_position(ctx.unit_cell().get_fractional_coordinates(r));
+            }
+            dft.update();
+            result = dft.find(inp.potential_tol_, inp.energy_tol_, inp.num_dft_iter_, write_state);
+            num_scf_iter.push_back(result.value("num_scf_iterations", inp.num_dft_iter_));
+        }
+        if (ctx.comm().rank() == 0) {
+            printf("number of SCF iterations at each ionic step: ");
+            for (int n: num_scf_iter) {
+                printf("%i ", n);
+            }
+            printf("\n");
+        }
+        result["relax"]["num_scf_iterations"] = num_scf_iter;
+    }
+
     dft.print_magnetic_moment();
 
     if (!ctx.full_potential()) {
@@ -357,6 +386,8 @@ int main(int argn, char** argv)
     args.register_key("--gen_evp_solver_name=", "{string} generalized eigen-value solver");
     args.register_key("--processing_unit=", "{string} type of the processing unit");
     args.register_key("--repeat_update=", "{int} number of times to repeat update()");
+    args.register_key("--relax_steps=", "{int} number of steepest descent steps of the atomic relaxation");
+    args.register_key("--relax_step_size=", "{double} step size of the relaxation (bohr^2 / Ha)");
     args.register_key("--control.processing_unit=", "");
     args.register_key("--control.mpi_grid_dims=","");
     args.register_key("--control.std_evp_solver_name=", "");
@@ -366,7 +397,10 @@ int main(int argn, char** argv)
     args.register_key("--parameters.ngridk=", "");
     args.register_key("--parameters.gamma_point=", "");
     args.register_key("--parameters.pw_cutoff=", "");
+    args.register_key("--parameters.molecule=", "");
+    args.register_key("--parameters.molecule_poisson_solver=", "");
     args.register_key("--iterative_solver.orthogonalize=", "");
+    args.register_key("--settings.extrapolation_order=", "");
 
     args.parse_args(argn, argv);
     if (args.exist("help")) {
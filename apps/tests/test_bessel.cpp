@@ -2,9 +2,72 @@
 
 using namespace sirius;
 
+/* batched spherical Bessel functions against the GSL implementation */
+int test_bessel(int lmax__, int n__, double xmax__, int repeat__)
+{
+    std::vector<double> x(n__);
+    for (int i = 0; i < n__; i++) {
+        /* include the origin and the small arguments */
+        x[i] = xmax__ * std::pow(double(i) / std::max(1, n__ - 1), 2);
+    }
+
+    mdarray<double, 2> jl_ref(lmax__ + 1, n__);
+    mdarray<double, 2> jl(lmax__ + 1, n__);
 
+    double t0 = -omp_get_wtime();
+    for (int k = 0; k < repeat__; k++) {
+        for (int i = 0; i < n__; i++) {
+            gsl_sf_bessel_jl_array(lmax__, x[i], &jl_ref(0, i));
+        }
+    }
+    t0 += omp_get_wtime();
+
+    double t1 = -omp_get_wtime();
+    for (int k = 0; k < repeat__; k++) {
+        Spherical_Bessel_functions::sbessel(lmax__, n__, x.data(),
+                                            [&](int l, int i) -> double& { return jl(l, i); });
+    }
+    t1 += omp_get_wtime();
+
+    double diff{0};
+    for (int i = 0; i < n__; i++) {
+        for (int l = 0; l <= lmax__; l++) {
+            diff = std::max(diff, std::abs(jl(l, i) - jl_ref(l, i)));
+        }
+    }
+    printf("lmax: %i, number of points: %i, maximum argument: %f\n", lmax__, n__, xmax__);
+    printf("GSL     : %12.6f sec.\n", t0);
+    printf("batched : %12.6f sec., speedup : %8.4f\n", t1, t0 / t1);
+    printf("maximum difference: %18.12e\n", diff);
+    return (diff < 1e-14) ? 0 : 1;
+}
 
 int main(int argn, char** argv)
 {
-    printf("%18.12f\n",  gsl_sf_bessel_Jnu(0.5, 4.71238898038468967400));
+    cmd_args args;
+    args.register_key("--lmax=", "{int} maximum orbital quantum number");
+    args.register_key("--n=", "{int} number of arguments");
+    args.register_key("--xmax=", "{double} maximum argument");
+    args.register_key("--repeat=", "{int} number of repetitions");
+
+    args.parse_args(argn, argv);
+    if (args.exist("help")) {
+        printf("Usage: %s [options]\n", argv[0]);
+        args.print_help();
+        return 0;
+    }
+    auto lmax   = args.value<int>("lmax", 10);
+    auto n      = args.value<int>("n", 10000);
+    auto xmax   = args.value<double>("xmax", 100.0);
+    auto repeat = args.value<int>("repeat", 10);
+
+    sirius::initialize(1);
+    int err = test_bessel(lmax, n, xmax, repeat);
+    if (err) {
+        printf("\x1b[31m" "Fail\n" "\x1b[0m" "\n");
+    } else {
+        printf("\x1b[32m" "OK\n" "\x1b[0m" "\n");
+    }
+    sirius::finalize();
+    return err;
 }
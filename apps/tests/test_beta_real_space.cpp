@@ -0,0 +1,139 @@
+#include <sirius.h>
+
+using namespace sirius;
+
+/* Hamiltonian applied to the test functions at one k-point; with local_only__ only the local part is applied */
+mdarray<double_complex, 2> apply_h(json const& dict__, vector3d<double> vk__, int num_wf__, bool local_only__)
+{
+    Simulation_context ctx(dict__.dump(), Communicator::world());
+    ctx.initialize();
+
+    if (ctx.control().beta_real_space_ && !Beta_projectors_real_space::is_applicable(ctx)) {
+        TERMINATE("real-space beta-projectors are not supported for this input");
+    }
+
+    K_point kp(ctx, &vk__[0], 1.0);
+    kp.initialize();
+
+    Density density(ctx);
+    Potential potential(ctx);
+    density.initial_density();
+    potential.generate(density);
+
+    Hamiltonian H(ctx, potential);
+
+    Wave_functions phi(kp.gkvec_partition(), num_wf__, memory_t::host);
+    Wave_functions hphi(kp.gkvec_partition(), num_wf__, memory_t::host);
+    /* test functions depend only on the global index of G+k vector and are the same in all contexts */
+    for (int i = 0; i < num_wf__; i++) {
+        for (int igk_loc = 0; igk_loc < kp.num_gkvec_loc(); igk_loc++) {
+            int igk   = kp.idxgk(igk_loc);
+            double gk = kp.gkvec().gkvec_cart<index_domain_t::global>(igk).length();
+            phi.pw_coeffs(0).prime(igk_loc, i) = std::exp(-0.25 * gk * gk) *
+                                                 std::exp(double_complex(0, 0.37 * (i + 1) * igk));
+        }
+    }
+
+    H.prepare();
+    ctx.fft_coarse().prepare(kp.gkvec_partition());
+    H.local_op().prepare(kp.gkvec_partition());
+    kp.beta_projectors().prepare();
+
+    if (local_only__) {
+        H.local_op().apply_h(0, phi, hphi, 0, num_wf__);
+    } else {
+        H.apply_h_s<double_complex>(&kp, 0, 0, num_wf__, phi, &hphi, nullptr);
+    }
+
+    kp.beta_projectors().dismiss();
+    ctx.fft_coarse().dismiss();
+    H.dismiss();
+
+    mdarray<double_complex, 2> hphi_pw(kp.num_gkvec_loc(), num_wf__);
+    for (int i = 0; i < num_wf__; i++) {
+        std::copy(&hphi.pw_coeffs(0).prime(0, i), &hphi.pw_coeffs(0).prime(0, i) + kp.num_gkvec_loc(),
+                  &hphi_pw(0, i));
+    }
+    return std::move(hphi_pw);
+}
+
+/* non-local operator applied in real space against the <G+k|beta> projectors for a set of mask radii */
+int test_beta_real_space(std::string input__, vector3d<double> vk__, int num_wf__, std::vector<double> ratio__,
+                         double tol__)
+{
+    auto dict = utils::read_json_from_file_or_string(input__);
+    dict["parameters"]["gamma_point"] = false;
+    dict["control"]["beta_real_space"] = false;
+
+    auto h_ref = apply_h(dict, vk__, num_wf__, false);
+    auto h_loc = apply_h(dict, vk__, num_wf__, true);
+
+    /* norm of the non-local part */
+    double nrm{0};
+    for (size_t i = 0; i < h_ref.size(); i++) {
+        nrm += std::norm(h_ref[i] - h_loc[i]);
+    }
+    Communicator::world().allreduce(&nrm, 1);
+    nrm = std::sqrt(nrm);
+
+    if (Communicator::world().rank() == 0) {
+        printf("norm of the non-local part : %18.12e\n", nrm);
+        printf("  mask ratio   max. abs. error   rel. L2 error\n");
+    }
+
+    double err{0};
+    for (double r : ratio__) {
+        dict["control"]["beta_real_space"] = true;
+        dict["control"]["beta_mask_ratio"] = r;
+        auto h = apply_h(dict, vk__, num_wf__, false);
+
+        double dmax{0};
+        double d2{0};
+        for (size_t i = 0; i < h.size(); i++) {
+            dmax = std::max(dmax, std::abs(h[i] - h_ref[i]));
+            d2 += std::norm(h[i] - h_ref[i]);
+        }
+        Communicator::world().template allreduce<double, mpi_op_t::max>(&dmax, 1);
+        Communicator::world().allreduce(&d2, 1);
+        err = std::sqrt(d2) / nrm;
+        if (Communicator::world().rank() == 0) {
+            printf("  %10.4f  %16.8e  %14.6e\n", r, dmax, err);
+        }
+    }
+    /* the error at the largest mask radius must be small */
+    return (err < tol__) ? 0 : 1;
+}
+
+int main(int argn, char** argv)
+{
+    cmd_args args;
+    args.register_key("--input=", "{string} input file with the norm-conserving pseudopotential setup");
+    args.register_key("--vk=", "{double double double} lattice coordinates of the k-point");
+    args.register_key("--num_wf=", "{int} number of test functions");
+    args.register_key("--ratio=", "{vector double} ratios of the mask radius and the cutoff radius of projectors");
+    args.register_key("--tol=", "{double} tolerance of the relative error for the last ratio");
+
+    args.parse_args(argn, argv);
+    if (args.exist("help")) {
+        printf("Usage: %s [options]\n", argv[0]);
+        args.print_help();
+        return 0;
+    }
+    auto input  = args.value<std::string>("input", "sirius.json");
+    auto vk     = args.value<std::vector<double>>("vk", {0.1, 0.2, 0.3});
+    auto num_wf = args.value<int>("num_wf", 8);
+    auto ratio  = args.value<std::vector<double>>("ratio", {1.5, 2.0, 3.0, 4.0});
+    auto tol    = args.value<double>("tol", 1e-3);
+
+    sirius::initialize(1);
+    int err = test_beta_real_space(input, vector3d<double>(vk[0], vk[1], vk[2]), num_wf, ratio, tol);
+    if (Communicator::world().rank() == 0) {
+        if (err) {
+            printf("\x1b[31m" "Fail\n" "\x1b[0m" "\n");
+        } else {
+            printf("\x1b[32m" "OK\n" "\x1b[0m" "\n");
+        }
+    }
+    sirius::finalize();
+    return err;
+}
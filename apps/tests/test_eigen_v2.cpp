@@ -170,7 +170,13 @@ void call_test(std::vector<int> mpi_grid__,
                int repeat__,
                int type__)
 {
-    auto solver = Eigensolver_factory(get_ev_solver_t(name__));
+    /* "replicated" is not a stand-alone solver type; it is used for the small distributed subspace problems */
+    std::unique_ptr<Eigensolver> solver;
+    if (name__ == "replicated") {
+        solver = std::unique_ptr<Eigensolver>(new Eigensolver_replicated());
+    } else {
+        solver = Eigensolver_factory(get_ev_solver_t(name__));
+    }
     BLACS_grid blacs_grid(Communicator::world(), mpi_grid__[0], mpi_grid__[1]);
     if (fname__.length() == 0) {
         Measurement m;
@@ -201,7 +207,7 @@ int main(int argn, char** argv)
     args.register_key("--bs=", "{int} block size");
     args.register_key("--repeat=", "{int} number of repeats");
     args.register_key("--gen", "test generalized problem");
-    args.register_key("--name=", "{string} name of the solver");
+    args.register_key("--name=", "{string} name of the solver (or \"replicated\")");
     args.register_key("--file=", "{string} input file name");
     args.register_key("--type=", "{int} data type: 0-real, 1-complex");
 
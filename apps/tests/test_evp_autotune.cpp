@@ -0,0 +1,88 @@
+#include <sirius.h>
+
+using namespace sirius;
+
+/* test of the eigen-value solver autotuning; second call must be served from the cache and all groups of ranks
+ * must get the same result */
+void test_evp_autotune(int N__, int nev__, int bs__, bool real__, std::string cache__, int num_groups__)
+{
+    auto& comm = Communicator::world();
+    if (comm.size() % num_groups__) {
+        TERMINATE("number of ranks must be divisible by the number of groups");
+    }
+    /* groups of ranks which solve their own eigen-value problems, like the k-point groups */
+    auto comm_group = comm.split(comm.rank() / (comm.size() / num_groups__));
+
+    if (comm.rank() == 0 && utils::file_exists(cache__)) {
+        std::remove(cache__.c_str());
+    }
+    comm.barrier();
+
+    Evp_autotune evp_autotune(comm, comm_group, N__, nev__, bs__, real__, cache__);
+
+    double t0 = -omp_get_wtime();
+    auto r1 = evp_autotune.find();
+    t0 += omp_get_wtime();
+
+    double t1 = -omp_get_wtime();
+    auto r2 = evp_autotune.find();
+    t1 += omp_get_wtime();
+
+    bool ok = (r1.std_evp_solver_name == r2.std_evp_solver_name) &&
+              (r1.gen_evp_solver_name == r2.gen_evp_solver_name) &&
+              (r1.blacs_grid_dims == r2.blacs_grid_dims) &&
+              (r1.blacs_grid_dims[0] * r1.blacs_grid_dims[1] == comm_group.size() || r1.blacs_grid_dims[0] * r1.blacs_grid_dims[1] == 1);
+
+    /* compare with the result of the rank 0 */
+    std::stringstream s;
+    s << r1.std_evp_solver_name << " " << r1.gen_evp_solver_name << " " << r1.blacs_grid_dims[0] << " "
+      << r1.blacs_grid_dims[1];
+    std::string str = s.str();
+    comm.bcast(str, 0);
+    int err = (ok && str == s.str()) ? 0 : 1;
+    comm.allreduce<int, mpi_op_t::max>(&err, 1);
+
+    if (comm.rank() == 0) {
+        printf("standard eigen-value solver    : %s\n", r1.std_evp_solver_name.c_str());
+        printf("generalized eigen-value solver : %s\n", r1.gen_evp_solver_name.c_str());
+        printf("BLACS grid                     : %i x %i\n", r1.blacs_grid_dims[0], r1.blacs_grid_dims[1]);
+        printf("autotuning time                : %12.6f sec.\n", t0);
+        printf("cache lookup time              : %12.6f sec.\n", t1);
+        if (err) {
+            printf("\x1b[31m" "Fail\n" "\x1b[0m" "\n");
+        } else {
+            printf("\x1b[32m" "OK\n" "\x1b[0m" "\n");
+        }
+    }
+}
+
+int main(int argn, char** argv)
+{
+    cmd_args args;
+    args.register_key("--N=", "{int} matrix size");
+    args.register_key("--nev=", "{int} number of eigen-vectors");
+    args.register_key("--bs=", "{int} block size (negative for default)");
+    args.register_key("--real", "use real matrices");
+    args.register_key("--cache=", "{string} name of the cache file");
+    args.register_key("--num_groups=", "{int} number of groups of ranks");
+
+    args.parse_args(argn, argv);
+    if (args.exist("help")) {
+        printf("Usage: %s [options]\n", argv[0]);
+        args.print_help();
+        return 0;
+    }
+    auto N     = args.value<int>("N", 400);
+    auto nev   = args.value<int>("nev", 100);
+    auto bs    = args.value<int>("bs", -1);
+    auto cache = args.value<std::string>("cache", "test_evp_autotune.json");
+    auto num_groups = args.value<int>("num_groups", 1);
+
+    sirius::initialize(1);
+    test_evp_autotune(N, nev, bs, args.exist("real"), cache, num_groups);
+    Communicator::world().barrier();
+    if (Communicator::world().rank() == 0) {
+        utils::timer::print();
+    }
+    sirius::finalize();
+}
@@ -2,19 +2,70 @@
 
 using namespace sirius;
 
+/* compare the shared Gaunt tables built with the tabulated 3j-symbols against the direct evaluation */
+template <typename T>
+int test_gaunt(int lmax__, gaunt_t type__, std::function<T(int, int, int, int, int, int)> get__)
+{
+    utils::timer t1("direct");
+    Gaunt_coefficients<T> ref(lmax__, 2 * lmax__, lmax__, get__);
+    double t_ref = t1.stop();
+
+    utils::timer t2("shared");
+    auto gc = Gaunt_coefficients<T>::get(lmax__, 2 * lmax__, lmax__, type__);
+    double t_new = t2.stop();
+
+    /* second request must return the same table */
+    if (Gaunt_coefficients<T>::get(lmax__, 2 * lmax__, lmax__, type__) != gc) {
+        printf("table is not shared\n");
+        return 1;
+    }
+
+    int lmmax = utils::lmmax(lmax__);
+    int lmmax3 = utils::lmmax(2 * lmax__);
+    double diff{0};
+    for (int lm1 = 0; lm1 < lmmax; lm1++) {
+        for (int lm2 = 0; lm2 < lmmax; lm2++) {
+            std::vector<T> v1(lmmax3, 0);
+            std::vector<T> v2(lmmax3, 0);
+            for (int i = 0; i < ref.num_gaunt(lm1, lm2); i++) {
+                v1[ref.gaunt(lm1, lm2, i).lm3] = ref.gaunt(lm1, lm2, i).coef;
+            }
+            for (int i = 0; i < gc->num_gaunt(lm1, lm2); i++) {
+                v2[gc->gaunt(lm1, lm2, i).lm3] = gc->gaunt(lm1, lm2, i).coef;
+            }
+            for (int lm3 = 0; lm3 < lmmax3; lm3++) {
+                diff = std::max(diff, std::abs(v1[lm3] - v2[lm3]));
+            }
+        }
+    }
+    printf("lmax: %2i, direct: %12.6f sec., shared: %12.6f sec., maximum difference: %18.12e\n", lmax__, t_ref,
+           t_new, diff);
+    return (diff < 1e-12) ? 0 : 1;
+}
+
 int main(int argn, char** argv)
 {
     cmd_args args;
+    args.register_key("--lmax=", "{int} maximum orbital quantum number");
 
     args.parse_args(argn, argv);
-    if (args.exist("help"))
-    {
+    if (args.exist("help")) {
         printf("Usage: %s [options]\n", argv[0]);
         args.print_help();
         return 0;
     }
+    auto lmax = args.value<int>("lmax", 6);
 
     sirius::initialize(1);
-    printf("%f\n", SHT::gaunt_rlm(2, 2, 2, 0, 0, 0));
+    int err{0};
+    err += test_gaunt<double>(lmax, gaunt_t::rlm, SHT::gaunt_rlm);
+    err += test_gaunt<double>(lmax, gaunt_t::ylm, SHT::gaunt_ylm);
+    err += test_gaunt<double_complex>(lmax, gaunt_t::hybrid, SHT::gaunt_hybrid);
+    if (err) {
+        printf("\x1b[31m" "Fail\n" "\x1b[0m" "\n");
+    } else {
+        printf("\x1b[32m" "OK\n" "\x1b[0m" "\n");
+    }
     sirius::finalize();
+    return err;
 }
@@ -0,0 +1,168 @@
+#include <sirius.h>
+
+using namespace sirius;
+
+/* check the results of the non-blocking and persistent collectives against the blocking ones */
+int test_icoll(int n__, int repeat__)
+{
+    auto& comm = Communicator::world();
+    int nr = comm.size();
+    int rank = comm.rank();
+
+    int nerr{0};
+    auto check = [&](std::string label__, double diff__)
+    {
+        comm.allreduce<double, mpi_op_t::max>(&diff__, 1);
+        if (diff__ > 1e-12) {
+            nerr++;
+        }
+        if (rank == 0) {
+            printf("%-20s : %s\n", label__.c_str(), (diff__ > 1e-12) ? "Fail" : "OK");
+        }
+    };
+
+    /* allreduce */
+    std::vector<double_complex> a(n__), b(n__);
+    for (int i = 0; i < n__; i++) {
+        a[i] = double_complex(rank + i, rank - i);
+    }
+    b = a;
+    comm.allreduce(a.data(), n__);
+    auto req = comm.iallreduce(b.data(), n__);
+    req.wait();
+    double d{0};
+    for (int i = 0; i < n__; i++) {
+        d = std::max(d, std::abs(a[i] - b[i]));
+    }
+    check("iallreduce", d);
+
+    /* persistent allreduce started several times on the same buffer */
+    {
+        auto preq = comm.allreduce_init(b.data(), n__);
+        double d{0};
+        for (int r = 0; r < repeat__; r++) {
+            for (int i = 0; i < n__; i++) {
+                b[i] = double_complex(rank + i + r, rank - i);
+            }
+            preq.start();
+            preq.wait();
+            for (int i = 0; i < n__; i++) {
+                double_complex ref(nr * (i + r) + nr * (nr - 1) / 2.0, nr * (nr - 1) / 2.0 - nr * i);
+                d = std::max(d, std::abs(b[i] - ref));
+            }
+        }
+        check("allreduce_init", d);
+    }
+
+    /* broadcast */
+    {
+        std::vector<int> v(n__, rank);
+        auto req = comm.ibcast(v.data(), n__, nr - 1);
+        req.wait();
+        double d{0};
+        for (int i = 0; i < n__; i++) {
+            d = std::max(d, std::abs(double(v[i] - (nr - 1))));
+        }
+        check("ibcast", d);
+
+        auto preq = comm.bcast_init(v.data(), n__, 0);
+        d = 0;
+        for (int r = 0; r < repeat__; r++) {
+            std::fill(v.begin(), v.end(), (rank == 0) ? r : -1);
+            preq.start();
+            preq.wait();
+            for (int i = 0; i < n__; i++) {
+                d = std::max(d, std::abs(double(v[i] - r)));
+            }
+        }
+        check("bcast_init", d);
+    }
+
+    /* allgather */
+    {
+        splindex<block> spl(n__, nr, rank);
+        std::vector<int> counts(nr), offsets(nr);
+        for (int r = 0; r < nr; r++) {
+            counts[r]  = spl.local_size(r);
+            offsets[r] = spl.global_offset(r);
+        }
+        std::vector<double> v(n__, -1);
+        for (int i = 0; i < spl.local_size(); i++) {
+            v[spl[i]] = spl[i];
+        }
+        auto req = comm.iallgather(v.data(), counts.data(), offsets.data());
+        req.wait();
+        double d{0};
+        for (int i = 0; i < n__; i++) {
+            d = std::max(d, std::abs(v[i] - i));
+        }
+        check("iallgather", d);
+
+        auto preq = comm.allgather_init(v.data(), counts.data(), offsets.data());
+        d = 0;
+        for (int r = 0; r < repeat__; r++) {
+            std::fill(v.begin(), v.end(), -1);
+            for (int i = 0; i < spl.local_size(); i++) {
+                v[spl[i]] = spl[i] + r;
+            }
+            preq.start();
+            preq.wait();
+            for (int i = 0; i < n__; i++) {
+                d = std::max(d, std::abs(v[i] - i - r));
+            }
+        }
+        check("allgather_init", d);
+    }
+
+    /* all-to-all: each rank sends its rank number to all ranks */
+    {
+        std::vector<int> counts(nr, 1), offsets(nr);
+        for (int r = 0; r < nr; r++) {
+            offsets[r] = r;
+        }
+        std::vector<int> s(nr, rank), v(nr, -1);
+        auto req = comm.ialltoall(s.data(), counts.data(), offsets.data(), v.data(), counts.data(), offsets.data());
+        req.wait();
+        double d{0};
+        for (int r = 0; r < nr; r++) {
+            d = std::max(d, std::abs(double(v[r] - r)));
+        }
+        check("ialltoall", d);
+
+        auto preq = comm.alltoall_init(s.data(), counts.data(), offsets.data(), v.data(), counts.data(),
+                                       offsets.data());
+        d = 0;
+        for (int k = 0; k < repeat__; k++) {
+            std::fill(s.begin(), s.end(), rank + k);
+            preq.start();
+            preq.wait();
+            for (int r = 0; r < nr; r++) {
+                d = std::max(d, std::abs(double(v[r] - r - k)));
+            }
+        }
+        check("alltoall_init", d);
+    }
+
+    return nerr;
+}
+
+int main(int argn, char** argv)
+{
+    cmd_args args;
+    args.register_key("--n=", "{int} size of the buffers");
+    args.register_key("--repeat=", "{int} number of starts of the persistent requests");
+
+    args.parse_args(argn, argv);
+    if (args.exist("help")) {
+        printf("Usage: %s [options]\n", argv[0]);
+        args.print_help();
+        return 0;
+    }
+    auto n      = args.value<int>("n", 1000);
+    auto repeat = args.value<int>("repeat", 5);
+
+    sirius::initialize(1);
+    int nerr = test_icoll(n, repeat);
+    sirius::finalize();
+    return (nerr == 0) ? 0 : 1;
+}
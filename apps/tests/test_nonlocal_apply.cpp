@@ -0,0 +1,128 @@
+#include <sirius.h>
+
+using namespace sirius;
+
+/* micro-benchmark for the application of the block-diagonal D or Q operator to <beta|phi> */
+template <typename T>
+void test_nonlocal_apply(int nbf__, int num_atoms__, int num_bands__, int repeat__)
+{
+    int nbeta = nbf__ * num_atoms__;
+
+    /* operator matrices of atoms */
+    mdarray<T, 2> op(nbf__ * nbf__, num_atoms__);
+    for (int ia = 0; ia < num_atoms__; ia++) {
+        for (int k = 0; k < nbf__ * nbf__; k++) {
+            op(k, ia) = utils::random<T>();
+        }
+    }
+    /* <beta|phi> */
+    matrix<T> beta_phi(nbeta, num_bands__);
+    for (int j = 0; j < num_bands__; j++) {
+        for (int i = 0; i < nbeta; i++) {
+            beta_phi(i, j) = utils::random<T>();
+        }
+    }
+
+    std::vector<int> offs(num_atoms__);
+    std::vector<T const*> a(num_atoms__);
+    std::vector<T const*> a0(num_atoms__);
+    for (int ia = 0; ia < num_atoms__; ia++) {
+        offs[ia] = ia * nbf__;
+        a[ia]    = op.at(memory_t::host, 0, ia);
+        a0[ia]   = op.at(memory_t::host, 0, 0);
+    }
+
+    matrix<T> work_ref(nbeta, num_bands__);
+    matrix<T> work(nbeta, num_bands__);
+
+    /* reference: one GEMM per atom */
+    double t0 = -omp_get_wtime();
+    for (int r = 0; r < repeat__; r++) {
+        #pragma omp parallel for
+        for (int ia = 0; ia < num_atoms__; ia++) {
+            linalg2(linalg_t::blas).gemm('N', 'N', nbf__, num_bands__, nbf__, &linalg_const<T>::one(),
+                                         a[ia], nbf__, beta_phi.at(memory_t::host, offs[ia], 0), nbeta,
+                                         &linalg_const<T>::zero(), work_ref.at(memory_t::host, offs[ia], 0), nbeta);
+        }
+    }
+    t0 += omp_get_wtime();
+
+    double t1 = -omp_get_wtime();
+    for (int r = 0; r < repeat__; r++) {
+        block_diag_gemm<T>(nbf__, num_bands__, a, offs, beta_phi.at(memory_t::host), nbeta,
+                           work.at(memory_t::host), nbeta);
+    }
+    t1 += omp_get_wtime();
+
+    double diff1{0};
+    for (int j = 0; j < num_bands__; j++) {
+        for (int i = 0; i < nbeta; i++) {
+            diff1 = std::max(diff1, std::abs(work(i, j) - work_ref(i, j)));
+        }
+    }
+
+    /* the same matrix for all atoms (Q-operator case) */
+    double t2 = -omp_get_wtime();
+    for (int r = 0; r < repeat__; r++) {
+        #pragma omp parallel for
+        for (int ia = 0; ia < num_atoms__; ia++) {
+            linalg2(linalg_t::blas).gemm('N', 'N', nbf__, num_bands__, nbf__, &linalg_const<T>::one(),
+                                         a0[ia], nbf__, beta_phi.at(memory_t::host, offs[ia], 0), nbeta,
+                                         &linalg_const<T>::zero(), work_ref.at(memory_t::host, offs[ia], 0), nbeta);
+        }
+    }
+    t2 += omp_get_wtime();
+
+    double t3 = -omp_get_wtime();
+    for (int r = 0; r < repeat__; r++) {
+        shared_block_gemm<T>(nbf__, num_bands__, a0[0], offs, beta_phi.at(memory_t::host), nbeta,
+                             work.at(memory_t::host), nbeta);
+    }
+    t3 += omp_get_wtime();
+
+    double diff2{0};
+    for (int j = 0; j < num_bands__; j++) {
+        for (int i = 0; i < nbeta; i++) {
+            diff2 = std::max(diff2, std::abs(work(i, j) - work_ref(i, j)));
+        }
+    }
+
+    printf("number of projectors per atom : %i\n", nbf__);
+    printf("number of atoms               : %i\n", num_atoms__);
+    printf("number of bands               : %i\n", num_bands__);
+    printf("atom-specific matrices\n");
+    printf("  per-atom GEMM   : %12.6f sec.\n", t0);
+    printf("  block-diagonal  : %12.6f sec., speedup : %8.4f, difference : %18.12e\n", t1, t0 / t1, diff1);
+    printf("shared matrix\n");
+    printf("  per-atom GEMM   : %12.6f sec.\n", t2);
+    printf("  packed GEMM     : %12.6f sec., speedup : %8.4f, difference : %18.12e\n", t3, t2 / t3, diff2);
+}
+
+int main(int argn, char** argv)
+{
+    cmd_args args;
+    args.register_key("--nbf=", "{int} number of beta-projectors per atom");
+    args.register_key("--num_atoms=", "{int} number of atoms");
+    args.register_key("--num_bands=", "{int} number of bands");
+    args.register_key("--repeat=", "{int} number of repetitions");
+    args.register_key("--real", "use real arithmetic (Gamma-point case)");
+
+    args.parse_args(argn, argv);
+    if (args.exist("help")) {
+        printf("Usage: %s [options]\n", argv[0]);
+        args.print_help();
+        return 0;
+    }
+    auto nbf       = args.value<int>("nbf", 13);
+    auto num_atoms = args.value<int>("num_atoms", 256);
+    auto num_bands = args.value<int>("num_bands", 200);
+    auto repeat    = args.value<int>("repeat", 10);
+
+    sirius::initialize(1);
+    if (args.exist("real")) {
+        test_nonlocal_apply<double>(nbf, num_atoms, num_bands, repeat);
+    } else {
+        test_nonlocal_apply<double_complex>(nbf, num_atoms, num_bands, repeat);
+    }
+    sirius::finalize();
+}
@@ -0,0 +1,97 @@
+#include <sirius.h>
+
+using namespace sirius;
+
+/* Hartree energy of a Gaussian charge in a small box: the free-boundary solver must reproduce the analytic
+ * value Q^2 / (2 sigma sqrt(pi)), while the spherical cutoff in the original cell is not enough */
+void test_poisson_free_boundary(double a__, double sigma__, double cutoff__)
+{
+    matrix3d<double> M = {{a__, 0, 0}, {0, a__, 0}, {0, 0, a__}};
+
+    Simulation_context ctx;
+    ctx.unit_cell().set_lattice_vectors(M);
+    ctx.set_pw_cutoff(cutoff__);
+    ctx.set_gk_cutoff(cutoff__ / 2);
+    ctx.electronic_structure_method("pseudopotential");
+    ctx.use_symmetry(false);
+    ctx.initialize();
+
+    double Q = 1.0;
+    /* put the charge close to the corner of the cell */
+    vector3d<double> r0(0.1 * a__, 0.15 * a__, 0.2 * a__);
+
+    Smooth_periodic_function<double> rho(ctx.fft(), ctx.gvec_partition());
+    Smooth_periodic_function<double> vh(ctx.fft(), ctx.gvec_partition());
+
+    for (int igloc = 0; igloc < ctx.gvec().count(); igloc++) {
+        auto gc = ctx.gvec().gvec_cart<index_domain_t::local>(igloc);
+        rho.f_pw_local(igloc) = (Q / ctx.unit_cell().omega()) * std::exp(-0.5 * std::pow(gc.length() * sigma__, 2)) *
+                                std::exp(double_complex(0, -dot(gc, r0)));
+    }
+    rho.fft_transform(1);
+
+    auto energy = [&]()
+    {
+        vh.fft_transform(1);
+        double e{0};
+        for (int ir = 0; ir < ctx.fft().local_size(); ir++) {
+            e += rho.f_rg(ir) * vh.f_rg(ir);
+        }
+        ctx.fft().comm().allreduce(&e, 1);
+        return 0.5 * e * ctx.unit_cell().omega() / ctx.fft().size();
+    };
+
+    /* free-boundary solver */
+    Free_boundary_poisson fbp(ctx);
+    fbp.solve(&rho.f_pw_local(0), &vh.f_pw_local(0));
+    double e1 = energy();
+
+    /* spherical cutoff in the original cell */
+    double R_cut = 0.5 * std::pow(ctx.unit_cell().omega(), 1.0 / 3);
+    for (int igloc = 0; igloc < ctx.gvec().count(); igloc++) {
+        int ig = ctx.gvec().offset() + igloc;
+        double g = ctx.gvec().gvec_len(ig);
+        if (g < 1e-12) {
+            vh.f_pw_local(igloc) = twopi * R_cut * R_cut * rho.f_pw_local(igloc);
+        } else {
+            vh.f_pw_local(igloc) = fourpi * rho.f_pw_local(igloc) * (1.0 - std::cos(g * R_cut)) / std::pow(g, 2);
+        }
+    }
+    double e2 = energy();
+
+    double e0 = Q * Q / 2 / sigma__ / std::sqrt(pi);
+
+    if (Communicator::world().rank() == 0) {
+        printf("FFT grid size      : %i %i %i\n", ctx.fft().size(0), ctx.fft().size(1), ctx.fft().size(2));
+        printf("analytic energy    : %18.12f\n", e0);
+        printf("free boundary      : %18.12f, difference : %18.12e\n", e1, std::abs(e1 - e0));
+        printf("spherical cutoff   : %18.12f, difference : %18.12e\n", e2, std::abs(e2 - e0));
+        if (std::abs(e1 - e0) > 1e-6) {
+            printf("\x1b[31m" "Fail\n" "\x1b[0m" "\n");
+        } else {
+            printf("\x1b[32m" "OK\n" "\x1b[0m" "\n");
+        }
+    }
+}
+
+int main(int argn, char** argv)
+{
+    cmd_args args;
+    args.register_key("--a=", "{double} size of the cubic cell");
+    args.register_key("--sigma=", "{double} width of the Gaussian charge");
+    args.register_key("--cutoff=", "{double} plane-wave cutoff");
+
+    args.parse_args(argn, argv);
+    if (args.exist("help")) {
+        printf("Usage: %s [options]\n", argv[0]);
+        args.print_help();
+        return 0;
+    }
+    auto a      = args.value<double>("a", 10.0);
+    auto sigma  = args.value<double>("sigma", 0.6);
+    auto cutoff = args.value<double>("cutoff", 15.0);
+
+    sirius::initialize(1);
+    test_poisson_free_boundary(a, sigma, cutoff);
+    sirius::finalize();
+}
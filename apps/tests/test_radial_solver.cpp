@@ -29,6 +29,41 @@ void test_radial_solver()
     fclose(fout);
 }
 
+/* Bound state of the bare Coulomb potential on a grid where the scalar-relativistic search can't converge:
+   the search must terminate in bounded time, while the non-relativistic solution is still found */
+int test_bound_state_fail()
+{
+    auto rgrid = Radial_grid_factory<double>(radial_grid_t::lin_exp, 20000, 1e-7, 200.0, 1.0);
+
+    int err{0};
+    for (int zn : {1, 31}) {
+        std::vector<double> v(rgrid.num_points());
+        for (int ir = 0; ir < rgrid.num_points(); ir++) {
+            v[ir] = -zn * rgrid.x_inv(ir);
+        }
+        double enu = -0.5 * std::pow(zn / 2.0, 2);
+
+        Bound_state b0(relativity_t::none, zn, 2, 1, 0, rgrid, v, enu);
+        if (std::abs(b0.enu() / enu - 1) > 1e-3) {
+            printf("wrong bound state energy for zn = %i: %18.12f, expected: %18.12f\n", zn, b0.enu(), enu);
+            err++;
+        }
+
+        for (auto rel : {relativity_t::koelling_harmon, relativity_t::zora}) {
+            try {
+                Bound_state b(rel, zn, 2, 1, 0, rgrid, v, enu);
+                if (std::abs(b.enu() / enu - 1) > 1e-2) {
+                    printf("wrong bound state energy for zn = %i: %18.12f\n", zn, b.enu());
+                    err++;
+                }
+            } catch (std::runtime_error const&) {
+                /* failed search is reported by an exception */
+            }
+        }
+    }
+    return err;
+}
+
 int main(int argn, char** argv)
 {
     cmd_args args;
@@ -43,5 +78,13 @@ int main(int argn, char** argv)
 
     sirius::initialize(1);
     test_radial_solver();
+    int err = test_bound_state_fail();
+    if (err) {
+        printf("\x1b[31m" "Fail\n" "\x1b[0m" "\n");
+    } else {
+        printf("\x1b[32m" "OK\n" "\x1b[0m" "\n");
+    }
     sirius::finalize();
+
+    return err;
 }
@@ -0,0 +1,105 @@
+#include <sirius.h>
+
+using namespace sirius;
+
+/* batched spherical harmonic transforms against the transformation of one function at a time */
+template <typename T>
+void test_sht_batch(int lmax__, int nr__, int nf__, int nrb__, int repeat__)
+{
+    SHT sht(lmax__);
+    int lmmax = utils::lmmax(lmax__);
+    int np    = sht.num_points();
+
+    /* functions stored one after another */
+    mdarray<T, 3> flm(lmmax, nr__, nf__);
+    mdarray<T, 3> ftp(np, nr__, nf__);
+    mdarray<T, 3> ftp_ref(np, nr__, nf__);
+    mdarray<T, 3> flm_ref(lmmax, nr__, nf__);
+    mdarray<T, 3> flm1(lmmax, nr__, nf__);
+    for (int i = 0; i < nf__; i++) {
+        for (int ir = 0; ir < nr__; ir++) {
+            for (int lm = 0; lm < lmmax; lm++) {
+                flm(lm, ir, i) = utils::random<T>();
+            }
+        }
+    }
+
+    double t0 = -omp_get_wtime();
+    for (int k = 0; k < repeat__; k++) {
+        for (int i = 0; i < nf__; i++) {
+            sht.backward_transform(lmmax, &flm(0, 0, i), nr__, lmmax, &ftp_ref(0, 0, i));
+            sht.forward_transform(&ftp_ref(0, 0, i), nr__, lmmax, lmmax, &flm_ref(0, 0, i));
+        }
+    }
+    t0 += omp_get_wtime();
+
+    std::vector<T const*> in1, in2;
+    std::vector<T*> out1, out2;
+    /* reversed order of functions makes the batch non-contiguous */
+    for (int i = 0; i < nf__; i++) {
+        in1.push_back(&flm(0, 0, i));
+        out1.push_back(&ftp(0, 0, i));
+        in2.push_back(&ftp(0, 0, nf__ - 1 - i));
+        out2.push_back(&flm1(0, 0, nf__ - 1 - i));
+    }
+
+    double t1 = -omp_get_wtime();
+    for (int k = 0; k < repeat__; k++) {
+        sht.backward_transform(lmmax, in1, nr__, lmmax, out1, nrb__);
+        sht.forward_transform(in2, nr__, lmmax, lmmax, out2, nrb__);
+    }
+    t1 += omp_get_wtime();
+
+    double diff{0};
+    for (int i = 0; i < nf__; i++) {
+        for (int ir = 0; ir < nr__; ir++) {
+            for (int itp = 0; itp < np; itp++) {
+                diff = std::max(diff, std::abs(ftp(itp, ir, i) - ftp_ref(itp, ir, i)));
+            }
+            for (int lm = 0; lm < lmmax; lm++) {
+                diff = std::max(diff, std::abs(flm1(lm, ir, i) - flm_ref(lm, ir, i)));
+            }
+        }
+    }
+    printf("lmax: %i, number of points: %i, number of radial points: %i, number of functions: %i, block size: %i\n",
+           lmax__, np, nr__, nf__, nrb__);
+    printf("one function at a time : %12.6f sec.\n", t0);
+    printf("batched                : %12.6f sec., speedup : %8.4f\n", t1, t0 / t1);
+    printf("maximum difference: %18.12e\n", diff);
+    if (diff > 1e-12) {
+        printf("\x1b[31m" "Fail\n" "\x1b[0m" "\n");
+    } else {
+        printf("\x1b[32m" "OK\n" "\x1b[0m" "\n");
+    }
+}
+
+int main(int argn, char** argv)
+{
+    cmd_args args;
+    args.register_key("--lmax=", "{int} maximum orbital quantum number");
+    args.register_key("--nr=", "{int} number of radial points");
+    args.register_key("--nf=", "{int} number of functions");
+    args.register_key("--nrb=", "{int} block size of radial points (0: no blocking)");
+    args.register_key("--repeat=", "{int} number of repetitions");
+    args.register_key("--complex", "use complex spherical harmonics");
+
+    args.parse_args(argn, argv);
+    if (args.exist("help")) {
+        printf("Usage: %s [options]\n", argv[0]);
+        args.print_help();
+        return 0;
+    }
+    auto lmax   = args.value<int>("lmax", 8);
+    auto nr     = args.value<int>("nr", 1000);
+    auto nf     = args.value<int>("nf", 4);
+    auto nrb    = args.value<int>("nrb", 0);
+    auto repeat = args.value<int>("repeat", 10);
+
+    sirius::initialize(1);
+    if (args.exist("complex")) {
+        test_sht_batch<double_complex>(lmax, nr, nf, nrb, repeat);
+    } else {
+        test_sht_batch<double>(lmax, nr, nf, nrb, repeat);
+    }
+    sirius::finalize();
+}
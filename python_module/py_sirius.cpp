@@ -192,6 +192,7 @@ PYBIND11_MODULE(py_sirius, m)
         .def("set_gamma_point", &Simulation_context::set_gamma_point)
         .def("set_pw_cutoff", &Simulation_context::set_pw_cutoff)
         .def("update", &Simulation_context::update)
+        .def("rebind", &Simulation_context::rebind)
         .def("use_symmetry", py::overload_cast<>(&Simulation_context::use_symmetry, py::const_))
         .def("preferred_memory_t", &Simulation_context::preferred_memory_t)
         .def("comm", [](Simulation_context& obj) { return make_pycomm(obj.comm()); },
@@ -373,7 +374,8 @@ PYBIND11_MODULE(py_sirius, m)
         .def("potential", &DFT_ground_state::potential, py::return_value_policy::reference_internal)
         .def("forces", &DFT_ground_state::forces, py::return_value_policy::reference_internal)
         .def("stress", &DFT_ground_state::stress, py::return_value_policy::reference_internal)
-        .def("update", &DFT_ground_state::update);
+        .def("update", &DFT_ground_state::update)
+        .def("extrapolation_order", &DFT_ground_state::extrapolation_order);
 
     py::class_<K_point>(m, "K_point")
         .def("band_energy", py::overload_cast<int, int>(&K_point::band_energy, py::const_))
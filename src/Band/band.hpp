@@ -83,6 +83,15 @@ class Band // TODO: Band class is lightweight and in principle can be converted
     inline void
     diag_pseudo_potential_chebyshev(K_point* kp__, int ispn__, Hamiltonian& H__, P_operator<T>& p_op__) const;
 
+    /// Apply a few steps of the Chebyshev filter to the trial wave-functions.
+    /** The filter suppresses the part of the spectrum between the largest Rayleigh quotient of the trial functions
+     *  and the upper bound of the Hamiltonian estimated by a few Lanczos steps. Filtered functions are
+     *  orthonormalized and returned in phi. */
+    template <typename T>
+    inline void chebyshev_filter(K_point* kp__, Hamiltonian& H__, int ispn__, int n__, int order__,
+                                 Wave_functions& phi__, Wave_functions& hphi__, Wave_functions& wf1__,
+                                 Wave_functions& wf2__, dmatrix<T>& o__) const;
+
     /// Auxiliary function used internally by residuals() function.
     inline mdarray<double, 1> residuals_aux(K_point* kp__,
                                             int ispn__,
@@ -296,7 +296,8 @@ inline void Band::get_singular_components(K_point& kp__, Hamiltonian& H__) const
             }
         }
 
-        orthogonalize(ctx_.preferred_memory_t(), ctx_.blas_linalg_t(), 0, phi, ophi, N, n, ovlp, res);
+        orthogonalize(ctx_.preferred_memory_t(), ctx_.blas_linalg_t(), 0, phi, ophi, N, n, ovlp, res,
+                      get_ortho_method_t(itso.orthogonalization_));
 
         /* setup eigen-value problem
          * N is the number of previous basis functions
@@ -549,7 +550,8 @@ inline void Band::diag_full_potential_first_variation_davidson(K_point& kp__, Ha
             H__.apply_fv_h_o(&kp__, false, false, N, n, phi, &hphi, &ophi);
         }
 
-        orthogonalize(ctx_.preferred_memory_t(), ctx_.blas_linalg_t(), 0, phi, hphi, ophi, N, n, ovlp, res);
+        orthogonalize(ctx_.preferred_memory_t(), ctx_.blas_linalg_t(), 0, phi, hphi, ophi, N, n, ovlp, res,
+                      get_ortho_method_t(itso.orthogonalization_));
 
         /* setup eigen-value problem
          * N is the number of previous basis functions
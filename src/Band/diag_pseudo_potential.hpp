@@ -346,9 +346,6 @@ inline int Band::diag_pseudo_potential_davidson(K_point*       kp__,
         }
     }
 
-    auto& std_solver = ctx_.std_evp_solver();
-    auto& gen_solver = ctx_.gen_evp_solver();
-
     if (ctx_.control().print_checksum_) {
         for (int ispn = 0; ispn < ctx_.num_spins(); ispn++) {
             auto cs = psi.checksum_pw(get_device_t(psi.preferred_memory_t()), ispn, 0, num_bands);
@@ -429,7 +426,7 @@ inline int Band::diag_pseudo_potential_davidson(K_point*       kp__,
 
         utils::timer t1("sirius::Band::diag_pseudo_potential_davidson|evp");
         /* solve generalized eigen-value problem with the size N and get lowest num_bands eigen-vectors */
-        if (gen_solver.solve(N, num_bands, hmlt, ovlp, eval.data(), evec)) {
+        if (ctx_.gen_evp_solver(N).solve(N, num_bands, hmlt, ovlp, eval.data(), evec)) {
             std::stringstream s;
             s << "error in diagonalziation";
             TERMINATE(s);
@@ -521,7 +518,8 @@ inline int Band::diag_pseudo_potential_davidson(K_point*       kp__,
             H__.apply_h_s<T>(kp__, nc_mag ? 2 : ispin_step, N, n, phi, &hphi, &sphi);
 
             if (itso.orthogonalize_) {
-                orthogonalize<T>(ctx_.preferred_memory_t(), ctx_.blas_linalg_t(), nc_mag ? 2 : 0, phi, hphi, sphi, N, n, ovlp, res);
+                orthogonalize<T>(ctx_.preferred_memory_t(), ctx_.blas_linalg_t(), nc_mag ? 2 : 0, phi, hphi, sphi, N, n, ovlp, res,
+                                 get_ortho_method_t(itso.orthogonalization_));
             }
 
             /* setup eigen-value problem
@@ -560,14 +558,14 @@ inline int Band::diag_pseudo_potential_davidson(K_point*       kp__,
             utils::timer t1("sirius::Band::diag_pseudo_potential_davidson|evp");
             if (itso.orthogonalize_) {
                 /* solve standard eigen-value problem with the size N */
-                if (std_solver.solve(N, num_bands, hmlt, eval.data(), evec)) {
+                if (ctx_.std_evp_solver(N).solve(N, num_bands, hmlt, eval.data(), evec)) {
                     std::stringstream s;
                     s << "error in diagonalziation";
                     TERMINATE(s);
                 }
             } else {
                 /* solve generalized eigen-value problem with the size N */
-                if (gen_solver.solve(N, num_bands, hmlt, ovlp, eval.data(), evec)) {
+                if (ctx_.gen_evp_solver(N).solve(N, num_bands, hmlt, ovlp, eval.data(), evec)) {
                     std::stringstream s;
                     s << "error in diagonalziation";
                     TERMINATE(s);
@@ -202,9 +202,37 @@ inline void Band::initialize_subspace(K_point* kp__, Hamiltonian& H__, int num_a
         }
     }
 
+    bool chebyshev = (ctx_.iterative_solver_input().init_subspace_ == "chebyshev");
+
+    /* the filter overwrites phi; keep the initial functions for the second spin channel */
+    std::unique_ptr<Wave_functions> phi0;
+    if (chebyshev && ctx_.num_spin_dims() == 2) {
+        phi0 = std::unique_ptr<Wave_functions>(
+            new Wave_functions(mp, kp__->gkvec_partition(), num_phi_tot, ctx_.host_memory_t(), num_sc));
+        phi0->copy_from(device_t::CPU, num_phi_tot, phi, 0, 0, 0, 0);
+    }
+
     for (int ispn_step = 0; ispn_step < ctx_.num_spin_dims(); ispn_step++) {
-        /* apply Hamiltonian and overlap operators to the new basis functions */
-        H__.apply_h_s<T>(kp__, (ctx_.num_mag_dims() == 3) ? 2 : ispn_step, 0, num_phi_tot, phi, &hphi, &ophi);
+        int ispn = (ctx_.num_mag_dims() == 3) ? 2 : ispn_step;
+
+        if (chebyshev) {
+            if (ispn_step > 0) {
+                phi.copy_from(device_t::CPU, num_phi_tot, *phi0, 0, 0, 0, 0);
+                if (is_device_memory(ctx_.preferred_memory_t())) {
+                    phi.pw_coeffs(0).copy_to(memory_t::device, 0, num_phi_tot);
+                }
+            }
+            chebyshev_filter<T>(kp__, H__, ispn, num_phi_tot, ctx_.iterative_solver_input().init_chebyshev_order_,
+                                phi, hphi, ophi, wf_tmp, ovlp);
+        }
+
+        /* apply Hamiltonian and overlap operators to the new basis functions in blocks of num_bands functions;
+           this limits the size of the intermediate arrays of apply_h_s() (such as <beta|phi>) when the number of
+           atomic orbitals is large; hphi and ophi still hold the full basis */
+        for (int i0 = 0; i0 < num_phi_tot; i0 += num_bands) {
+            int nb = std::min(num_bands, num_phi_tot - i0);
+            H__.apply_h_s<T>(kp__, ispn, i0, nb, phi, &hphi, &ophi);
+        }
 
         /* do some checks */
         if (ctx_.control().verification_ >= 1) {
@@ -316,7 +344,192 @@ inline void Band::initialize_subspace(K_point* kp__, Hamiltonian& H__, int num_a
     }
 
     kp__->beta_projectors().dismiss();
+    kp__->dismiss_hubbard_wave_functions();
     ctx_.fft_coarse().dismiss();
 
     ctx_.print_memory_usage(__FILE__, __LINE__);
 }
+
+template <typename T>
+inline void Band::chebyshev_filter(K_point* kp__, Hamiltonian& H__, int ispn__, int n__, int order__,
+                                   Wave_functions& phi__, Wave_functions& hphi__, Wave_functions& wf1__,
+                                   Wave_functions& wf2__, dmatrix<T>& o__) const
+{
+    PROFILE("sirius::Band::chebyshev_filter");
+
+    const int ngk  = kp__->num_gkvec_loc();
+    const int nsc  = phi__.num_sc();
+    const bool dev = is_device_memory(ctx_.preferred_memory_t());
+    /* in the Gamma-point case only half of the G-vectors are stored */
+    const bool reduced = kp__->gkvec().reduced();
+    /* number of Lanczos steps for the estimation of the upper bound of the spectrum */
+    const int num_lanczos{10};
+
+    /* filter arithmetic is done on the host */
+    auto copy_wf = [&](Wave_functions& wf__, memory_t mem__, int n__) {
+        if (dev) {
+            for (int s = 0; s < nsc; s++) {
+                wf__.pw_coeffs(s).copy_to(mem__, 0, n__);
+            }
+        }
+    };
+
+    /* local part of Re <a_i|b_i> */
+    auto dot = [&](Wave_functions& a__, Wave_functions& b__, int i__) {
+        double r{0};
+        for (int s = 0; s < nsc; s++) {
+            for (int igk = 0; igk < ngk; igk++) {
+                r += std::real(std::conj(a__.pw_coeffs(s).prime(igk, i__)) * b__.pw_coeffs(s).prime(igk, i__));
+            }
+        }
+        /* reduced storage implies a single spin component */
+        if (reduced) {
+            r *= 2;
+            if (kp__->comm().rank() == 0) {
+                r -= std::real(std::conj(a__.pw_coeffs(0).prime(0, i__)) * b__.pw_coeffs(0).prime(0, i__));
+            }
+        }
+        return r;
+    };
+
+    /* Upper bound of the spectrum of H from a few Lanczos steps (Zhou and Saad): the largest Gershgorin bound of
+       the tridiagonal matrix plus the norm of the last residual. Unlike the maximum kinetic energy plus |V_eff|
+       it includes the non-local part of H. Lanczos vectors are kept in the first columns of wf1 (previous),
+       wf2 (current) and hphi (H applied to the current one). */
+    auto& v0 = wf1__;
+    auto& v1 = wf2__;
+    for (int s = 0; s < nsc; s++) {
+        for (int igk = 0; igk < ngk; igk++) {
+            v0.pw_coeffs(s).prime(igk, 0) = 0;
+            v1.pw_coeffs(s).prime(igk, 0) = utils::random<double_complex>();
+        }
+    }
+    if (reduced && kp__->comm().rank() == 0) {
+        v1.pw_coeffs(0).prime(0, 0) = std::real(v1.pw_coeffs(0).prime(0, 0));
+    }
+
+    std::vector<double> alpha(num_lanczos);
+    std::vector<double> beta(num_lanczos + 1, 0);
+    beta[0] = dot(v1, v1, 0);
+    kp__->comm().allreduce(&beta[0], 1);
+    beta[0] = std::sqrt(beta[0]);
+
+    for (int j = 0; j < num_lanczos; j++) {
+        for (int s = 0; s < nsc; s++) {
+            for (int igk = 0; igk < ngk; igk++) {
+                v1.pw_coeffs(s).prime(igk, 0) /= beta[j];
+            }
+        }
+        copy_wf(v1, memory_t::device, 1);
+        H__.apply_h_s<T>(kp__, ispn__, 0, 1, v1, &hphi__, nullptr);
+        copy_wf(hphi__, memory_t::host, 1);
+
+        alpha[j] = dot(v1, hphi__, 0);
+        kp__->comm().allreduce(&alpha[j], 1);
+
+        /* w = H v_j - alpha_j v_j - beta_j v_{j-1}; v_{j-1} <- v_j, v_j <- w */
+        double b0 = (j == 0) ? 0 : beta[j];
+        for (int s = 0; s < nsc; s++) {
+            for (int igk = 0; igk < ngk; igk++) {
+                auto w = hphi__.pw_coeffs(s).prime(igk, 0) - alpha[j] * v1.pw_coeffs(s).prime(igk, 0) -
+                         b0 * v0.pw_coeffs(s).prime(igk, 0);
+                v0.pw_coeffs(s).prime(igk, 0) = v1.pw_coeffs(s).prime(igk, 0);
+                v1.pw_coeffs(s).prime(igk, 0) = w;
+            }
+        }
+        beta[j + 1] = dot(v1, v1, 0);
+        kp__->comm().allreduce(&beta[j + 1], 1);
+        beta[j + 1] = std::sqrt(beta[j + 1]);
+        if (beta[j + 1] < 1e-10) {
+            alpha.resize(j + 1);
+            break;
+        }
+    }
+    int m = static_cast<int>(alpha.size());
+    double b{-1e100};
+    for (int j = 0; j < m; j++) {
+        double r = alpha[j] + ((j > 0) ? beta[j] : 0) + ((j < m - 1) ? beta[j + 1] : 0);
+        b = std::max(b, r);
+    }
+    b += beta[m];
+
+    H__.apply_h_s<T>(kp__, ispn__, 0, n__, phi__, &hphi__, nullptr);
+    copy_wf(hphi__, memory_t::host, n__);
+
+    /* the largest Rayleigh quotient of the trial functions is the lower edge of the damped interval */
+    std::vector<double> rq(2 * n__);
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n__; i++) {
+        rq[2 * i]     = dot(phi__, hphi__, i);
+        rq[2 * i + 1] = dot(phi__, phi__, i);
+    }
+    kp__->comm().allreduce(rq);
+    double a{-1e100};
+    for (int i = 0; i < n__; i++) {
+        a = std::max(a, rq[2 * i] / rq[2 * i + 1]);
+    }
+
+    if (a >= b) {
+        return;
+    }
+
+    double e = (b - a) / 2;
+    double c = (b + a) / 2;
+
+    Wave_functions* x = &phi__;
+    Wave_functions* y = &wf1__;
+    Wave_functions* z = &wf2__;
+
+    /* y = (H - c) x / e */
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n__; i++) {
+        for (int s = 0; s < nsc; s++) {
+            for (int igk = 0; igk < ngk; igk++) {
+                y->pw_coeffs(s).prime(igk, i) = (hphi__.pw_coeffs(s).prime(igk, i) - c * x->pw_coeffs(s).prime(igk, i)) / e;
+            }
+        }
+    }
+
+    /* three-term recurrence: z = 2 (H - c) y / e - x */
+    for (int k = 2; k <= order__; k++) {
+        copy_wf(*y, memory_t::device, n__);
+        H__.apply_h_s<T>(kp__, ispn__, 0, n__, *y, &hphi__, nullptr);
+        copy_wf(hphi__, memory_t::host, n__);
+
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < n__; i++) {
+            for (int s = 0; s < nsc; s++) {
+                for (int igk = 0; igk < ngk; igk++) {
+                    z->pw_coeffs(s).prime(igk, i) = 2.0 * (hphi__.pw_coeffs(s).prime(igk, i) -
+                                                    c * y->pw_coeffs(s).prime(igk, i)) / e -
+                                                    x->pw_coeffs(s).prime(igk, i);
+                }
+            }
+        }
+        std::swap(x, y);
+        std::swap(y, z);
+    }
+
+    /* normalize filtered functions and store them in phi; the Chebyshev growth makes the norms very different */
+    std::vector<double> norm(n__);
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n__; i++) {
+        norm[i] = dot(*y, *y, i);
+    }
+    kp__->comm().allreduce(norm);
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n__; i++) {
+        double f = 1.0 / std::sqrt(norm[i]);
+        for (int s = 0; s < nsc; s++) {
+            for (int igk = 0; igk < ngk; igk++) {
+                phi__.pw_coeffs(s).prime(igk, i) = y->pw_coeffs(s).prime(igk, i) * f;
+            }
+        }
+    }
+    copy_wf(phi__, memory_t::device, n__);
+
+    /* the filter drives the functions towards the lowest eigen-vectors; restore the linear independence
+       before the Rayleigh-Ritz step */
+    orthogonalize<T, 0, 0>(ctx_.preferred_memory_t(), ctx_.blas_linalg_t(), ispn__, {&phi__}, 0, n__, o__, wf1__);
+}
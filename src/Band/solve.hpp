@@ -92,6 +92,9 @@ inline int Band::solve_pseudo_potential(K_point& kp__, Hamiltonian& hamiltonian_
         check_wave_functions<T>(kp__, hamiltonian__);
     }
 
+    /* the Hubbard orbitals stay on the host until the atomic positions change */
+    kp__.dismiss_hubbard_wave_functions();
+
     ctx_.fft_coarse().dismiss();
 
     ctx_.print_memory_usage(__FILE__, __LINE__);
@@ -33,7 +33,50 @@ namespace sirius {
 class Beta_projectors : public Beta_projectors_base
 {
   protected:
+    /// Beta-projectors of the chunks that are kept in memory.
+    /** On CPU the resident chunks are generated once and kept until the atomic positions change; on GPU they are
+     *  generated in prepare() and released in dismiss(). */
     matrix<double_complex> beta_pw_all_atoms_;
+
+    /// Buffer for the chunks that don't fit into the memory budget and are generated on the fly.
+    matrix<double_complex> beta_pw_chunk_;
+
+    /// Number of leading chunks that are kept in memory.
+    int num_resident_chunks_{0};
+
+    /// Find the number of chunks that can be kept in memory.
+    /** The budget is controlled by control::memory_usage: "high" keeps all chunks, "medium" allows as many
+     *  beta-projectors as there are bands (the size of one set of wave-functions) and "low" regenerates all chunks
+     *  on every call to generate(). */
+    void find_resident_chunks()
+    {
+        int budget = std::numeric_limits<int>::max();
+        if (ctx_.control().memory_usage_ == "medium") {
+            budget = ctx_.num_bands();
+        }
+        if (ctx_.control().memory_usage_ == "low") {
+            budget = 0;
+        }
+        num_resident_chunks_ = 0;
+        int nbeta{0};
+        for (int ichunk = 0; ichunk < num_chunks(); ichunk++) {
+            if (nbeta + chunk(ichunk).num_beta_ > budget) {
+                break;
+            }
+            nbeta += chunk(ichunk).num_beta_;
+            num_resident_chunks_++;
+        }
+    }
+
+    /// Total number of beta-projectors in the resident chunks.
+    int num_resident_beta() const
+    {
+        if (!num_resident_chunks_) {
+            return 0;
+        }
+        auto& c = chunk(num_resident_chunks_ - 1);
+        return c.offset_ + c.num_beta_;
+    }
     /// Generate plane-wave coefficients for beta-projectors of atom types.
     void generate_pw_coefs_t(std::vector<int>& igk__)
     {
@@ -99,17 +142,58 @@ class Beta_projectors : public Beta_projectors_base
                 pw_coeffs_t_.allocate(memory_t::device).copy_to(memory_t::device);
                 break;
             }
-            /* generate beta projectors for all atoms */
+            /* generate beta projectors for the resident chunks */
             case device_t::CPU: {
-                beta_pw_all_atoms_ = matrix<double_complex>(num_gkvec_loc(), ctx_.unit_cell().mt_lo_basis_size());
-                for (int ichunk = 0; ichunk < num_chunks(); ichunk++) {
-                    /* wrap the the pointer in the big array beta_pw_all_atoms */
+                generate_all_atoms();
+                break;
+            }
+        }
+    }
+
+    /// Generate beta-projectors for the resident chunks and store them in beta_pw_all_atoms_.
+    void generate_all_atoms()
+    {
+        find_resident_chunks();
+
+        if (ctx_.processing_unit() == device_t::CPU) {
+            if (static_cast<int>(beta_pw_all_atoms_.size(1)) != num_resident_beta()) {
+                beta_pw_all_atoms_ = matrix<double_complex>(num_gkvec_loc(), num_resident_beta());
+            }
+            if (num_resident_chunks_ < num_chunks()) {
+                beta_pw_chunk_ = matrix<double_complex>(num_gkvec_loc(), max_num_beta());
+            } else {
+                beta_pw_chunk_ = matrix<double_complex>();
+            }
+        }
+
+        for (int ichunk = 0; ichunk < num_resident_chunks_; ichunk++) {
+            /* wrap the the pointer in the big array beta_pw_all_atoms */
+            switch (ctx_.processing_unit()) {
+                case device_t::CPU: {
                     pw_coeffs_a_ = matrix<double_complex>(&beta_pw_all_atoms_(0, chunk(ichunk).offset_),
                                                           num_gkvec_loc(), chunk(ichunk).num_beta_);
-                    Beta_projectors_base::generate(ichunk, 0);
+                    break;
+                }
+                case device_t::GPU: {
+                    pw_coeffs_a_ = matrix<double_complex>(nullptr,
+                                                          beta_pw_all_atoms_.at(memory_t::device, 0, chunk(ichunk).offset_),
+                                                          num_gkvec_loc(), chunk(ichunk).num_beta_);
+                    break;
                 }
-                break;
             }
+            Beta_projectors_base::generate(ichunk, 0);
+        }
+    }
+
+    /// Update beta-projectors after the change of atomic positions.
+    /** Phase-factor independent coefficients of the atom types depend only on the G+k vectors and are kept. */
+    void update_atom_positions()
+    {
+        PROFILE("sirius::Beta_projectors::update_atom_positions");
+
+        split_in_chunks();
+        if (ctx_.processing_unit() == device_t::CPU && num_beta_t()) {
+            generate_all_atoms();
         }
     }
 
@@ -118,22 +202,59 @@ class Beta_projectors : public Beta_projectors_base
         switch (ctx_.processing_unit()) {
             case device_t::GPU: {
                 Beta_projectors_base::prepare();
+                /* keep the buffer allocated by the base class for the chunks generated on the fly */
+                beta_pw_chunk_ = std::move(pw_coeffs_a_);
+                find_resident_chunks();
+                if (num_resident_chunks_ && num_beta_t()) {
+                    beta_pw_all_atoms_ = matrix<double_complex>(nullptr, num_gkvec_loc(), num_resident_beta());
+                    beta_pw_all_atoms_.allocate(ctx_.mem_pool(memory_t::device));
+                    generate_all_atoms();
+                }
                 break;
             }
             case device_t::CPU: break;
         }
     }
 
+    void dismiss()
+    {
+        Beta_projectors_base::dismiss();
+        if (ctx_.processing_unit() == device_t::GPU) {
+            beta_pw_all_atoms_ = matrix<double_complex>();
+            beta_pw_chunk_     = matrix<double_complex>();
+        }
+    }
+
+    /// Get beta-projectors for a chunk of atoms.
+    /** Resident chunks are taken from the storage; the rest is generated in the buffer. */
     void generate(int chunk__)
     {
+        bool resident = (chunk__ < num_resident_chunks_);
         switch (ctx_.processing_unit()) {
             case device_t::CPU: {
-                pw_coeffs_a_ = matrix<double_complex>(&beta_pw_all_atoms_(0, chunk(chunk__).offset_),
-                                                      num_gkvec_loc(), chunk(chunk__).num_beta_);
+                if (resident) {
+                    pw_coeffs_a_ = matrix<double_complex>(&beta_pw_all_atoms_(0, chunk(chunk__).offset_),
+                                                          num_gkvec_loc(), chunk(chunk__).num_beta_);
+                } else {
+                    pw_coeffs_a_ = matrix<double_complex>(beta_pw_chunk_.at(memory_t::host), num_gkvec_loc(),
+                                                          chunk(chunk__).num_beta_);
+                    Beta_projectors_base::generate(chunk__, 0);
+                }
                 break;
             }
             case device_t::GPU: {
-                Beta_projectors_base::generate(chunk__, 0);
+                if (resident) {
+                    pw_coeffs_a_ = matrix<double_complex>(nullptr,
+                                                          beta_pw_all_atoms_.at(memory_t::device, 0, chunk(chunk__).offset_),
+                                                          num_gkvec_loc(), chunk(chunk__).num_beta_);
+                    if (gkvec_.comm().rank() == 0 && is_host_memory(ctx_.preferred_memory_t())) {
+                        generate_g0(chunk__, 0);
+                    }
+                } else {
+                    pw_coeffs_a_ = matrix<double_complex>(nullptr, beta_pw_chunk_.at(memory_t::device),
+                                                          num_gkvec_loc(), chunk(chunk__).num_beta_);
+                    Beta_projectors_base::generate(chunk__, 0);
+                }
                 break;
             }
         }
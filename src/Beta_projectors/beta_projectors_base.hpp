@@ -76,6 +76,17 @@ class Beta_projectors_base
     /// Coordinates of G+k vectors used by GPU kernel.
     mdarray<double, 2> gkvec_coord_;
 
+    /// Integer coordinates of the local G-vectors of the G+k set.
+    mdarray<int, 2> gvec_loc_;
+
+    /// Minimum and maximum values of the local G-vector coordinates.
+    vector3d<int> gvec_min_;
+    vector3d<int> gvec_max_;
+
+    /// Starting indices of the runs of local G+k vectors with the same x and y coordinates (z-columns).
+    /** The last element is the total number of local G+k vectors. */
+    std::vector<int> zcol_runs_;
+
     /// Number of different components: 1 for beta-projectors, 3 for gradient, 9 for strain derivatives.
     int N_;
 
@@ -160,6 +171,41 @@ class Beta_projectors_base
         }
     }
 
+    /// Find the z-column runs and the limits of the local G-vector coordinates.
+    void init_gvec_runs()
+    {
+        gvec_loc_ = mdarray<int, 2>(3, num_gkvec_loc());
+        for (int x: {0, 1, 2}) {
+            gvec_min_[x] = 0;
+            gvec_max_[x] = 0;
+        }
+        zcol_runs_.clear();
+        for (int igk_loc = 0; igk_loc < num_gkvec_loc(); igk_loc++) {
+            auto G = gkvec_.gvec(igk_[igk_loc]);
+            for (int x: {0, 1, 2}) {
+                gvec_loc_(x, igk_loc) = G[x];
+                gvec_min_[x] = std::min(gvec_min_[x], G[x]);
+                gvec_max_[x] = std::max(gvec_max_[x], G[x]);
+            }
+            if (igk_loc == 0 || G[0] != gvec_loc_(0, igk_loc - 1) || G[1] != gvec_loc_(1, igk_loc - 1)) {
+                zcol_runs_.push_back(igk_loc);
+            }
+        }
+        zcol_runs_.push_back(num_gkvec_loc());
+    }
+
+    /// Make beta-projectors for G=0 on the CPU.
+    /** This is used when beta-projectors are on GPU but the wave-functions are on CPU. */
+    void generate_g0(int ichunk__, int j__)
+    {
+        for (int i = 0; i < chunk(ichunk__).num_atoms_; i++) {
+            for (int xi = 0; xi < chunk(ichunk__).desc_(beta_desc_idx::nbf, i); xi++) {
+                pw_coeffs_a_g0_(chunk(ichunk__).desc_(beta_desc_idx::offset, i) + xi) =
+                    pw_coeffs_t_(0, chunk(ichunk__).desc_(beta_desc_idx::offset_t, i) + xi, j__);
+            }
+        }
+    }
+
     template <typename T>
     inline void local_inner_aux(T* beta_pw_coeffs_a_ptr__, int nbeta__, Wave_functions& phi__, int ispn__, int idx0__,
                                 int n__, matrix<T>& beta_phi__) const;
@@ -183,6 +229,8 @@ class Beta_projectors_base
         /* allocate memory */
         pw_coeffs_t_ = mdarray<double_complex, 3>(num_gkvec_loc(), num_beta_t(), N__, memory_t::host, "pw_coeffs_t_");
 
+        init_gvec_runs();
+
         if (ctx_.processing_unit() == device_t::GPU) {
             gkvec_coord_ = mdarray<double, 2>(3, num_gkvec_loc());
             gkvec_coord_.allocate(memory_t::device);
@@ -299,23 +347,44 @@ class Beta_projectors_base
 
         switch (ctx_.processing_unit()) {
             case device_t::CPU: {
-                #pragma omp for
+                int num_runs = static_cast<int>(zcol_runs_.size()) - 1;
+                #pragma omp parallel for schedule(static)
                 for (int i = 0; i < chunk(ichunk__).num_atoms_; i++) {
-                    int ia = chunk(ichunk__).desc_(beta_desc_idx::ia, i);
-
-                    double phase = twopi * dot(gkvec_.vk(), ctx_.unit_cell().atom(ia).position());
-                    double_complex phase_k = std::exp(double_complex(0.0, phase));
+                    int ia   = chunk(ichunk__).desc_(beta_desc_idx::ia, i);
+                    auto pos = ctx_.unit_cell().atom(ia).position();
+
+                    /* 1D phase factors e^{-iG_x x_{\alpha}} are computed by recursion starting from G_x = 0 */
+                    std::array<std::vector<double_complex>, 3> phase_x;
+                    for (int x: {0, 1, 2}) {
+                        phase_x[x].resize(gvec_max_[x] - gvec_min_[x] + 1);
+                        auto dz = std::exp(double_complex(0.0, -twopi * pos[x]));
+                        int i0  = -gvec_min_[x];
+                        phase_x[x][i0] = 1.0;
+                        for (int j = i0 + 1; j < static_cast<int>(phase_x[x].size()); j++) {
+                            phase_x[x][j] = phase_x[x][j - 1] * dz;
+                        }
+                        for (int j = i0 - 1; j >= 0; j--) {
+                            phase_x[x][j] = phase_x[x][j + 1] * std::conj(dz);
+                        }
+                    }
+                    auto phase_k = std::exp(double_complex(0.0, -twopi * dot(gkvec_.vk(), pos)));
 
+                    /* total phase e^{-i(G+k)r_{\alpha}}; x and y parts are constant along a z-column */
                     std::vector<double_complex> phase_gk(num_gkvec_loc());
-                    for (int igk_loc = 0; igk_loc < num_gkvec_loc(); igk_loc++) {
-                        auto G = gkvec_.gvec(igk_[igk_loc]);
-                        /* total phase e^{i(G+k)r_{\alpha}} */
-                        phase_gk[igk_loc] = std::conj(ctx_.gvec_phase_factor(G, ia) * phase_k);
+                    auto pz = &phase_x[2][-gvec_min_[2]];
+                    for (int r = 0; r < num_runs; r++) {
+                        int i0 = zcol_runs_[r];
+                        auto z = phase_k * phase_x[0][gvec_loc_(0, i0) - gvec_min_[0]] *
+                                 phase_x[1][gvec_loc_(1, i0) - gvec_min_[1]];
+                        for (int igk_loc = i0; igk_loc < zcol_runs_[r + 1]; igk_loc++) {
+                            phase_gk[igk_loc] = z * pz[gvec_loc_(2, igk_loc)];
+                        }
                     }
                     for (int xi = 0; xi < chunk(ichunk__).desc_(beta_desc_idx::nbf, i); xi++) {
+                        auto dst = &pw_coeffs_a_(0, chunk(ichunk__).desc_(beta_desc_idx::offset, i) + xi);
+                        auto src = &pw_coeffs_t_(0, chunk(ichunk__).desc_(beta_desc_idx::offset_t, i) + xi, j__);
                         for (int igk_loc = 0; igk_loc < num_gkvec_loc(); igk_loc++) {
-                            pw_coeffs_a_(igk_loc, chunk(ichunk__).desc_(beta_desc_idx::offset, i) + xi) = 
-                                pw_coeffs_t_(igk_loc, chunk(ichunk__).desc_(beta_desc_idx::offset_t, i) + xi, j__) * phase_gk[igk_loc];
+                            dst[igk_loc] = src[igk_loc] * phase_gk[igk_loc];
                         }
                     }
                 }
@@ -334,14 +403,7 @@ class Beta_projectors_base
 #endif
                 /* wave-functions are on CPU but the beta-projectors are on GPU */
                 if (gkvec_.comm().rank() == 0 && is_host_memory(ctx_.preferred_memory_t())) {
-                    /* make beta-projectors for G=0 on the CPU */
-                    #pragma omp for schedule(static)
-                    for (int i = 0; i < chunk(ichunk__).num_atoms_; i++) {
-                        for (int xi = 0; xi < chunk(ichunk__).desc_(beta_desc_idx::nbf, i); xi++) {
-                            pw_coeffs_a_g0_(chunk(ichunk__).desc_(beta_desc_idx::offset, i) + xi) =
-                                pw_coeffs_t_(0, chunk(ichunk__).desc_(beta_desc_idx::offset_t, i) + xi, j__);
-                        }
-                    }
+                    generate_g0(ichunk__, j__);
                 }
                 break;
             }
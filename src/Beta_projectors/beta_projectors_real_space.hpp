@@ -0,0 +1,507 @@
+// Copyright (c) 2013-2019 Anton Kozhevnikov, Thomas Schulthess
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+// the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+//    following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+//    and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/** \file beta_projectors_real_space.hpp
+ *
+ *  \brief Contains declaration and implementation of sirius::Beta_projectors_real_space class.
+ */
+
+#ifndef __BETA_PROJECTORS_REAL_SPACE_HPP__
+#define __BETA_PROJECTORS_REAL_SPACE_HPP__
+
+#include "simulation_context.hpp"
+#include "sbessel.hpp"
+
+namespace sirius {
+
+/// Beta-projectors on the real-space points of the coarse FFT grid around each atom.
+/** In the real-space mode the non-local part of the Hamiltonian is applied to the wave-functions in the
+ *  FFT buffer of the local operator. For a Bloch function \f$ \psi({\bf r}) = \frac{1}{\sqrt{\Omega}}
+ *  e^{i{\bf kr}} u({\bf r}) \f$, where \f$ u({\bf r}) \f$ is the output of the backward FFT, the projection is
+ *  \f[
+ *      \langle \beta_{\xi}^{\alpha} | \psi \rangle = \frac{\sqrt{\Omega}}{N} \sum_{{\bf r}}
+ *        \beta_{\xi}({\bf r}' - {\bf r}_{\alpha}) e^{i{\bf k r}'} u({\bf r})
+ *  \f]
+ *  where the sum runs over the grid points inside the sphere of radius \f$ R_{m} \f$ around the atom and
+ *  \f$ {\bf r}' \f$ is the periodic image of \f$ {\bf r} \f$ closest to the atom. The result of
+ *  \f$ \sum_{\xi'} D_{\xi \xi'} \langle \beta_{\xi'} | \psi \rangle \f$ is added back to the FFT buffer before
+ *  the forward transformation.
+ *
+ *  To control the error introduced by the truncation of the projectors, the mask-function technique of
+ *  King-Smith et al. (PRB 44, 13063 (1991)) is used: \f$ \beta(r) / m(r) \f$ is filtered to the wave-function
+ *  cutoff in the reciprocal space and then multiplied by the mask function \f$ m(r) \f$ which smoothly goes to
+ *  zero at \f$ R_{m} \f$. The mask radius is the cutoff radius of the beta-projectors times
+ *  control::beta_mask_ratio.
+ *
+ *  Only the norm-conserving pseudopotentials without spin-orbit coupling and the non-magnetic or collinear
+ *  case on the CPU are supported.
+ */
+class Beta_projectors_real_space
+{
+  private:
+    /// Simulation context.
+    Simulation_context const& ctx_;
+
+    /// Radius of the mask function for each atom type.
+    std::vector<double> rmask_;
+
+    /// Filtered and masked radial functions of the beta-projectors for each atom type.
+    std::vector<std::vector<Spline<double>>> beta_rf_;
+
+    /// Offset of each atom in the array of projections.
+    std::vector<int> offset_;
+
+    /// Local indices of the FFT grid points around each atom (sorted in ascending order).
+    std::vector<std::vector<int>> grid_idx_;
+
+    /// Fractional coordinates of the periodic images of grid points closest to the atom.
+    std::vector<std::vector<vector3d<double>>> grid_pos_;
+
+    /// Values of beta-projectors (multiplied by sqrt(Omega)) at the grid points of each atom.
+    std::vector<mdarray<double, 2>> beta_r_;
+
+    /// Bloch phase factors exp(ikr') for the current k-point.
+    std::vector<std::vector<double_complex>> phase_;
+
+    /// Lattice coordinates of the current k-point.
+    vector3d<double> vk_;
+
+    /// True if the phase factors for the current k-point are computed.
+    bool phase_ready_{false};
+
+    /// D-operator matrices for each atom and spin component.
+    std::vector<mdarray<double, 3>> d_mtrx_;
+
+    /// Projections of the current wave-function.
+    std::vector<double_complex> beta_phi_;
+
+    /// Projections multiplied by the D-operator matrices.
+    std::vector<double_complex> d_beta_phi_;
+
+    /// Atomic positions for which the grid points were found.
+    std::vector<vector3d<double>> positions_;
+
+    /// Lattice vectors for which the grid points were found.
+    matrix3d<double> lattice_vectors_;
+
+    /// Mask function.
+    static double mask(double x__)
+    {
+        if (x__ >= 1) {
+            return 0;
+        }
+        return std::pow(std::cos(0.5 * pi * x__), 2);
+    }
+
+    /// Generate radial functions of the masked beta-projectors.
+    void generate_radial_functions()
+    {
+        PROFILE("sirius::Beta_projectors_real_space::generate_radial_functions");
+
+        auto& uc = ctx_.unit_cell();
+        /* wave-function cutoff */
+        double qmax = ctx_.gk_cutoff();
+
+        rmask_   = std::vector<double>(uc.num_atom_types(), 0);
+        beta_rf_ = std::vector<std::vector<Spline<double>>>(uc.num_atom_types());
+
+        for (int iat = 0; iat < uc.num_atom_types(); iat++) {
+            auto& type = uc.atom_type(iat);
+            int nrb    = type.num_beta_radial_functions();
+            if (!nrb) {
+                continue;
+            }
+            auto& rgrid = type.radial_grid();
+
+            /* find the cutoff radius of the beta-projectors */
+            double rb{0};
+            for (int idxrf = 0; idxrf < nrb; idxrf++) {
+                auto& beta = type.beta_radial_function(idxrf);
+                for (int ir = 0; ir < rgrid.num_points(); ir++) {
+                    if (std::abs(beta(ir)) > 1e-10) {
+                        rb = std::max(rb, rgrid[std::min(ir + 1, rgrid.num_points() - 1)]);
+                    }
+                }
+            }
+            double rm    = ctx_.control().beta_mask_ratio_ * rb;
+            rmask_[iat] = rm;
+
+            /* remember that beta(r) are defined as miltiplied by r */
+            std::vector<Spline<double>> g(nrb);
+            for (int idxrf = 0; idxrf < nrb; idxrf++) {
+                g[idxrf] = Spline<double>(rgrid);
+                auto& beta = type.beta_radial_function(idxrf);
+                for (int ir = 0; ir < rgrid.num_points(); ir++) {
+                    double m = mask(rgrid[ir] / rm);
+                    g[idxrf](ir) = (m > 0) ? beta(ir) / m : 0;
+                }
+                g[idxrf].interpolate();
+            }
+
+            /* Bessel transform of beta(r) / m(r) up to the wave-function cutoff */
+            int nq = static_cast<int>(4 * qmax * rm) + 100;
+            Radial_grid_lin<double> qgrid(nq, 0, qmax);
+            mdarray<double, 2> gq(nq, nrb);
+            #pragma omp parallel for
+            for (int iq = 0; iq < nq; iq++) {
+                Spherical_Bessel_functions jl(uc.lmax(), rgrid, qgrid[iq]);
+                for (int idxrf = 0; idxrf < nrb; idxrf++) {
+                    int l         = type.indexr(idxrf).l;
+                    gq(iq, idxrf) = sirius::inner(jl[l], g[idxrf], 1);
+                }
+            }
+
+            /* backward transform and multiplication by the mask function */
+            int nr = static_cast<int>(50 * rm) + 100;
+            Radial_grid_lin<double> rlin(nr, 0, rm);
+            beta_rf_[iat] = std::vector<Spline<double>>(nrb);
+            for (int idxrf = 0; idxrf < nrb; idxrf++) {
+                beta_rf_[iat][idxrf] = Spline<double>(rlin);
+            }
+            #pragma omp parallel
+            {
+                Spline<double> s(qgrid);
+                std::vector<double> qr(nq);
+                mdarray<double, 2> jl(nq, uc.lmax() + 1);
+                #pragma omp for
+                for (int ir = 0; ir < nr; ir++) {
+                    double m = mask(rlin[ir] / rm);
+                    for (int iq = 0; iq < nq; iq++) {
+                        qr[iq] = qgrid[iq] * rlin[ir];
+                    }
+                    Spherical_Bessel_functions::sbessel(uc.lmax(), nq, qr.data(),
+                                                        [&](int l, int iq) -> double& { return jl(iq, l); });
+                    for (int idxrf = 0; idxrf < nrb; idxrf++) {
+                        int l = type.indexr(idxrf).l;
+                        for (int iq = 0; iq < nq; iq++) {
+                            s(iq) = gq(iq, idxrf) * jl(iq, l);
+                        }
+                        beta_rf_[iat][idxrf](ir) = m * s.interpolate().integrate(2) * 2 / pi;
+                    }
+                }
+            }
+            for (int idxrf = 0; idxrf < nrb; idxrf++) {
+                beta_rf_[iat][idxrf].interpolate();
+            }
+        }
+    }
+
+    /// Find the grid points around atoms and compute the beta-projectors on them.
+    void generate_grid_points()
+    {
+        PROFILE("sirius::Beta_projectors_real_space::generate_grid_points");
+
+        auto& uc  = ctx_.unit_cell();
+        auto& fft = ctx_.fft_coarse();
+
+        grid_idx_ = std::vector<std::vector<int>>(uc.num_atoms());
+        grid_pos_ = std::vector<std::vector<vector3d<double>>>(uc.num_atoms());
+        beta_r_   = std::vector<mdarray<double, 2>>(uc.num_atoms());
+
+        vector3d<double> delta(1.0 / fft.size(0), 1.0 / fft.size(1), 1.0 / fft.size(2));
+
+        int z_off = fft.offset_z();
+        vector3d<int> grid_beg(0, 0, z_off);
+        vector3d<int> grid_end(fft.size(0), fft.size(1), z_off + fft.local_size_z());
+
+        double sqrt_omega = std::sqrt(uc.omega());
+
+        #pragma omp parallel for schedule(dynamic)
+        for (int ia = 0; ia < uc.num_atoms(); ia++) {
+            auto& type = uc.atom(ia).type();
+            int nbf    = type.mt_basis_size();
+            if (!nbf) {
+                continue;
+            }
+            double R = rmask_[type.id()];
+
+            std::vector<vector3d<double>> verts_cart{{-R, -R, -R}, {R, -R, -R}, {-R, R, -R}, {R, R, -R},
+                                                     {-R, -R, R},  {R, -R, R},  {-R, R, R},  {R, R, R}};
+
+            /* grid index, position of the periodic image and displacement from the atom */
+            std::vector<std::tuple<int, vector3d<double>, vector3d<double>>> points;
+
+            for (int t0 = -1; t0 <= 1; t0++) {
+                for (int t1 = -1; t1 <= 1; t1++) {
+                    for (int t2 = -1; t2 <= 1; t2++) {
+                        auto pos = uc.atom(ia).position() + vector3d<double>(t0, t1, t2);
+
+                        /* find the small box around this atom */
+                        std::vector<vector3d<double>> verts;
+                        for (auto v : verts_cart) {
+                            verts.push_back(pos + uc.get_fractional_coordinates(v));
+                        }
+                        vector3d<int> box_beg, box_end;
+                        for (int x : {0, 1, 2}) {
+                            std::sort(verts.begin(), verts.end(),
+                                      [x](vector3d<double>& a, vector3d<double>& b) { return a[x] < b[x]; });
+                            box_beg[x] = std::max(static_cast<int>(verts[0][x] / delta[x]) - 1, grid_beg[x]);
+                            box_end[x] = std::min(static_cast<int>(verts[7][x] / delta[x]) + 2, grid_end[x]);
+                        }
+
+                        for (int j0 = box_beg[0]; j0 < box_end[0]; j0++) {
+                            for (int j1 = box_beg[1]; j1 < box_end[1]; j1++) {
+                                for (int j2 = box_beg[2]; j2 < box_end[2]; j2++) {
+                                    auto v  = pos - vector3d<double>(delta[0] * j0, delta[1] * j1, delta[2] * j2);
+                                    auto vc = uc.get_cartesian_coordinates(v);
+                                    if (vc.length() < R) {
+                                        int ir = fft.index_by_coord(j0, j1, j2 - z_off);
+                                        points.push_back(std::make_tuple(ir, uc.atom(ia).position() - v, vc * (-1.0)));
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+            std::sort(points.begin(), points.end(),
+                      [](std::tuple<int, vector3d<double>, vector3d<double>> const& a,
+                         std::tuple<int, vector3d<double>, vector3d<double>> const& b) {
+                          return std::get<0>(a) < std::get<0>(b);
+                      });
+
+            int npt = static_cast<int>(points.size());
+            grid_idx_[ia].resize(npt);
+            grid_pos_[ia].resize(npt);
+            beta_r_[ia] = mdarray<double, 2>(nbf, npt);
+
+            std::vector<double> rlm(utils::lmmax(uc.lmax()));
+            for (int ipt = 0; ipt < npt; ipt++) {
+                grid_idx_[ia][ipt] = std::get<0>(points[ipt]);
+                grid_pos_[ia][ipt] = std::get<1>(points[ipt]);
+                /* spherical coordinates of the displacement */
+                auto vs = SHT::spherical_coordinates(std::get<2>(points[ipt]));
+                SHT::spherical_harmonics(uc.lmax(), vs[1], vs[2], &rlm[0]);
+                for (int xi = 0; xi < nbf; xi++) {
+                    int lm    = type.indexb(xi).lm;
+                    int idxrf = type.indexb(xi).idxrf;
+                    beta_r_[ia](xi, ipt) = sqrt_omega * beta_rf_[type.id()][idxrf].at_point(vs[0]) * rlm[lm];
+                }
+            }
+        }
+
+        positions_.resize(uc.num_atoms());
+        for (int ia = 0; ia < uc.num_atoms(); ia++) {
+            positions_[ia] = uc.atom(ia).position();
+        }
+        lattice_vectors_ = uc.lattice_vectors();
+        phase_ready_     = false;
+
+        if (ctx_.control().verbosity_ >= 2 && ctx_.comm().rank() == 0) {
+            size_t n{0};
+            for (int ia = 0; ia < uc.num_atoms(); ia++) {
+                n += grid_idx_[ia].size();
+            }
+            printf("number of grid points for real-space beta-projectors : %li\n", n);
+        }
+    }
+
+  public:
+    /// Constructor.
+    Beta_projectors_real_space(Simulation_context const& ctx__)
+        : ctx_(ctx__)
+    {
+        auto& uc = ctx_.unit_cell();
+        offset_  = std::vector<int>(uc.num_atoms());
+        int n{0};
+        for (int ia = 0; ia < uc.num_atoms(); ia++) {
+            offset_[ia] = n;
+            n += uc.atom(ia).mt_basis_size();
+        }
+        beta_phi_   = std::vector<double_complex>(n);
+        d_beta_phi_ = std::vector<double_complex>(n);
+
+        generate_radial_functions();
+    }
+
+    /// Check if the real-space beta-projectors can be used for a given simulation.
+    static bool is_applicable(Simulation_context const& ctx__)
+    {
+        if (ctx__.full_potential() || ctx__.so_correction() || ctx__.num_mag_dims() == 3 ||
+            ctx__.processing_unit() != device_t::CPU) {
+            return false;
+        }
+        for (int iat = 0; iat < ctx__.unit_cell().num_atom_types(); iat++) {
+            auto& type = ctx__.unit_cell().atom_type(iat);
+            if (type.augment() || type.spin_orbit_coupling()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Update the grid points and the D-operator matrices.
+    /** This function must be called each time when the D-operator matrices of atoms are changed. The grid
+     *  points are recomputed only if the atomic positions or lattice vectors have changed. */
+    void prepare()
+    {
+        PROFILE("sirius::Beta_projectors_real_space::prepare");
+
+        auto& uc = ctx_.unit_cell();
+
+        bool update_grid = (static_cast<int>(positions_.size()) != uc.num_atoms());
+        for (int ia = 0; ia < uc.num_atoms() && !update_grid; ia++) {
+            if ((uc.atom(ia).position() - positions_[ia]).length() > 1e-12) {
+                update_grid = true;
+            }
+        }
+        for (int i = 0; i < 3 && !update_grid; i++) {
+            for (int j = 0; j < 3; j++) {
+                if (std::abs(uc.lattice_vectors()(i, j) - lattice_vectors_(i, j)) > 1e-12) {
+                    update_grid = true;
+                }
+            }
+        }
+        if (update_grid) {
+            generate_grid_points();
+        }
+
+        d_mtrx_ = std::vector<mdarray<double, 3>>(uc.num_atoms());
+        for (int ia = 0; ia < uc.num_atoms(); ia++) {
+            int nbf = uc.atom(ia).mt_basis_size();
+            d_mtrx_[ia] = mdarray<double, 3>(nbf, nbf, ctx_.num_spins());
+            for (int xi2 = 0; xi2 < nbf; xi2++) {
+                for (int xi1 = 0; xi1 < nbf; xi1++) {
+                    double v = uc.atom(ia).d_mtrx(xi1, xi2, 0);
+                    if (ctx_.num_mag_dims() == 1) {
+                        double bz = uc.atom(ia).d_mtrx(xi1, xi2, 1);
+                        d_mtrx_[ia](xi1, xi2, 0) = v + bz;
+                        d_mtrx_[ia](xi1, xi2, 1) = v - bz;
+                    } else {
+                        d_mtrx_[ia](xi1, xi2, 0) = v;
+                    }
+                }
+            }
+        }
+    }
+
+    /// Compute the Bloch phase factors for a given k-point.
+    void prepare(vector3d<double> vk__)
+    {
+        if (phase_ready_ && (vk__ - vk_).length() < 1e-12) {
+            return;
+        }
+        PROFILE("sirius::Beta_projectors_real_space::prepare|k");
+
+        auto& uc = ctx_.unit_cell();
+        phase_   = std::vector<std::vector<double_complex>>(uc.num_atoms());
+
+        #pragma omp parallel for schedule(dynamic)
+        for (int ia = 0; ia < uc.num_atoms(); ia++) {
+            int npt = static_cast<int>(grid_idx_[ia].size());
+            phase_[ia].resize(npt);
+            for (int ipt = 0; ipt < npt; ipt++) {
+                phase_[ia][ipt] = std::exp(double_complex(0, twopi * dot(vk__, grid_pos_[ia][ipt])));
+            }
+        }
+        vk_          = vk__;
+        phase_ready_ = true;
+    }
+
+    /// Project the wave-function in the FFT buffer and apply the D-operator.
+    /** \param [in] ispn Index of spin (0 or 1).
+     *  \param [in] buf  FFT buffer with \f$ u({\bf r}) \f$.
+     *
+     *  In case of the Gamma-point two real wave-functions \f$ \psi_1 + i \psi_2 \f$ are stored in the buffer.
+     *  Because the beta-projectors, phase factors and D-operator are real in this case, the real and imaginary
+     *  parts of the projections correspond to the first and second wave-function.
+     */
+    void project(int ispn__, mdarray<double_complex, 1> const& buf__)
+    {
+        PROFILE("sirius::Beta_projectors_real_space::project");
+
+        auto& uc    = ctx_.unit_cell();
+        auto& fft   = ctx_.fft_coarse();
+        double norm = 1.0 / fft.size();
+
+        #pragma omp parallel for schedule(dynamic)
+        for (int ia = 0; ia < uc.num_atoms(); ia++) {
+            int nbf = uc.atom(ia).mt_basis_size();
+            auto p  = &beta_phi_[offset_[ia]];
+            for (int xi = 0; xi < nbf; xi++) {
+                p[xi] = 0;
+            }
+            for (int ipt = 0; ipt < static_cast<int>(grid_idx_[ia].size()); ipt++) {
+                auto z = buf__[grid_idx_[ia][ipt]] * phase_[ia][ipt];
+                for (int xi = 0; xi < nbf; xi++) {
+                    p[xi] += beta_r_[ia](xi, ipt) * z;
+                }
+            }
+            for (int xi = 0; xi < nbf; xi++) {
+                p[xi] *= norm;
+            }
+        }
+        if (fft.comm().size() > 1) {
+            fft.comm().allreduce(beta_phi_.data(), static_cast<int>(beta_phi_.size()));
+        }
+
+        #pragma omp parallel for schedule(dynamic)
+        for (int ia = 0; ia < uc.num_atoms(); ia++) {
+            int nbf = uc.atom(ia).mt_basis_size();
+            for (int xi1 = 0; xi1 < nbf; xi1++) {
+                double_complex z(0, 0);
+                for (int xi2 = 0; xi2 < nbf; xi2++) {
+                    z += d_mtrx_[ia](xi1, xi2, ispn__) * beta_phi_[offset_[ia] + xi2];
+                }
+                d_beta_phi_[offset_[ia] + xi1] = z;
+            }
+        }
+    }
+
+    /// Add the non-local contribution to the FFT buffer.
+    /** The projections computed by the last call to project() are used. Each thread updates its own
+     *  contiguous part of the buffer, so the overlapping spheres of neighbouring atoms are safe. */
+    void add(mdarray<double_complex, 1>& buf__) const
+    {
+        PROFILE("sirius::Beta_projectors_real_space::add");
+
+        auto& uc = ctx_.unit_cell();
+        int size = ctx_.fft_coarse().local_size();
+
+        #pragma omp parallel
+        {
+            int nt  = omp_get_num_threads();
+            int tid = omp_get_thread_num();
+            int ir0 = static_cast<int>(static_cast<size_t>(size) * tid / nt);
+            int ir1 = static_cast<int>(static_cast<size_t>(size) * (tid + 1) / nt);
+
+            for (int ia = 0; ia < uc.num_atoms(); ia++) {
+                int nbf = uc.atom(ia).mt_basis_size();
+                if (!nbf) {
+                    continue;
+                }
+                auto& idx = grid_idx_[ia];
+                int i0 = static_cast<int>(std::lower_bound(idx.begin(), idx.end(), ir0) - idx.begin());
+                int i1 = static_cast<int>(std::lower_bound(idx.begin(), idx.end(), ir1) - idx.begin());
+                auto dp = &d_beta_phi_[offset_[ia]];
+                for (int ipt = i0; ipt < i1; ipt++) {
+                    double_complex z(0, 0);
+                    for (int xi = 0; xi < nbf; xi++) {
+                        z += beta_r_[ia](xi, ipt) * dp[xi];
+                    }
+                    buf__[idx[ipt]] += z * std::conj(phase_[ia][ipt]);
+                }
+            }
+        }
+    }
+};
+
+} // namespace sirius
+
+#endif
@@ -22,7 +22,6 @@
  *  \brief Contains implementation of sirius::Density::add_k_point_contribution_rg() function.
  */
 
-//TODO: in case of Gamma-point transfrom two wave functions at once
 //TODO: use GPU pointer
 
 inline void Density::add_k_point_contribution_rg(K_point* kp__)
@@ -53,30 +52,71 @@ inline void Density::add_k_point_contribution_rg(K_point* kp__)
                 continue;
             }
 
-            for (int i = 0; i < kp__->spinor_wave_functions().pw_coeffs(ispn).spl_num_col().local_size(); i++) {
-                int j = kp__->spinor_wave_functions().pw_coeffs(ispn).spl_num_col()[i];
-                double w = kp__->band_occupancy(j, ispn) * kp__->weight() / omega;
+            auto& wf = kp__->spinor_wave_functions().pw_coeffs(ispn);
+
+            int nloc = wf.spl_num_col().local_size();
+
+            /* number of bands transformed at once; in case of Gamma-point wave-functions are real and two bands
+               are packed into one complex FFT as psi_1(r) + i psi_2(r) */
+            int nb = (kp__->gkvec().reduced()) ? 2 : 1;
+
+            for (int i = 0; i < nloc; i += nb) {
+                int j     = wf.spl_num_col()[i];
+                double w1 = kp__->band_occupancy(j, ispn) * kp__->weight() / omega;
 
                 /* transform to real space; in case of GPU wave-function stays in GPU memory */
-                fft.transform<1>(kp__->spinor_wave_functions().pw_coeffs(ispn).extra().at(memory_t::host, 0, i));
-                /* add to density */
-                switch (fft.pu()) {
-                    case CPU: {
-                        #pragma omp parallel for schedule(static)
-                        for (int ir = 0; ir < fft.local_size(); ir++) {
-                            auto z = fft.buffer(ir);
-                            density_rg(ir, ispn) += w * (std::pow(z.real(), 2) + std::pow(z.imag(), 2));
+                if (nb == 2 && i + 1 < nloc) {
+                    int j2    = wf.spl_num_col()[i + 1];
+                    double w2 = kp__->band_occupancy(j2, ispn) * kp__->weight() / omega;
+
+                    fft.transform<1>(wf.extra().at(memory_t::host, 0, i), wf.extra().at(memory_t::host, 0, i + 1));
+                    /* add to density */
+                    switch (fft.pu()) {
+                        case CPU: {
+                            double* rho = density_rg.at(memory_t::host, 0, ispn);
+                            double_complex const* z = fft.buffer().at(memory_t::host);
+                            #pragma omp parallel for schedule(static)
+                            for (int ir = 0; ir < fft.local_size(); ir++) {
+                                double re = z[ir].real();
+                                double im = z[ir].imag();
+                                rho[ir] += w1 * re * re + w2 * im * im;
+                            }
+                            break;
+                        }
+                        case GPU: {
+#ifdef __GPU
+                            update_density_rg_1_pair_gpu(fft.local_size(), fft.buffer().at(memory_t::device), w1, w2,
+                                                         density_rg.at(memory_t::device, 0, ispn));
+#else
+                            TERMINATE_NO_GPU
+#endif
+                            break;
                         }
-                        break;
                     }
-                    case GPU: {
+                } else {
+                    fft.transform<1>(wf.extra().at(memory_t::host, 0, i));
+                    /* add to density */
+                    switch (fft.pu()) {
+                        case CPU: {
+                            double* rho = density_rg.at(memory_t::host, 0, ispn);
+                            double_complex const* z = fft.buffer().at(memory_t::host);
+                            #pragma omp parallel for schedule(static)
+                            for (int ir = 0; ir < fft.local_size(); ir++) {
+                                double re = z[ir].real();
+                                double im = z[ir].imag();
+                                rho[ir] += w1 * (re * re + im * im);
+                            }
+                            break;
+                        }
+                        case GPU: {
 #ifdef __GPU
-                        update_density_rg_1_gpu(fft.local_size(), fft.buffer().at(memory_t::device), w,
-                                                density_rg.at(memory_t::device, 0, ispn));
+                            update_density_rg_1_gpu(fft.local_size(), fft.buffer().at(memory_t::device), w1,
+                                                    density_rg.at(memory_t::device, 0, ispn));
 #else
-                        TERMINATE_NO_GPU
+                            TERMINATE_NO_GPU
 #endif
-                        break;
+                            break;
+                        }
                     }
                 }
             }
@@ -80,7 +80,7 @@ class Augmentation_operator
         }
 
         /* Gaunt coefficients of three real spherical harmonics */
-        Gaunt_coefficients<double> gaunt_coefs(lmax_beta, 2 * lmax_beta, lmax_beta, SHT::gaunt_rlm);
+        auto gaunt_coefs = Gaunt_coefficients<double>::get(lmax_beta, 2 * lmax_beta, lmax_beta, gaunt_t::rlm);
 
         /* split G-vectors between ranks */
         int gvec_count  = gvec_.count();
@@ -125,7 +125,7 @@ class Augmentation_operator
                         v[lm3] = std::conj(zilm[lm3]) * gvec_rlm(lm3, igloc) * ri(idxrf12, l_by_lm[lm3]);
                     }
 
-                    double_complex z = fourpi_omega * gaunt_coefs.sum_L3_gaunt(lm2, lm1, &v[0]);
+                    double_complex z = fourpi_omega * gaunt_coefs->sum_L3_gaunt(lm2, lm1, &v[0]);
 
                     q_pw_(idx12, 2 * igloc)     = z.real();
                     q_pw_(idx12, 2 * igloc + 1) = z.imag();
@@ -245,7 +245,7 @@ class Augmentation_operator_gvec_deriv
 
     mdarray<double, 3> rlm_dg_;
 
-    std::unique_ptr<Gaunt_coefficients<double>> gaunt_coefs_;
+    std::shared_ptr<Gaunt_coefficients<double> const> gaunt_coefs_;
 
   public:
     Augmentation_operator_gvec_deriv(int                 lmax__,
@@ -260,7 +260,7 @@ class Augmentation_operator_gvec_deriv
         int lmmax = utils::lmmax(2 * lmax);
 
         /* Gaunt coefficients of three real spherical harmonics */
-        gaunt_coefs_ = std::unique_ptr<Gaunt_coefficients<double>>(new Gaunt_coefficients<double>(lmax, 2 * lmax, lmax, SHT::gaunt_rlm));
+        gaunt_coefs_ = Gaunt_coefficients<double>::get(lmax, 2 * lmax, lmax, gaunt_t::rlm);
 
         /* split G-vectors between ranks */
         int gvec_count  = gvec__.count();
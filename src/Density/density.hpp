@@ -37,6 +37,12 @@ extern "C" void update_density_rg_1_gpu(int                   size__,
                                         double                wt__,
                                         double*               density_rg__);
 
+extern "C" void update_density_rg_1_pair_gpu(int                   size__,
+                                             double_complex const* psi_rg__,
+                                             double                wt1__,
+                                             double                wt2__,
+                                             double*               density_rg__);
+
 extern "C" void update_density_rg_2_gpu(int                   size__,
                                         double_complex const* psi_rg_up__,
                                         double_complex const* psi_rg_dn__,
@@ -146,6 +152,22 @@ class Density : public Field4D
 
     std::vector<paw_density_data_t> paw_density_data_;
 
+    /// Data of the PAW atom type, which is shared by the atoms of this type.
+    struct paw_type_data_t
+    {
+        /// Gaunt coefficients \f$ \langle Y_{\ell_1 m_1} | R_{\ell_3 m_3} | Y_{\ell_2 m_2} \rangle \f$.
+        std::shared_ptr<Gaunt_coefficients<double> const> gaunt_coefs_;
+
+        /// Products of all-electron radial functions divided by \f$ r^2 \f$ for the packed pairs of radial functions.
+        mdarray<double, 2> ae_prod_;
+
+        /// Products of pseudo radial functions plus the augmentation charge of each \f$ \ell_3 \f$ divided by \f$ r^2 \f$.
+        mdarray<double, 3> ps_prod_;
+    };
+
+    /// PAW data for each atom type (empty for non-PAW types).
+    std::vector<paw_type_data_t> paw_type_data_;
+
     /// Density and magnetization on the coarse FFT mesh.
     /** Coarse FFT grid is enough to generate density and magnetization from the wave-functions. The components
      *  of the <tt>rho_mag_coarse</tt> vector have the following order:
@@ -160,7 +182,7 @@ class Density : public Field4D
     std::unique_ptr<Smooth_periodic_function<double>> rho_pseudo_core_{nullptr};
 
     /// Non-zero Gaunt coefficients.
-    std::unique_ptr<Gaunt_coefficients<double_complex>> gaunt_coefs_{nullptr};
+    std::shared_ptr<Gaunt_coefficients<double_complex> const> gaunt_coefs_{nullptr};
 
     /// Fast mapping between composite lm index and corresponding orbital quantum number.
     std::vector<int> l_by_lm_;
@@ -318,8 +340,8 @@ class Density : public Field4D
         }
 
         if (ctx_.full_potential()) {
-            using gc_z   = Gaunt_coefficients<double_complex>;
-            gaunt_coefs_ = std::unique_ptr<gc_z>(new gc_z(ctx_.lmax_apw(), ctx_.lmax_rho(), ctx_.lmax_apw(), SHT::gaunt_hybrid));
+            gaunt_coefs_ = Gaunt_coefficients<double_complex>::get(ctx_.lmax_apw(), ctx_.lmax_rho(), ctx_.lmax_apw(),
+                                                                   gaunt_t::hybrid);
         }
 
         l_by_lm_ = utils::l_by_lm(ctx_.lmax_rho());
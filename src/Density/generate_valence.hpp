@@ -62,11 +62,10 @@ inline void Density::generate_valence(K_point_set const& ks__)
         rho_mag_coarse_[i]->zero();
     }
 
-    /* start the main loop over k-points */
-    for (int ikloc = 0; ikloc < ks__.spl_num_kpoints().local_size(); ikloc++) {
-        int ik = ks__.spl_num_kpoints(ikloc);
-        auto kp = ks__[ik];
-
+    /* start remapping wave-functions of a k-point; the all-to-all communication proceeds in the background */
+    auto remap_begin = [&](int ikloc)
+    {
+        auto kp = ks__[ks__.spl_num_kpoints(ikloc)];
         for (int ispn = 0; ispn < ctx_.num_spins(); ispn++) {
             int nbnd = kp->num_occupied_bands(ispn);
             if (is_device_memory(ctx_.preferred_memory_t())) {
@@ -75,7 +74,28 @@ inline void Density::generate_valence(K_point_set const& ks__)
                 kp->spinor_wave_functions().pw_coeffs(ispn).copy_to(memory_t::device, 0, nbnd); // TODO: copy this asynchronously
             }
             /* swap wave functions for the FFT transformation */
-            kp->spinor_wave_functions().pw_coeffs(ispn).remap_forward(nbnd, 0, &ctx_.mem_pool(memory_t::host));
+            kp->spinor_wave_functions().pw_coeffs(ispn).remap_forward_begin(nbnd, 0, &ctx_.mem_pool(memory_t::host));
+        }
+    };
+
+    int nkloc = static_cast<int>(ks__.spl_num_kpoints().local_size());
+
+    if (nkloc) {
+        remap_begin(0);
+    }
+
+    /* start the main loop over k-points */
+    for (int ikloc = 0; ikloc < nkloc; ikloc++) {
+        int ik = ks__.spl_num_kpoints(ikloc);
+        auto kp = ks__[ik];
+
+        for (int ispn = 0; ispn < ctx_.num_spins(); ispn++) {
+            kp->spinor_wave_functions().pw_coeffs(ispn).remap_forward_end();
+        }
+
+        /* remapping of the next k-point overlaps with the FFTs and density matrix of this k-point */
+        if (ikloc + 1 < nkloc) {
+            remap_begin(ikloc + 1);
         }
 
         if (ctx_.electronic_structure_method() == electronic_structure_method_t::full_potential_lapwlo) {
@@ -101,8 +121,10 @@ inline void Density::generate_valence(K_point_set const& ks__)
         }
     }
 
+    /* reduction of the density matrix overlaps with the reduction and transformation of the coarse density */
+    Request dm_req;
     if (density_matrix_.size()) {
-        ctx_.comm().allreduce(density_matrix_.at(memory_t::host), static_cast<int>(density_matrix_.size()));
+        dm_req = ctx_.comm().iallreduce(density_matrix_.at(memory_t::host), static_cast<int>(density_matrix_.size()));
     }
 
     ctx_.fft_coarse().prepare(ctx_.gvec_coarse_partition());
@@ -128,6 +150,8 @@ inline void Density::generate_valence(K_point_set const& ks__)
     }
     ctx_.fft_coarse().dismiss();
 
+    dm_req.wait();
+
     if (!ctx_.full_potential()) {
         augment();
 
@@ -211,11 +211,9 @@ inline void Density::initial_density_full_pot()
     }
 
     /* compute boundary value at MT sphere from the plane-wave exapansion */
-    auto gvec_ylm = ctx_.generate_gvec_ylm(lmax);
-
     auto sbessel_mt = ctx_.generate_sbessel_mt(lmax);
 
-    auto flm = ctx_.sum_fg_fl_yg(lmax, v.data(), sbessel_mt, gvec_ylm);
+    auto flm = ctx_.sum_fg_fl_yg(lmax, v.data(), sbessel_mt);
 
     /* this is the difference between the value of periodic charge density at MT boundary and
        a value of the atom's free density at the boundary */
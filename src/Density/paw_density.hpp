@@ -25,11 +25,53 @@
 inline void Density::init_paw()
 {
     paw_density_data_.clear();
+    paw_type_data_.clear();
 
     if (!unit_cell_.num_paw_atoms()) {
         return;
     }
 
+    paw_type_data_.resize(unit_cell_.num_atom_types());
+    for (int iat = 0; iat < unit_cell_.num_atom_types(); iat++) {
+        auto& atom_type = unit_cell_.atom_type(iat);
+        if (!atom_type.is_paw()) {
+            continue;
+        }
+        auto& ptd = paw_type_data_[iat];
+
+        int lmax = atom_type.indexr().lmax_lo();
+        ptd.gaunt_coefs_ = Gaunt_coefficients<double>::get(lmax, 2 * lmax, lmax, gaunt_t::rlm);
+
+        auto& grid = atom_type.radial_grid();
+        auto& paw_ae_wfs = atom_type.ae_paw_wfs_array();
+        auto& paw_ps_wfs = atom_type.ps_paw_wfs_array();
+
+        int nrb = atom_type.num_beta_radial_functions();
+        int nqij = nrb * (nrb + 1) / 2;
+
+        ptd.ae_prod_ = mdarray<double, 2>(nqij, grid.num_points());
+        ptd.ps_prod_ = mdarray<double, 3>(nqij, grid.num_points(), 2 * lmax + 1);
+
+        for (int irb2 = 0; irb2 < nrb; irb2++) {
+            for (int irb1 = 0; irb1 <= irb2; irb1++) {
+                int iqij = irb2 * (irb2 + 1) / 2 + irb1;
+                for (int l3 = 0; l3 <= 2 * lmax; l3++) {
+                    auto& qrf = atom_type.q_radial_function(irb1, irb2, l3);
+                    for (int irad = 0; irad < grid.num_points(); irad++) {
+                        /* wave functions are stored multiplied by r */
+                        double inv_r2 = 1.0 / (grid[irad] * grid[irad]);
+                        ptd.ps_prod_(iqij, irad, l3) = inv_r2 * (paw_ps_wfs(irad, irb1) * paw_ps_wfs(irad, irb2) +
+                                                                 qrf(irad));
+                    }
+                }
+                for (int irad = 0; irad < grid.num_points(); irad++) {
+                    double inv_r2 = 1.0 / (grid[irad] * grid[irad]);
+                    ptd.ae_prod_(iqij, irad) = inv_r2 * paw_ae_wfs(irad, irb1) * paw_ae_wfs(irad, irb2);
+                }
+            }
+        }
+    }
+
     for (int i = 0; i < unit_cell_.spl_num_paw_atoms().local_size(); i++) {
         int   ia_paw    = unit_cell_.spl_num_paw_atoms(i);
         int   ia        = unit_cell_.paw_atom_index(ia_paw);
@@ -104,25 +146,20 @@ inline void Density::generate_paw_atom_density(paw_density_data_t& pdd)
     int ia = pdd.ia;
 
     auto& atom_type = pdd.atom_->type();
+    auto& ptd = paw_type_data_[atom_type.id()];
+    auto& GC = *ptd.gaunt_coefs_;
 
-    auto l_by_lm = utils::l_by_lm(2 * atom_type.indexr().lmax_lo());
+    int lmax = 2 * atom_type.indexr().lmax_lo();
+    int lmmax = utils::lmmax(lmax);
+    int nqij = static_cast<int>(ptd.ae_prod_.size(0));
+    int nr = atom_type.radial_grid().num_points();
+    int nmag = ctx_.num_mag_dims() + 1;
 
-    /* get gaunt coefficients */
-    Gaunt_coefficients<double> GC(atom_type.indexr().lmax_lo(), 2 * atom_type.indexr().lmax_lo(),
-                                  atom_type.indexr().lmax_lo(), SHT::gaunt_rlm);
+    /* contract the density matrix with Gaunt coefficients:
+     *   C_{lm3, ij} = sum_{xi1 <= xi2 (ij)} D_{xi1 xi2} <Y_lm1|R_lm3|Y_lm2> */
+    mdarray<double, 3> coefs(lmmax, nqij, nmag);
+    coefs.zero();
 
-    for (int i = 0; i < ctx_.num_mag_dims() + 1; i++) {
-        pdd.ae_density_[i].zero();
-        pdd.ps_density_[i].zero();
-    }
-
-    /* get radial grid to divide density over r^2 */
-    auto& grid = atom_type.radial_grid();
-
-    auto& paw_ae_wfs = atom_type.ae_paw_wfs_array();
-    auto& paw_ps_wfs = atom_type.ps_paw_wfs_array();
-
-    /* iterate over local basis functions (or over lm1 and lm2) */
     for (int xi2 = 0; xi2 < atom_type.indexb().size(); xi2++) {
         int lm2  = atom_type.indexb(xi2).lm;
         int irb2 = atom_type.indexb(xi2).idxrf;
@@ -131,8 +168,7 @@ inline void Density::generate_paw_atom_density(paw_density_data_t& pdd)
             int lm1  = atom_type.indexb(xi1).lm;
             int irb1 = atom_type.indexb(xi1).idxrf;
 
-            /* get num of non-zero GC */
-            int num_non_zero_gk = GC.num_gaunt(lm1, lm2);
+            int iqij = std::max(irb1, irb2) * (std::max(irb1, irb2) + 1) / 2 + std::min(irb1, irb2);
 
             double diag_coef = (xi1 == xi2) ? 1.0 : 2.0;
 
@@ -153,30 +189,34 @@ inline void Density::generate_paw_atom_density(paw_density_data_t& pdd)
                 }
             }
 
-            for (int imagn = 0; imagn < ctx_.num_mag_dims() + 1; imagn++) {
-                auto& ae_dens = pdd.ae_density_[imagn];
-                auto& ps_dens = pdd.ps_density_[imagn];
-
-                /* add nonzero coefficients */
-                for (int inz = 0; inz < num_non_zero_gk; inz++) {
-                    auto& lm3coef = GC.gaunt(lm1, lm2, inz);
-
-                    /* iterate over radial points */
-                    for (int irad = 0; irad < grid.num_points(); irad++) {
-
-                        /* we need to divide density over r^2 since wave functions are stored multiplied by r */
-                        double inv_r2 = diag_coef / (grid[irad] * grid[irad]);
-
-                        /* calculate unified density/magnetization
-                         * dm_ij * GauntCoef * ( phi_i phi_j  +  Q_ij) */
-                        ae_dens(lm3coef.lm3, irad) += dm[imagn] * inv_r2 * lm3coef.coef * paw_ae_wfs(irad, irb1) * paw_ae_wfs(irad, irb2);
-                        ps_dens(lm3coef.lm3, irad) += dm[imagn] * inv_r2 * lm3coef.coef *
-                                                      (paw_ps_wfs(irad, irb1) * paw_ps_wfs(irad, irb2) + atom_type.q_radial_function(irb1, irb2, l_by_lm[lm3coef.lm3])(irad));
-                    }
+            for (int inz = 0; inz < GC.num_gaunt(lm1, lm2); inz++) {
+                auto& lm3coef = GC.gaunt(lm1, lm2, inz);
+                for (int imagn = 0; imagn < nmag; imagn++) {
+                    coefs(lm3coef.lm3, iqij, imagn) += diag_coef * dm[imagn] * lm3coef.coef;
                 }
             }
         }
     }
+
+    /* multiply by the radial products; pseudo part depends on l3 through the augmentation charge */
+    for (int imagn = 0; imagn < nmag; imagn++) {
+        auto& ae_dens = pdd.ae_density_[imagn];
+        auto& ps_dens = pdd.ps_density_[imagn];
+
+        linalg2(linalg_t::blas).gemm('N', 'N', lmmax, nr, nqij, &linalg_const<double>::one(),
+                                     coefs.at(memory_t::host, 0, 0, imagn), coefs.ld(),
+                                     ptd.ae_prod_.at(memory_t::host), ptd.ae_prod_.ld(),
+                                     &linalg_const<double>::zero(), ae_dens.at(memory_t::host), ae_dens.ld());
+
+        for (int l3 = 0; l3 <= lmax; l3++) {
+            int lm0 = utils::lm(l3, -l3);
+            linalg2(linalg_t::blas).gemm('N', 'N', 2 * l3 + 1, nr, nqij, &linalg_const<double>::one(),
+                                         coefs.at(memory_t::host, lm0, 0, imagn), coefs.ld(),
+                                         ptd.ps_prod_.at(memory_t::host, 0, 0, l3), ptd.ps_prod_.ld(),
+                                         &linalg_const<double>::zero(), ps_dens.at(memory_t::host, lm0, 0),
+                                         ps_dens.ld());
+        }
+    }
 }
 
 inline void Density::generate_paw_loc_density()
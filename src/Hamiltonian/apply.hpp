@@ -56,11 +56,18 @@ void Hamiltonian::apply_h_s(K_point* kp__,
         }
     }
 
+    /* in the real-space mode the non-local part of Hamiltonian is applied together with the local part */
+    Beta_projectors_real_space* beta_rs{nullptr};
+    if (beta_rs_ && hphi__ != nullptr) {
+        beta_rs_->prepare(kp__->vk());
+        beta_rs = beta_rs_.get();
+    }
+
     double t1 = -omp_get_wtime();
 
     if (hphi__ != nullptr) {
         /* apply local part of Hamiltonian */
-        local_op_->apply_h(ispn__, phi__, *hphi__, N__, n__);
+        local_op_->apply_h(ispn__, phi__, *hphi__, N__, n__, beta_rs);
     }
 
     t1 += omp_get_wtime();
@@ -96,7 +103,8 @@ void Hamiltonian::apply_h_s(K_point* kp__,
         return;
     }
 
-    for (int i = 0; i < kp__->beta_projectors().num_chunks(); i++) {
+    /* D operator is already applied in real space and there is no augmentation (Q operator is zero) */
+    for (int i = 0; i < kp__->beta_projectors().num_chunks() && !beta_rs; i++) {
         /* generate beta-projectors for a block of atoms */
         kp__->beta_projectors().generate(i);
         /* non-collinear case */
@@ -151,21 +159,13 @@ void Hamiltonian::apply_h_s(K_point* kp__,
     /* apply the hubbard potential if relevant */
     if (ctx_.hubbard_correction() && !ctx_.gamma_point() && (hphi__ != NULL)) {
 
-       // copy the hubbard wave functions on GPU (if needed) and
-       // return afterwards, or if they are not already calculated
-       // compute the wave functions and copy them on GPU (if needed)
+        // the hubbard wave functions are computed once per k-point and kept
+        // (on GPU until K_point::dismiss_hubbard_wave_functions() is called);
+        // this call is a no-op if they are already available
 
         this->U().generate_atomic_orbitals(*kp__, Q<T>());
 
-        // Apply the hubbard potential and deallocate the hubbard wave
-        // functions on GPU (if needed)
         this->U().apply_hubbard_potential(*kp__, ispn__, N__, n__, phi__, *hphi__);
-
-        if (ctx_.processing_unit() == device_t::GPU) {
-            for (int ispn = 0; ispn < ctx_.num_spins(); ispn++) {
-                kp__->hubbard_wave_functions().deallocate(spin_idx(ispn), memory_t::device);
-            }
-        }
     }
 
     if ((ctx_.control().print_checksum_) && (hphi__ != nullptr) && (sphi__ != nullptr)) {
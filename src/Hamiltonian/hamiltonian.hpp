@@ -55,7 +55,7 @@ class Hamiltonian
     std::unique_ptr<Local_operator> local_op_;
 
     /// Non-zero Gaunt coefficients
-    std::unique_ptr<Gaunt_coefficients<double_complex>> gaunt_coefs_;
+    std::shared_ptr<Gaunt_coefficients<double_complex> const> gaunt_coefs_;
 
     /// D operator (non-local part of Hamiltonian).
     void* d_op_{nullptr};
@@ -63,6 +63,9 @@ class Hamiltonian
     /// Q operator (non-local part of S-operator).
     void* q_op_{nullptr};
 
+    /// Beta-projectors on the real-space grid (used instead of D operator if control::beta_real_space is set).
+    std::unique_ptr<Beta_projectors_real_space> beta_rs_;
+
   public:
     /// Constructor.
     Hamiltonian(Simulation_context& ctx__, Potential& potential__)
@@ -70,15 +73,23 @@ class Hamiltonian
         , unit_cell_(ctx__.unit_cell())
         , potential_(potential__)
     {
-        using gc_z = Gaunt_coefficients<double_complex>;
-
-        gaunt_coefs_ = std::unique_ptr<gc_z>(new gc_z(ctx_.lmax_apw(), ctx_.lmax_pot(), ctx_.lmax_apw(), SHT::gaunt_hybrid));
+        gaunt_coefs_ = Gaunt_coefficients<double_complex>::get(ctx_.lmax_apw(), ctx_.lmax_pot(), ctx_.lmax_apw(),
+                                                               gaunt_t::hybrid);
 
         local_op_ = std::unique_ptr<Local_operator>(new Local_operator(ctx_, ctx_.fft_coarse(), ctx_.gvec_coarse_partition()));
 
         if (ctx_.hubbard_correction()) {
             U_ = std::unique_ptr<Hubbard>(new Hubbard(ctx_));
         }
+
+        if (ctx_.control().beta_real_space_) {
+            if (Beta_projectors_real_space::is_applicable(ctx_)) {
+                beta_rs_ = std::unique_ptr<Beta_projectors_real_space>(new Beta_projectors_real_space(ctx_));
+            } else {
+                WARNING("real-space beta-projectors are not supported for this calculation; "
+                        "non-local operator is applied in reciprocal space");
+            }
+        }
     }
 
     Hubbard& U() const
@@ -117,6 +128,9 @@ class Hamiltonian
                 d_op_ = static_cast<void*>(new D_operator<double_complex>(ctx_));
                 q_op_ = static_cast<void*>(new Q_operator<double_complex>(ctx_));
             }
+            if (beta_rs_) {
+                beta_rs_->prepare();
+            }
         }
         local_op().prepare(potential_);
     }
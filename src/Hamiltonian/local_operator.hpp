@@ -26,6 +26,7 @@
 #define __LOCAL_OPERATOR_HPP__
 
 #include "Potential/potential.hpp"
+#include "Beta_projectors/beta_projectors_real_space.hpp"
 #include "../SDDK/GPU/acc.hpp"
 
 #ifdef __GPU
@@ -291,6 +292,7 @@ class Local_operator
      *  \param [out] hphi Hamiltonian applied to wave-function.
      *  \param [in]  idx0 Starting index of wave-functions.
      *  \param [in]  n    Number of wave-functions to which H is applied.
+     *  \param [in]  beta_rs Optional real-space beta-projectors for the non-local part of Hamiltonian.
      *
      *  Index of spin can take the following values:
      *    - 0: apply H_{uu} to the up- component of wave-functions
@@ -298,8 +300,12 @@ class Local_operator
      *    - 2: apply full Hamiltonian to the spinor wave-functions
      *
      *  In the current implementation for the GPUs sequential FFT is assumed.
+     *
+     *  If real-space beta-projectors are provided, the non-local operator is applied to the wave-functions in
+     *  the FFT buffer between the backward and forward transformations.
      */
-    void apply_h(int ispn__, Wave_functions& phi__, Wave_functions& hphi__, int idx0__, int n__)
+    void apply_h(int ispn__, Wave_functions& phi__, Wave_functions& hphi__, int idx0__, int n__,
+                 Beta_projectors_real_space* beta_rs__ = nullptr)
     {
         PROFILE("sirius::Local_operator::apply_h");
 
@@ -307,6 +313,10 @@ class Local_operator
             TERMINATE("Local operator is not prepared");
         }
 
+        if (beta_rs__ && (ispn__ == 2 || fft_coarse_.pu() == device_t::GPU)) {
+            TERMINATE("real-space beta-projectors are not supported in this case");
+        }
+
         /* increment the counter by the number of wave-functions */
         num_applied(n__);
 
@@ -646,8 +656,16 @@ class Local_operator
                 prepare_phi_hphi(i, true);
                 /* phi(G) -> phi(r) */
                 phi_to_r(ispn__, true);
+                /* compute D<beta|phi> in real space */
+                if (beta_rs__) {
+                    beta_rs__->project(ispn__, fft_coarse_.buffer());
+                }
                 /* multiply by effective potential */
                 mul_by_veff(fft_coarse_.buffer(), ispn__);
+                /* add beta D <beta|phi> */
+                if (beta_rs__) {
+                    beta_rs__->add(fft_coarse_.buffer());
+                }
                 /* V(r)phi(r) -> [V*phi](G) */
                 vphi_to_G(true);
                 /* add kinetic energy */
@@ -775,8 +793,16 @@ class Local_operator
                 prepare_phi_hphi(i);
                 /* phi(G) -> phi(r) */
                 phi_to_r(ispn__);
+                /* compute D<beta|phi> in real space */
+                if (beta_rs__) {
+                    beta_rs__->project(ispn__, fft_coarse_.buffer());
+                }
                 /* multiply by effective potential */
                 mul_by_veff(fft_coarse_.buffer(), ispn__);
+                /* add beta D <beta|phi> */
+                if (beta_rs__) {
+                    beta_rs__->add(fft_coarse_.buffer());
+                }
                 /* V(r)phi(r) -> [V*phi](G) */
                 vphi_to_G();
                 /* add kinetic energy */
@@ -29,6 +29,66 @@
 
 namespace sirius {
 
+/// Apply a block-diagonal matrix to a set of vectors.
+/** For each atom a of a group the following is computed:
+ *  \f[
+ *      C_{o_a + \xi, j} = \sum_{\xi'} A^{a}_{\xi \xi'} B_{o_a + \xi', j}
+ *  \f]
+ *  where \f$ o_a \f$ is the row offset of the atom. All atoms of the group have the same number of
+ *  projectors, so all (atom, column) pairs are processed in a single parallel loop instead of one small GEMM
+ *  per atom.
+ */
+template <typename T>
+inline void block_diag_gemm(int nbf__, int n__, std::vector<T const*> const& a__, std::vector<int> const& offs__,
+                            T const* b__, int ldb__, T* c__, int ldc__)
+{
+    int na = static_cast<int>(a__.size());
+    #pragma omp parallel for schedule(static)
+    for (int k = 0; k < na * n__; k++) {
+        int i    = k % na;
+        int j    = k / na;
+        auto A   = a__[i];
+        auto B   = b__ + offs__[i] + j * ldb__;
+        auto C   = c__ + offs__[i] + j * ldc__;
+        for (int xi1 = 0; xi1 < nbf__; xi1++) {
+            C[xi1] = 0;
+        }
+        for (int xi2 = 0; xi2 < nbf__; xi2++) {
+            auto b = B[xi2];
+            for (int xi1 = 0; xi1 < nbf__; xi1++) {
+                C[xi1] += A[xi2 * nbf__ + xi1] * b;
+            }
+        }
+    }
+}
+
+/// Apply the same matrix to the blocks of vectors of several atoms.
+/** The blocks are packed into a single \f$ N_{\beta} \times (n N_{a}) \f$ matrix and multiplied by one GEMM. */
+template <typename T>
+inline void shared_block_gemm(int nbf__, int n__, T const* a__, std::vector<int> const& offs__, T const* b__,
+                              int ldb__, T* c__, int ldc__)
+{
+    int na = static_cast<int>(offs__.size());
+
+    mdarray<T, 2> b(nbf__, na * n__);
+    mdarray<T, 2> c(nbf__, na * n__);
+
+    #pragma omp parallel for schedule(static)
+    for (int k = 0; k < na * n__; k++) {
+        int i = k % na;
+        int j = k / na;
+        std::copy(b__ + offs__[i] + j * ldb__, b__ + offs__[i] + j * ldb__ + nbf__, &b(0, k));
+    }
+    linalg2(linalg_t::blas).gemm('N', 'N', nbf__, na * n__, nbf__, &linalg_const<T>::one(), a__, nbf__,
+                                 b.at(memory_t::host), nbf__, &linalg_const<T>::zero(), c.at(memory_t::host), nbf__);
+    #pragma omp parallel for schedule(static)
+    for (int k = 0; k < na * n__; k++) {
+        int i = k % na;
+        int j = k / na;
+        std::copy(&c(0, k), &c(0, k) + nbf__, c__ + offs__[i] + j * ldc__);
+    }
+}
+
 /// Non-local part of the Hamiltonian and S-operator in the pseudopotential method.
 template <typename T>
 class Non_local_operator
@@ -49,6 +109,79 @@ class Non_local_operator
 
     bool is_null_{false};
 
+    /// True if all atoms of a given type have the same operator matrix for a given spin block.
+    mdarray<int, 2> type_shared_;
+
+    /// Find the atom types for which all atoms share the same operator matrix.
+    /** This must be called by the derived classes after op_ is initialized. */
+    void find_shared_types()
+    {
+        auto& uc     = ctx_.unit_cell();
+        type_shared_ = mdarray<int, 2>(uc.num_atom_types(), op_.size(1));
+        for (int iat = 0; iat < uc.num_atom_types(); iat++) {
+            auto& type = uc.atom_type(iat);
+            int nbf    = type.mt_basis_size();
+            for (int s = 0; s < static_cast<int>(op_.size(1)); s++) {
+                int shared{1};
+                for (int i = 1; i < type.num_atoms() && shared; i++) {
+                    int ia0 = type.atom_id(0);
+                    int ia  = type.atom_id(i);
+                    for (int k = 0; k < nbf * nbf; k++) {
+                        if (op_(packed_mtrx_offset_(ia) + k, s) != op_(packed_mtrx_offset_(ia0) + k, s)) {
+                            shared = 0;
+                            break;
+                        }
+                    }
+                }
+                type_shared_(iat, s) = shared;
+            }
+        }
+    }
+
+    /// Compute op * <beta|phi> for the atoms of a chunk on the CPU.
+    /** Atoms of a chunk are grouped by type. If all atoms of a type share the same operator matrix, the
+     *  projections are multiplied by a single GEMM; otherwise a block-diagonal kernel is used. The result is
+     *  stored in work_ with the leading dimension equal to the number of beta-projectors in the chunk. */
+    void apply_to_beta_phi_cpu(int chunk__, int ispn_block__, int n__, Beta_projectors_base& beta__,
+                               matrix<T>& beta_phi__)
+    {
+        PROFILE("sirius::Non_local_operator::apply_to_beta_phi_cpu");
+
+        auto& uc    = ctx_.unit_cell();
+        auto& ch    = beta__.chunk(chunk__);
+        int nbeta   = ch.num_beta_;
+
+        /* group atoms of the chunk by type */
+        std::vector<std::vector<int>> atoms_by_type(uc.num_atom_types());
+        for (int i = 0; i < ch.num_atoms_; i++) {
+            if (ch.desc_(beta_desc_idx::nbf, i)) {
+                atoms_by_type[uc.atom(ch.desc_(beta_desc_idx::ia, i)).type_id()].push_back(i);
+            }
+        }
+
+        for (int iat = 0; iat < uc.num_atom_types(); iat++) {
+            auto& atoms = atoms_by_type[iat];
+            if (atoms.empty()) {
+                continue;
+            }
+            int nbf = uc.atom_type(iat).mt_basis_size();
+
+            std::vector<int> offs;
+            std::vector<T const*> a;
+            for (int i: atoms) {
+                offs.push_back(ch.desc_(beta_desc_idx::offset, i));
+                a.push_back(op_.at(memory_t::host, packed_mtrx_offset_(ch.desc_(beta_desc_idx::ia, i)), ispn_block__));
+            }
+            if (type_shared_(iat, ispn_block__) && atoms.size() > 1) {
+                shared_block_gemm<T>(nbf, n__, a[0], offs, beta_phi__.at(memory_t::host), nbeta,
+                                     work_.at(memory_t::host), nbeta);
+            } else {
+                block_diag_gemm<T>(nbf, n__, a, offs, beta_phi__.at(memory_t::host), nbeta,
+                                   work_.at(memory_t::host), nbeta);
+            }
+        }
+    }
+
     /* copy assigment operrator is forbidden */
     Non_local_operator& operator=(Non_local_operator const& src) = delete;
     /* copy constructor is forbidden */
@@ -144,28 +277,29 @@ inline void Non_local_operator<double_complex>::apply(int chunk__, int ispn_bloc
     }
 
     /* compute O * <beta|phi> for atoms in a chunk */
-    #pragma omp parallel for
-    for (int i = 0; i < beta__.chunk(chunk__).num_atoms_; i++) {
-        /* number of beta functions for a given atom */
-        int nbf  = beta__.chunk(chunk__).desc_(beta_desc_idx::nbf, i);
-        int offs = beta__.chunk(chunk__).desc_(beta_desc_idx::offset, i);
-        int ia   = beta__.chunk(chunk__).desc_(beta_desc_idx::ia, i);
-
-        if (nbf) {
-            linalg2(la).gemm('N', 'N', nbf, n__, nbf, &linalg_const<double_complex>::one(),
-                             op_.at(mem, packed_mtrx_offset_(ia), ispn_block__), nbf, beta_phi__.at(mem, offs, 0), nbeta,
-                             &linalg_const<double_complex>::zero(), work_.at(mem, offs), nbeta,
-                             stream_id(omp_get_thread_num()));
-        }
-    }
     switch (pu_) {
         case device_t::GPU: {
+            #pragma omp parallel for
+            for (int i = 0; i < beta__.chunk(chunk__).num_atoms_; i++) {
+                /* number of beta functions for a given atom */
+                int nbf  = beta__.chunk(chunk__).desc_(beta_desc_idx::nbf, i);
+                int offs = beta__.chunk(chunk__).desc_(beta_desc_idx::offset, i);
+                int ia   = beta__.chunk(chunk__).desc_(beta_desc_idx::ia, i);
+
+                if (nbf) {
+                    linalg2(la).gemm('N', 'N', nbf, n__, nbf, &linalg_const<double_complex>::one(),
+                                     op_.at(mem, packed_mtrx_offset_(ia), ispn_block__), nbf, beta_phi__.at(mem, offs, 0), nbeta,
+                                     &linalg_const<double_complex>::zero(), work_.at(mem, offs), nbeta,
+                                     stream_id(omp_get_thread_num()));
+                }
+            }
             /* wait for previous zgemms */
             #pragma omp parallel
             acc::sync_stream(stream_id(omp_get_thread_num()));
             break;
         }
         case device_t::CPU: {
+            apply_to_beta_phi_cpu(chunk__, ispn_block__, n__, beta__, beta_phi__);
             break;
         }
     }
@@ -301,32 +435,33 @@ inline void Non_local_operator<double>::apply(int chunk__, int ispn_block__, Wav
     }
 
     /* compute O * <beta|phi> for atoms in a chunk */
-    #pragma omp parallel for
-    for (int i = 0; i < beta__.chunk(chunk__).num_atoms_; i++) {
-        /* number of beta functions for a given atom */
-        int nbf  = beta__.chunk(chunk__).desc_(beta_desc_idx::nbf, i);
-        int offs = beta__.chunk(chunk__).desc_(beta_desc_idx::offset, i);
-        int ia   = beta__.chunk(chunk__).desc_(beta_desc_idx::ia, i);
-
-        if (nbf == 0) {
-            continue;
-        }
-        linalg2(la).gemm('N', 'N', nbf, n__, nbf,
-                         &linalg_const<double>::one(),
-                         op_.at(mem, packed_mtrx_offset_(ia), ispn_block__), nbf,
-                         beta_phi__.at(mem, offs, 0), nbeta,
-                         &linalg_const<double>::zero(),
-                         work_.at(mem, offs), nbeta,
-                         stream_id(omp_get_thread_num()));
-    }
     switch (pu_) {
         case device_t::GPU: {
-            /* wait for previous zgemms */
+            #pragma omp parallel for
+            for (int i = 0; i < beta__.chunk(chunk__).num_atoms_; i++) {
+                /* number of beta functions for a given atom */
+                int nbf  = beta__.chunk(chunk__).desc_(beta_desc_idx::nbf, i);
+                int offs = beta__.chunk(chunk__).desc_(beta_desc_idx::offset, i);
+                int ia   = beta__.chunk(chunk__).desc_(beta_desc_idx::ia, i);
+
+                if (nbf == 0) {
+                    continue;
+                }
+                linalg2(la).gemm('N', 'N', nbf, n__, nbf,
+                                 &linalg_const<double>::one(),
+                                 op_.at(mem, packed_mtrx_offset_(ia), ispn_block__), nbf,
+                                 beta_phi__.at(mem, offs, 0), nbeta,
+                                 &linalg_const<double>::zero(),
+                                 work_.at(mem, offs), nbeta,
+                                 stream_id(omp_get_thread_num()));
+            }
+            /* wait for previous dgemms */
             #pragma omp parallel
             acc::sync_stream(stream_id(omp_get_thread_num()));
             break;
         }
         case device_t::CPU: {
+            apply_to_beta_phi_cpu(chunk__, ispn_block__, n__, beta__, beta_phi__);
             break;
         }
     }
@@ -446,6 +581,7 @@ class D_operator : public Non_local_operator<T>
             assert((std::is_same<T, double_complex>::value));
         }
         initialize();
+        this->find_shared_types();
     }
 };
 
@@ -529,6 +665,7 @@ class Q_operator : public Non_local_operator<T>
         this->op_ = mdarray<T, 2>(this->packed_mtrx_size_, ctx_.num_mag_dims() + 1);
         this->op_.zero();
         initialize();
+        this->find_shared_types();
     }
 };
 
@@ -560,6 +697,7 @@ class P_operator : public Non_local_operator<T>
             this->op_.allocate(memory_t::device);
             this->op_.copy_to(memory_t::device);
         }
+        this->find_shared_types();
     }
 };
 
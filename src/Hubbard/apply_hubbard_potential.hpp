@@ -66,6 +66,10 @@ void Hubbard::apply_hubbard_potential(K_point&        kp__,
     dmatrix<double_complex> Up(this->number_of_hubbard_orbitals(), n__);
     Up.zero();
 
+    /* U is block-diagonal in the atom index: apply it as a small GEMM per atom (and per spin block)
+       Up(m1, n) += \sum_{m2} U(m2, m1) dm(m2, n) */
+    const int ld = static_cast<int>(hubbard_potential_.size(0));
+
     #pragma omp parallel for schedule(static)
     for (int ia = 0; ia < ctx_.unit_cell().num_atoms(); ++ia) {
         const auto& atom = ctx_.unit_cell().atom(ia);
@@ -79,28 +83,22 @@ void Hubbard::apply_hubbard_potential(K_point&        kp__,
                     for (int s2 = 0; s2 < ctx_.num_spins(); s2++) {
                         const int ind = (s1 == s2) * s1 + (1 + 2 * s2 + s1) * (s1 != s2);
 
-                        // !!! Replace this with matrix matrix multiplication
-
-                        for (int nbd = 0; nbd < n__; nbd++) {
-                            for (int m1 = 0; m1 < lmax_at; m1++) {
-                                for (int m2 = 0; m2 < lmax_at; m2++) {
-                                    Up(this->offset[ia] + s1 * lmax_at + m1, nbd) += this->hubbard_potential_(m2, m1, ind, ia, 0) *
-                                        dm(this->offset[ia] + s2 * lmax_at + m2, nbd);
-                                }
-                            }
-                        }
+                        linalg2(linalg_t::blas).gemm('T', 'N', lmax_at, n__, lmax_at,
+                            &linalg_const<double_complex>::one(),
+                            hubbard_potential_.at(memory_t::host, 0, 0, ind, ia, 0), ld,
+                            dm.at(memory_t::host, this->offset[ia] + s2 * lmax_at, 0), dm.ld(),
+                            &linalg_const<double_complex>::one(),
+                            Up.at(memory_t::host, this->offset[ia] + s1 * lmax_at, 0), Up.ld());
                     }
                 }
             } else {
                 // Conventional LDA or colinear magnetism
-                for (int nbd = 0; nbd < n__; nbd++) {
-                    for (int m1 = 0; m1 < lmax_at; m1++) {
-                        for (int m2 = 0; m2 < lmax_at; m2++) {
-                            Up(this->offset[ia] + m1, nbd) += this->hubbard_potential_(m2, m1, ispn__, ia, 0) *
-                                dm(this->offset[ia] + m2, nbd);
-                        }
-                    }
-                }
+                linalg2(linalg_t::blas).gemm('T', 'N', lmax_at, n__, lmax_at,
+                    &linalg_const<double_complex>::one(),
+                    hubbard_potential_.at(memory_t::host, 0, 0, ispn__, ia, 0), ld,
+                    dm.at(memory_t::host, this->offset[ia], 0), dm.ld(),
+                    &linalg_const<double_complex>::zero(),
+                    Up.at(memory_t::host, this->offset[ia], 0), Up.ld());
             }
         }
     }
@@ -35,14 +35,16 @@ void Hubbard::generate_atomic_orbitals(K_point& kp, Q_operator<double_complex>&
     // return immediately if the wave functions are already allocated
     if (kp.hubbard_wave_functions_calculated()) {
 
-        // the hubbard orbitals are already calculated but are stored on the
+        // the hubbard orbitals are already calculated and stored on the
         // CPU memory.  when the GPU is used, we need to do an explicit copy
-        // of them after allocation if not already allocated
+        // of them, unless they are still on the device from a previous call
         if (ctx_.processing_unit() == device_t::GPU) {
             for (int ispn = 0; ispn < num_sc; ispn++) {
-                /* allocate GPU memory */
-                kp.hubbard_wave_functions().pw_coeffs(ispn).prime().allocate(memory_t::device);
-                kp.hubbard_wave_functions().pw_coeffs(ispn).copy_to(memory_t::device, 0, this->number_of_hubbard_orbitals());
+                if (!kp.hubbard_wave_functions().pw_coeffs(ispn).prime().on_device()) {
+                    /* allocate GPU memory */
+                    kp.hubbard_wave_functions().pw_coeffs(ispn).prime().allocate(memory_t::device);
+                    kp.hubbard_wave_functions().pw_coeffs(ispn).copy_to(memory_t::device, 0, this->number_of_hubbard_orbitals());
+                }
             }
         }
         return;
@@ -103,7 +105,8 @@ void Hubbard::generate_atomic_orbitals(K_point& kp, Q_operator<double_complex>&
     if (ctx_.processing_unit() == device_t::GPU) {
         for (int ispn = 0; ispn < num_sc; ispn++) {
             sphi.pw_coeffs(ispn).prime().deallocate(memory_t::device);
-            // copy the hubbard wave functions on the host and then deallocate on GPU
+            // copy the hubbard wave functions on the host; the device copy is kept until the band solver
+            // of this k-point is done (see K_point::dismiss_hubbard_wave_functions())
             kp.hubbard_wave_functions().pw_coeffs(ispn).copy_to(memory_t::host, 0, this->number_of_hubbard_orbitals());
         }
     }
@@ -46,33 +46,78 @@ inline void K_point::generate_atomic_wave_functions_aux(const int         num_ao
         phi.pw_coeffs(ispn).prime().zero();
     }
 
+    int ngk = this->num_gkvec_loc();
+
+    /* spherical harmonics and lengths of the local G+k vectors */
+    mdarray<double, 2> rlm_gk(utils::lmmax(lmax), ngk);
+    std::vector<double> gk_len(ngk);
     #pragma omp parallel for schedule(static)
-    for (int igk_loc = 0; igk_loc < this->num_gkvec_loc(); igk_loc++) {
-        /* global index of G+k vector */
-        int igk = this->idxgk(igk_loc);
+    for (int igk_loc = 0; igk_loc < ngk; igk_loc++) {
         /* vs = {r, theta, phi} */
         auto vs = SHT::spherical_coordinates(this->gkvec().gkvec_cart<index_domain_t::local>(igk_loc));
-        /* compute real spherical harmonics for G+k vector */
-        std::vector<double> rlm(utils::lmmax(lmax));
-        SHT::spherical_harmonics(lmax, vs[1], vs[2], &rlm[0]);
-        /* get values of radial integrals for a given G+k vector length */
-        std::vector<mdarray<double, 1>> ri_values(unit_cell_.num_atom_types());
+        gk_len[igk_loc] = vs[0];
+        SHT::spherical_harmonics(lmax, vs[1], vs[2], &rlm_gk(0, igk_loc));
+    }
+
+    /* group G+k vectors into shells of equal length; radial integrals are interpolated once per shell */
+    std::vector<int> idx(ngk);
+    for (int igk_loc = 0; igk_loc < ngk; igk_loc++) {
+        idx[igk_loc] = igk_loc;
+    }
+    std::sort(idx.begin(), idx.end(), [&gk_len](int i1, int i2) { return gk_len[i1] < gk_len[i2]; });
+
+    std::vector<int> gk_shell(ngk);
+    std::vector<double> shell_len;
+    for (int i = 0; i < ngk; i++) {
+        if (i == 0 || gk_len[idx[i]] - shell_len.back() > 1e-10) {
+            shell_len.push_back(gk_len[idx[i]]);
+        }
+        gk_shell[idx[i]] = static_cast<int>(shell_len.size()) - 1;
+    }
+    int num_shells = static_cast<int>(shell_len.size());
+
+    /* radial integrals of atom types for each shell */
+    std::vector<mdarray<double, 2>> ri_values(unit_cell_.num_atom_types());
+    for (int iat = 0; iat < unit_cell_.num_atom_types(); iat++) {
+        ri_values[iat] = mdarray<double, 2>(unit_cell_.atom_type(iat).num_ps_atomic_wf(), num_shells);
+    }
+    #pragma omp parallel for schedule(static)
+    for (int ish = 0; ish < num_shells; ish++) {
         for (int iat = 0; iat < unit_cell_.num_atom_types(); iat++) {
-            ri_values[iat] = ctx_.atomic_wf_ri().values(iat, vs[0]);
+            auto ri = ctx_.atomic_wf_ri().values(iat, shell_len[ish]);
+            for (int i = 0; i < unit_cell_.atom_type(iat).num_ps_atomic_wf(); i++) {
+                ri_values[iat](i, ish) = ri(i);
+            }
         }
+    }
+
+    /* (-i)^l * 4pi / sqrt(Omega) */
+    std::vector<double_complex> zil(lmax + 1);
+    for (int l = 0; l <= lmax; l++) {
+        zil[l] = std::pow(double_complex(0, -1), l) * fourpi / std::sqrt(unit_cell_.omega());
+    }
+
+    #pragma omp parallel for schedule(static)
+    for (int igk_loc = 0; igk_loc < ngk; igk_loc++) {
+        /* global index of G+k vector */
+        int igk = this->idxgk(igk_loc);
+        /* spherical harmonics of this G+k vector */
+        double const* rlm = &rlm_gk(0, igk_loc);
+        int ish = gk_shell[igk_loc];
 
         int n{0};
         for (int ia = 0; ia < unit_cell_.num_atoms(); ia++) {
             auto phase        = twopi * dot(gkvec().gkvec(igk), unit_cell_.atom(ia).position());
-            auto phase_factor = std::exp(double_complex(0.0, phase));
+            auto phase_factor = std::exp(double_complex(0.0, -phase));
             auto& atom_type   = unit_cell_.atom(ia).type();
+            auto& ri          = ri_values[atom_type.id()];
             if (!hubbard) {
                 for (int i = 0; i < atom_type.num_ps_atomic_wf(); i++) {
                     auto l = std::abs(atom_type.ps_atomic_wf(i).first);
-                    auto z = std::pow(double_complex(0, -1), l) * fourpi / std::sqrt(unit_cell_.omega());
+                    auto z = zil[l] * phase_factor * ri(i, ish);
                     for (int m = -l; m <= l; m++) {
                         int lm = utils::lm(l, m);
-                        phi.pw_coeffs(0).prime(igk_loc, n) = z * std::conj(phase_factor) * rlm[lm] * ri_values[atom_type.id()][i];
+                        phi.pw_coeffs(0).prime(igk_loc, n) = z * rlm[lm];
                         n++;
                     }
                 } // i
@@ -83,11 +128,11 @@ inline void K_point::generate_atomic_wave_functions_aux(const int         num_ao
                         for (int i = 0; i < 2; i++) {
                             auto &orb = atom_type.hubbard_orbital(i);
                             const int l = std::abs(orb.l());
-                            auto z = std::pow(double_complex(0, -1), l) * fourpi / std::sqrt(unit_cell_.omega());
+                            auto z = 0.5 * zil[l] * phase_factor * ri(orb.rindex(), ish);
                             for (int m = -l; m <= l; m++) {
                                 int lm = utils::lm(l, m);
-                                phi.pw_coeffs(0).prime(igk_loc, offset[ia] + l + m) += 0.5 * z * std::conj(phase_factor) * rlm[lm] * ri_values[atom_type.id()][orb.rindex()];
-                                phi.pw_coeffs(1).prime(igk_loc, offset[ia] + 3 * l + m + 1) += 0.5 * z * std::conj(phase_factor) * rlm[lm] * ri_values[atom_type.id()][orb.rindex()];
+                                phi.pw_coeffs(0).prime(igk_loc, offset[ia] + l + m) += z * rlm[lm];
+                                phi.pw_coeffs(1).prime(igk_loc, offset[ia] + 3 * l + m + 1) += z * rlm[lm];
                             }
                         }
                     } else {
@@ -95,12 +140,12 @@ inline void K_point::generate_atomic_wave_functions_aux(const int         num_ao
                         for (int channel = 0, offset__ = 0; channel < atom_type.number_of_hubbard_channels(); channel++) {
                             auto &orb = atom_type.hubbard_orbital(channel);
                             const int l = std::abs(orb.l());
-                            auto z = std::pow(double_complex(0, -1), l) * fourpi / std::sqrt(unit_cell_.omega());
+                            auto z = zil[l] * phase_factor * ri(orb.rindex(), ish);
                             for (int m = -l; m <= l; m++) {
                                 int lm = utils::lm(l, m);
-                                phi.pw_coeffs(0).prime(igk_loc, offset[ia] + offset__  + l + m) = z * std::conj(phase_factor) * rlm[lm] * ri_values[atom_type.id()][orb.rindex()];
+                                phi.pw_coeffs(0).prime(igk_loc, offset[ia] + offset__  + l + m) = z * rlm[lm];
                                 if (ctx_.num_mag_dims() == 3) {
-                                    phi.pw_coeffs(1).prime(igk_loc, offset[ia] + offset__  + 3 * l + m + 1) = z * std::conj(phase_factor) * rlm[lm] * ri_values[atom_type.id()][orb.rindex()];
+                                    phi.pw_coeffs(1).prime(igk_loc, offset[ia] + offset__  + 3 * l + m + 1) = z * rlm[lm];
                                 }
                             }
                             offset__ += (ctx_.num_mag_dims() == 3) ? (2 * (2 * l + 1)) : (2 * l + 1);
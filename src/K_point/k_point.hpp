@@ -258,7 +258,20 @@ class K_point
         {
             PROFILE("sirius::K_point::update");
 
-            gkvec_->lattice_vectors(ctx_.unit_cell().reciprocal_lattice_vectors());
+            /* check if the lattice was changed since the G+k vectors were set up */
+            bool lattice_changed{false};
+            auto const& rlv = ctx_.unit_cell().reciprocal_lattice_vectors();
+            for (int i = 0; i < 3; i++) {
+                for (int j = 0; j < 3; j++) {
+                    if (gkvec_->lattice_vectors()(i, j) != rlv(i, j)) {
+                        lattice_changed = true;
+                    }
+                }
+            }
+
+            if (lattice_changed) {
+                gkvec_->lattice_vectors(ctx_.unit_cell().reciprocal_lattice_vectors());
+            }
 
             if (ctx_.full_potential()) {
                 if (ctx_.iterative_solver_input().type_ == "exact") {
@@ -272,15 +285,26 @@ class K_point
             }
 
             if (!ctx_.full_potential()) {
-                /* compute |beta> projectors for atom types */
-                beta_projectors_ = std::unique_ptr<Beta_projectors>(new Beta_projectors(ctx_, gkvec(), igk_loc_));
-
-                if (ctx_.iterative_solver_input().type_ == "exact") {
-                    beta_projectors_row_ = std::unique_ptr<Beta_projectors>(new Beta_projectors(ctx_, gkvec(), igk_row_));
-                    beta_projectors_col_ = std::unique_ptr<Beta_projectors>(new Beta_projectors(ctx_, gkvec(), igk_col_));
-
+                /* if only atomic positions have changed, keep the beta-projectors of atom types */
+                if (beta_projectors_ && !lattice_changed) {
+                    beta_projectors_->update_atom_positions();
+                    if (ctx_.iterative_solver_input().type_ == "exact") {
+                        beta_projectors_row_->update_atom_positions();
+                        beta_projectors_col_->update_atom_positions();
+                    }
+                } else {
+                    /* compute |beta> projectors for atom types */
+                    beta_projectors_ = std::unique_ptr<Beta_projectors>(new Beta_projectors(ctx_, gkvec(), igk_loc_));
+
+                    if (ctx_.iterative_solver_input().type_ == "exact") {
+                        beta_projectors_row_ = std::unique_ptr<Beta_projectors>(new Beta_projectors(ctx_, gkvec(), igk_row_));
+                        beta_projectors_col_ = std::unique_ptr<Beta_projectors>(new Beta_projectors(ctx_, gkvec(), igk_col_));
+                    }
                 }
 
+                /* S|phi_hub> depends on the atomic positions; it will be recomputed at the next band solve */
+                hubbard_wave_functions_.reset();
+
                 //if (false) {
                 //    p_mtrx_ = mdarray<double_complex, 3>(unit_cell_.max_mt_basis_size(), unit_cell_.max_mt_basis_size(), unit_cell_.num_atom_types());
                 //    p_mtrx_.zero();
@@ -504,6 +528,17 @@ class K_point
             return (hubbard_wave_functions_ != nullptr);
         }
 
+        /// Release the device copy of the Hubbard wave functions.
+        /** The orbitals S|phi_hub> are kept on the host until the atomic positions change (see update()). */
+        inline void dismiss_hubbard_wave_functions()
+        {
+            if (hubbard_wave_functions_ != nullptr) {
+                for (int ispn = 0; ispn < hubbard_wave_functions_->num_sc(); ispn++) {
+                    hubbard_wave_functions_->pw_coeffs(ispn).deallocate(memory_t::device);
+                }
+            }
+        }
+
         inline Wave_functions& singular_components()
         {
             return *singular_components_;
@@ -56,6 +56,39 @@ extern "C" void update_density_rg_1_gpu(int size__,
     );
 }
 
+__global__ void update_density_rg_1_pair_gpu_kernel(int size__,
+                                                    acc_complex_double_t const* psi_rg__,
+                                                    double wt1__,
+                                                    double wt2__,
+                                                    double* density_rg__)
+{
+    int ir = blockIdx.x * blockDim.x + threadIdx.x;
+    if (ir < size__)
+    {
+        acc_complex_double_t z = psi_rg__[ir];
+        density_rg__[ir] += z.x * z.x * wt1__ + z.y * z.y * wt2__;
+    }
+}
+
+/* update density with two real wave-functions packed as psi_1(r) + i psi_2(r) */
+extern "C" void update_density_rg_1_pair_gpu(int size__,
+                                             acc_complex_double_t const* psi_rg__,
+                                             double wt1__,
+                                             double wt2__,
+                                             double* density_rg__)
+{
+    dim3 grid_t(64);
+    dim3 grid_b(num_blocks(size__, grid_t.x));
+
+    accLaunchKernel((update_density_rg_1_pair_gpu_kernel), dim3(grid_b), dim3(grid_t), 0, 0,
+        size__,
+        psi_rg__,
+        wt1__,
+        wt2__,
+        density_rg__
+    );
+}
+
 __global__ void update_density_rg_2_gpu_kernel(int size__,
                                                acc_complex_double_t const* psi_up_rg__,
                                                acc_complex_double_t const* psi_dn_rg__,
@@ -0,0 +1,315 @@
+// Copyright (c) 2013-2019 Anton Kozhevnikov, Thomas Schulthess
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+// the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+//    following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+//    and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/** \file free_boundary_poisson.hpp
+ *
+ *  \brief Contains declaration and implementation of sirius::Free_boundary_poisson class.
+ */
+
+#ifndef __FREE_BOUNDARY_POISSON_HPP__
+#define __FREE_BOUNDARY_POISSON_HPP__
+
+#include "simulation_context.hpp"
+
+namespace sirius {
+
+/// Poisson solver with the free boundary conditions for isolated systems.
+/** Hockney's method: the charge density of the unit cell is placed in the box which is two times larger in each
+ *  direction, convoluted with the Coulomb kernel truncated at \f$ R_c \f$
+ *  \f[
+ *      W({\bf G}) = \frac{4\pi}{G^2} \big( 1 - \cos(G R_c) \big), \quad W(0) = 2 \pi R_c^2
+ *  \f]
+ *  and the potential is taken back from the part of the large box which corresponds to the original cell.
+ *
+ *  The radius \f$ R_c \f$ is equal to the half of the smallest height of the large box, i.e. to the smallest
+ *  height \f$ h \f$ of the original cell. The truncated kernel is equal to \f$ 1/|{\bf r} - {\bf r}'| \f$ only for
+ *  \f$ |{\bf r} - {\bf r}'| < R_c \f$, so the method assumes that the charge fits in a sphere of diameter
+ *  \f$ R_c \f$ (radius \f$ h/2 \f$): every pair of charged points is closer than \f$ R_c \f$, and the periodic
+ *  images in the large box, which are at least \f$ 2h \f$ apart, are further than \f$ R_c \f$ from any point of the
+ *  charge. The density tails outside of this sphere interact with the wrong kernel. The spherical cutoff in the
+ *  original cell requires the twice larger cell for the same accuracy.
+ *
+ *  The cell is cut along the planes with the smallest absolute charge before it is placed into the large box,
+ *  so the molecule doesn't need to be centered in the unit cell. */
+class Free_boundary_poisson
+{
+  private:
+    Simulation_context& ctx_;
+
+    /// FFT driver for the doubled grid.
+    std::unique_ptr<FFT3D> fft_;
+
+    /// G-vectors of the doubled grid.
+    std::unique_ptr<Gvec> gvec_;
+
+    /// Partition of G-vectors of the doubled grid.
+    std::unique_ptr<Gvec_partition> gvecp_;
+
+    /// Truncated Coulomb kernel for the local G-vectors of the doubled grid.
+    mdarray<double, 1> kernel_;
+
+    /// Dimensions of the context FFT grid for which the doubled grid is set up.
+    std::array<int, 3> dims_{{0, 0, 0}};
+
+    /// Reciprocal lattice vectors of the unit cell for which the kernel is computed.
+    matrix3d<double> rlv_;
+
+    /// Reciprocal lattice vectors of the doubled box.
+    matrix3d<double> reciprocal_lattice_vectors() const
+    {
+        auto M = ctx_.unit_cell().reciprocal_lattice_vectors();
+        for (int x : {0, 1, 2}) {
+            double f = double(ctx_.fft().size(x)) / fft_->size(x);
+            for (int i : {0, 1, 2}) {
+                M(i, x) *= f;
+            }
+        }
+        return M;
+    }
+
+    /// Find the position of the plane with the smallest absolute charge along each direction.
+    /** The input is the local part of the real-space density. */
+    std::array<int, 3> find_cut(double const* rho__) const
+    {
+        auto& fft = ctx_.fft();
+
+        std::array<std::vector<double>, 3> q;
+        for (int x : {0, 1, 2}) {
+            q[x] = std::vector<double>(fft.size(x), 0);
+        }
+        for (int iz = 0; iz < fft.local_size_z(); iz++) {
+            for (int i1 = 0; i1 < fft.size(1); i1++) {
+                for (int i0 = 0; i0 < fft.size(0); i0++) {
+                    double a = std::abs(rho__[fft.index_by_coord(i0, i1, iz)]);
+                    q[0][i0] += a;
+                    q[1][i1] += a;
+                    q[2][fft.offset_z() + iz] += a;
+                }
+            }
+        }
+        std::array<int, 3> cut;
+        for (int x : {0, 1, 2}) {
+            fft.comm().allreduce(q[x].data(), fft.size(x));
+            cut[x] = static_cast<int>(std::min_element(q[x].begin(), q[x].end()) - q[x].begin());
+        }
+        return cut;
+    }
+
+  public:
+    Free_boundary_poisson(Simulation_context& ctx__)
+        : ctx_(ctx__)
+    {
+        PROFILE("sirius::Free_boundary_poisson");
+
+        update();
+    }
+
+    /// Set up the doubled grid and the kernel for the current FFT grid and lattice vectors of the context.
+    /** The doubled grid is created again if the dimensions of the context FFT grid have changed (for example,
+     *  after Simulation_context::rebind()); otherwise only the lattice vectors of the G-vectors are updated.
+     *  Nothing is done if neither the grid nor the lattice vectors have changed. */
+    void update()
+    {
+        auto& fft = ctx_.fft();
+        auto rlv  = ctx_.unit_cell().reciprocal_lattice_vectors();
+
+        std::array<int, 3> dims = {fft.size(0), fft.size(1), fft.size(2)};
+
+        if (fft_ && dims == dims_) {
+            bool same{true};
+            for (int i : {0, 1, 2}) {
+                for (int j : {0, 1, 2}) {
+                    same &= (rlv(i, j) == rlv_(i, j));
+                }
+            }
+            if (same) {
+                return;
+            }
+        }
+
+        PROFILE("sirius::Free_boundary_poisson::update");
+
+        if (!fft_ || dims != dims_) {
+            gvecp_.reset();
+            gvec_.reset();
+            fft_ = std::unique_ptr<FFT3D>(new FFT3D({2 * dims[0], 2 * dims[1], 2 * dims[2]}, fft.comm(),
+                                                    device_t::CPU));
+
+            gvec_  = std::unique_ptr<Gvec>(new Gvec(reciprocal_lattice_vectors(), 1e10, *fft_, fft.comm(), false));
+            gvecp_ = std::unique_ptr<Gvec_partition>(new Gvec_partition(*gvec_, fft.comm(), Communicator::self()));
+
+            kernel_ = mdarray<double, 1>(gvec_->count(), memory_t::host, "Free_boundary_poisson::kernel_");
+            dims_   = dims;
+        } else {
+            gvec_->lattice_vectors(reciprocal_lattice_vectors());
+        }
+        rlv_ = rlv;
+
+        auto M = reciprocal_lattice_vectors();
+
+        /* smallest height of the doubled box */
+        double h{0};
+        for (int x : {0, 1, 2}) {
+            vector3d<double> b(M(0, x), M(1, x), M(2, x));
+            double hx = twopi / b.length();
+            h = (x == 0) ? hx : std::min(h, hx);
+        }
+        /* the charge must fit in a sphere of diameter R_c (see the class description) */
+        double R_c = 0.5 * h;
+
+        #pragma omp parallel for schedule(static)
+        for (int igloc = 0; igloc < gvec_->count(); igloc++) {
+            double g = gvec_->gvec_len(gvec_->offset() + igloc);
+            if (g < 1e-12) {
+                kernel_(igloc) = twopi * R_c * R_c;
+            } else {
+                kernel_(igloc) = fourpi * (1.0 - std::cos(g * R_c)) / std::pow(g, 2);
+            }
+        }
+    }
+
+    /// Compute the plane-wave coefficients of the Hartree potential of the isolated charge.
+    /** Both input and output are the local plane-wave coefficients of the context G-vectors. The FFT driver of
+     *  the context must be prepared.
+     *
+     *  The z-plane \f$ i_z \f$ of the original grid is placed into the plane \f$ (i_z - cut_z) \bmod N_z \f$ of the
+     *  large box; the planes are sent directly to the ranks which store them in the z-decomposition of the large
+     *  box, so each rank works only with its own slabs. */
+    void solve(double_complex const* rho_pw__, double_complex* vh_pw__)
+    {
+        PROFILE("sirius::Free_boundary_poisson::solve");
+
+        auto& fft  = ctx_.fft();
+        auto& comm = fft.comm();
+        int nx     = fft.size(0);
+        int ny     = fft.size(1);
+        int nz     = fft.size(2);
+        int nxy    = nx * ny;
+
+        /* charge density on the local slab of the real-space grid */
+        Smooth_periodic_function<double> f(fft, ctx_.gvec_partition());
+        std::copy(rho_pw__, rho_pw__ + ctx_.gvec().count(), &f.f_pw_local(0));
+        f.fft_transform(1);
+
+        auto cut = find_cut(&f.f_rg(0));
+
+        /* z-plane of the large box for the z-plane of the original grid */
+        auto z2 = [&](int iz) { return (iz - cut[2] + nz) % nz; };
+
+        /* planes which are sent to each rank of the large box and received from each rank of the original grid */
+        std::vector<std::vector<int>> send_planes(comm.size());
+        for (int iz = 0; iz < fft.local_size_z(); iz++) {
+            send_planes[fft_->spl_z().local_rank(z2(fft.offset_z() + iz))].push_back(iz);
+        }
+        std::vector<std::vector<int>> recv_planes(comm.size());
+        for (int r = 0; r < comm.size(); r++) {
+            for (int i = 0; i < fft.spl_z().local_size(r); i++) {
+                int z = z2(fft.spl_z().global_offset(r) + i) - fft_->offset_z();
+                if (z >= 0 && z < fft_->local_size_z()) {
+                    recv_planes[r].push_back(z);
+                }
+            }
+        }
+        std::vector<int> send_counts(comm.size());
+        std::vector<int> send_offsets(comm.size());
+        std::vector<int> recv_counts(comm.size());
+        std::vector<int> recv_offsets(comm.size());
+        for (int r = 0; r < comm.size(); r++) {
+            send_counts[r]  = nxy * static_cast<int>(send_planes[r].size());
+            recv_counts[r]  = nxy * static_cast<int>(recv_planes[r].size());
+            send_offsets[r] = (r == 0) ? 0 : send_offsets[r - 1] + send_counts[r - 1];
+            recv_offsets[r] = (r == 0) ? 0 : recv_offsets[r - 1] + recv_counts[r - 1];
+        }
+        std::vector<double> send_buf(fft.local_size());
+        std::vector<double> recv_buf(nxy * fft_->local_size_z());
+
+        /* the shift along x and y is done when the planes are packed */
+        auto pack_idx = [&](int i0, int i1)
+        {
+            return (i0 - cut[0] + nx) % nx + nx * ((i1 - cut[1] + ny) % ny);
+        };
+
+        for (int r = 0, k = 0; r < comm.size(); r++) {
+            for (int iz : send_planes[r]) {
+                for (int i1 = 0; i1 < ny; i1++) {
+                    for (int i0 = 0; i0 < nx; i0++) {
+                        send_buf[k * nxy + pack_idx(i0, i1)] = f.f_rg(fft.index_by_coord(i0, i1, iz));
+                    }
+                }
+                k++;
+            }
+        }
+        comm.alltoall(send_buf.data(), send_counts.data(), send_offsets.data(), recv_buf.data(), recv_counts.data(),
+                      recv_offsets.data());
+
+        fft_->prepare(*gvecp_);
+
+        Smooth_periodic_function<double> f2(*fft_, *gvecp_);
+        f2.zero();
+
+        for (int r = 0, k = 0; r < comm.size(); r++) {
+            for (int z : recv_planes[r]) {
+                for (int i1 = 0; i1 < ny; i1++) {
+                    for (int i0 = 0; i0 < nx; i0++) {
+                        f2.f_rg(fft_->index_by_coord(i0, i1, z)) = recv_buf[k * nxy + i0 + nx * i1];
+                    }
+                }
+                k++;
+            }
+        }
+        f2.fft_transform(-1);
+        #pragma omp parallel for schedule(static)
+        for (int igloc = 0; igloc < gvec_->count(); igloc++) {
+            f2.f_pw_local(igloc) *= kernel_(igloc);
+        }
+        f2.fft_transform(1);
+
+        fft_->dismiss();
+
+        /* take the potential back from the large box by the reverse exchange of the planes */
+        for (int r = 0, k = 0; r < comm.size(); r++) {
+            for (int z : recv_planes[r]) {
+                for (int i1 = 0; i1 < ny; i1++) {
+                    for (int i0 = 0; i0 < nx; i0++) {
+                        recv_buf[k * nxy + i0 + nx * i1] = f2.f_rg(fft_->index_by_coord(i0, i1, z));
+                    }
+                }
+                k++;
+            }
+        }
+        comm.alltoall(recv_buf.data(), recv_counts.data(), recv_offsets.data(), send_buf.data(), send_counts.data(),
+                      send_offsets.data());
+        for (int r = 0, k = 0; r < comm.size(); r++) {
+            for (int iz : send_planes[r]) {
+                for (int i1 = 0; i1 < ny; i1++) {
+                    for (int i0 = 0; i0 < nx; i0++) {
+                        f.f_rg(fft.index_by_coord(i0, i1, iz)) = send_buf[k * nxy + pack_idx(i0, i1)];
+                    }
+                }
+                k++;
+            }
+        }
+        f.fft_transform(-1);
+        std::copy(&f.f_pw_local(0), &f.f_pw_local(0) + ctx_.gvec().count(), vh_pw__);
+    }
+};
+
+} // namespace sirius
+
+#endif // __FREE_BOUNDARY_POISSON_HPP__
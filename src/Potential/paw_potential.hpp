@@ -25,10 +25,20 @@
 inline void Potential::init_PAW()
 {
     paw_potential_data_.clear();
+    paw_gaunt_coefs_.clear();
     if (!unit_cell_.num_paw_atoms()) {
         return;
     }
 
+    paw_gaunt_coefs_.resize(unit_cell_.num_atom_types());
+    for (int iat = 0; iat < unit_cell_.num_atom_types(); iat++) {
+        auto& atom_type = unit_cell_.atom_type(iat);
+        if (atom_type.is_paw()) {
+            int lmax = atom_type.indexr().lmax_lo();
+            paw_gaunt_coefs_[iat] = Gaunt_coefficients<double>::get(lmax, 2 * lmax, lmax, gaunt_t::rlm);
+        }
+    }
+
     for (int i = 0; i < unit_cell_.spl_num_paw_atoms().local_size(); i++) {
         int ia_paw = unit_cell_.spl_num_paw_atoms(i);
         int ia = unit_cell_.paw_atom_index(ia_paw);
@@ -92,8 +102,11 @@ inline void Potential::generate_PAW_effective_potential(Density const& density)
     /* zero Dij */
     paw_dij_.zero();
 
-    /* calculate xc and hartree for atoms */
-    for(int i = 0; i < unit_cell_.spl_num_paw_atoms().local_size(); i++) {
+    /* calculate xc and hartree for atoms; atoms are independent, so distribute them between threads if there
+       are enough of them, otherwise keep the parallelization inside the XC and Hartree kernels */
+    int nloc = unit_cell_.spl_num_paw_atoms().local_size();
+    #pragma omp parallel for schedule(dynamic) if (nloc >= omp_get_max_threads())
+    for(int i = 0; i < nloc; i++) {
         calc_PAW_local_potential(paw_potential_data_[i],
                                  density.ae_paw_atom_density(i),
                                  density.ps_paw_atom_density(i));
@@ -199,19 +212,29 @@ inline double Potential::xc_mt_PAW_collinear(std::vector<Spheric_function<spectr
 
     // calculate spin up spin down density components in lm components
     // up = 1/2 ( rho + magn );  down = 1/2 ( rho - magn )
-    Spheric_function<spectral, double> rho_u_lm_sf = 0.5 * (full_rho_lm_sf_new + density[1]);
-    Spheric_function<spectral, double> rho_d_lm_sf = 0.5 * (full_rho_lm_sf_new - density[1]);
+    // both components are kept in one set and transformed together
+    Spheric_function_set<spectral, double> rho_ud_lm_sf(2, lmsize_rho, rgrid);
+    auto& rho_u_lm_sf = rho_ud_lm_sf[0];
+    auto& rho_d_lm_sf = rho_ud_lm_sf[1];
+    for (int ir = 0; ir < rgrid.num_points(); ir++ ) {
+        for (int lm = 0; lm < lmsize_rho; lm++) {
+            rho_u_lm_sf(lm, ir) = 0.5 * (full_rho_lm_sf_new(lm, ir) + density[1](lm, ir));
+            rho_d_lm_sf(lm, ir) = 0.5 * (full_rho_lm_sf_new(lm, ir) - density[1](lm, ir));
+        }
+    }
 
     // transform density to theta phi components
-    Spheric_function<spatial, double> rho_u_tp_sf = transform(sht_.get(), rho_u_lm_sf );
-    Spheric_function<spatial, double> rho_d_tp_sf = transform(sht_.get(), rho_d_lm_sf );
+    auto rho_ud_tp_sf = transform(sht_.get(), rho_ud_lm_sf);
+    auto& rho_u_tp_sf = rho_ud_tp_sf[0];
+    auto& rho_d_tp_sf = rho_ud_tp_sf[1];
 
     // create potential in theta phi
     Spheric_function<spatial, double> vxc_u_tp_sf(sht_->num_points(), rgrid);
     Spheric_function<spatial, double> vxc_d_tp_sf(sht_->num_points(), rgrid);
 
-    // create energy in theta phi
-    Spheric_function<spatial, double> exc_tp_sf(sht_->num_points(), rgrid);
+    // create total potential, magnetic field and energy in theta phi
+    Spheric_function_set<spatial, double> vxc_bxc_exc_tp_sf(3, sht_->num_points(), rgrid);
+    auto& exc_tp_sf = vxc_bxc_exc_tp_sf[2];
 
     // calculate XC
     xc_mt_magnetic(rgrid, xc_func_,
@@ -220,14 +243,22 @@ inline double Potential::xc_mt_PAW_collinear(std::vector<Spheric_function<spectr
                    vxc_u_tp_sf, vxc_d_tp_sf,
                    exc_tp_sf);
 
+    for (int ir = 0; ir < rgrid.num_points(); ir++ ) {
+        for (int itp = 0; itp < sht_->num_points(); itp++ ) {
+            vxc_bxc_exc_tp_sf[0](itp, ir) = 0.5 * (vxc_u_tp_sf(itp, ir) + vxc_d_tp_sf(itp, ir));
+            vxc_bxc_exc_tp_sf[1](itp, ir) = 0.5 * (vxc_u_tp_sf(itp, ir) - vxc_d_tp_sf(itp, ir));
+        }
+    }
+
     // transform back in lm
-    potential[0] += transform(sht_.get(), 0.5 * (vxc_u_tp_sf + vxc_d_tp_sf) );
-    potential[1] += transform(sht_.get(), 0.5 * (vxc_u_tp_sf - vxc_d_tp_sf));
+    auto vxc_bxc_exc_lm_sf = transform(sht_.get(), vxc_bxc_exc_tp_sf);
+    potential[0] += vxc_bxc_exc_lm_sf[0];
+    potential[1] += vxc_bxc_exc_lm_sf[1];
 
     //------------------------
     //--- calculate energy ---
     //------------------------
-    Spheric_function<spectral,double> exc_lm_sf = transform(sht_.get(), exc_tp_sf );
+    auto& exc_lm_sf = vxc_bxc_exc_lm_sf[2];
 
     return inner(exc_lm_sf, full_rho_lm_sf_new);
 }
@@ -243,16 +274,18 @@ inline double Potential::xc_mt_PAW_noncollinear(std::vector<Spheric_function<spe
 
     Radial_grid<double> const& rgrid = density[0].radial_grid();
 
-    /* transform density to theta phi components */
-    std::vector<Spheric_function<spatial, double>> rho_tp(density.size());
-
-    for (size_t i = 0; i < density.size(); i++){
-        rho_tp[i] = transform(sht_.get(), density[i]);
+    /* copy density to contiguous storage and transform it to theta phi components */
+    int lmsize_rho = static_cast<int>(density[0].size(0));
+    Spheric_function_set<spectral, double> rho_lm(4, lmsize_rho, rgrid);
+    for (int i = 0; i < 4; i++) {
+        std::copy(&density[i](0, 0), &density[i](0, 0) + density[i].size(), &rho_lm[i](0, 0));
     }
+    auto rho_tp = transform(sht_.get(), rho_lm);
 
     /* transform 4D magnetization to spin-up, spin-down form (correct for LSDA)  rho ± |magn| */
-    Spheric_function<spatial, double> rho_u_tp(sht_->num_points(), rgrid);
-    Spheric_function<spatial, double> rho_d_tp(sht_->num_points(), rgrid);
+    Spheric_function_set<spatial, double> rho_ud_tp(2, sht_->num_points(), rgrid);
+    auto& rho_u_tp = rho_ud_tp[0];
+    auto& rho_d_tp = rho_ud_tp[1];
 
     //#pragma omp parallel for
     for (int ir = 0; ir < rgrid.num_points(); ir++ ) {
@@ -266,15 +299,17 @@ inline double Potential::xc_mt_PAW_noncollinear(std::vector<Spheric_function<spe
     }
 
     /* in lm representation */
-    Spheric_function<spectral, double> rho_u_lm = transform(sht_.get(), rho_u_tp);
-    Spheric_function<spectral, double> rho_d_lm = transform(sht_.get(), rho_d_tp);
+    auto rho_ud_lm = transform(sht_.get(), rho_ud_tp);
+    auto& rho_u_lm = rho_ud_lm[0];
+    auto& rho_d_lm = rho_ud_lm[1];
 
     // allocate potential in theta phi
     Spheric_function<spatial, double> vxc_u_tp(sht_->num_points(), rgrid);
     Spheric_function<spatial, double> vxc_d_tp(sht_->num_points(), rgrid);
 
-    // allocate energy in theta phi
-    Spheric_function<spatial, double> exc_tp(sht_->num_points(), rgrid);
+    /* allocate 4D potential and energy in theta phi components */
+    Spheric_function_set<spatial, double> vxc_exc_tp(5, sht_->num_points(), rgrid);
+    auto& exc_tp = vxc_exc_tp[4];
 
     // calculate XC
     xc_mt_magnetic(rgrid, xc_func_,
@@ -283,14 +318,6 @@ inline double Potential::xc_mt_PAW_noncollinear(std::vector<Spheric_function<spe
                    vxc_u_tp, vxc_d_tp,
                    exc_tp);
 
-    /* allocate 4D potential in theta phi components */
-    std::vector<Spheric_function<spatial, double>> vxc_tp;
-
-    /* allocate the rest */
-    for (size_t i = 0; i < potential.size(); i++){
-        vxc_tp.push_back(Spheric_function<spatial, double>(sht_->num_points(), rgrid));
-    }
-
     /* transform back potential from up/down to 4D form*/
     //#pragma omp parallel for
     for (int ir = 0; ir < rgrid.num_points(); ir++ ) {
@@ -305,20 +332,19 @@ inline double Potential::xc_mt_PAW_noncollinear(std::vector<Spheric_function<spe
             magn = magn * (norm > 0.0 ? field / norm : 0.0) ;
 
             /* add total potential and effective field values at current point */
-            vxc_tp[0](itp, ir) = pot;
+            vxc_exc_tp[0](itp, ir) = pot;
             for (int i: {0,1,2}) {
-                vxc_tp[i+1](itp, ir) = magn[i];
+                vxc_exc_tp[i+1](itp, ir) = magn[i];
             }
         }
     }
 
-    /* transform back to lm- domain */
-    for(size_t i = 0; i < density.size(); i++){
-        potential[i] += transform(sht_.get(), vxc_tp[i]);
+    /* transform potential and energy back to lm- domain */
+    auto vxc_exc_lm = transform(sht_.get(), vxc_exc_tp);
+    for (int i = 0; i < 4; i++) {
+        potential[i] += vxc_exc_lm[i];
     }
-
-    /* transform to lm- domain */
-    Spheric_function<spectral, double> exc_lm = transform(sht_.get(), exc_tp);
+    auto& exc_lm = vxc_exc_lm[4];
 
     return inner(exc_lm, rho_u_lm + rho_d_lm);
 }
@@ -434,7 +460,7 @@ inline void Potential::calc_PAW_local_Dij(paw_potential_data_t& pdd, mdarray<dou
 
     auto l_by_lm = utils::l_by_lm(2 * lmax);
 
-    Gaunt_coefficients<double> GC(lmax, 2 * lmax, lmax, SHT::gaunt_rlm);
+    auto& GC = *paw_gaunt_coefs_[atom_type.id()];
 
     /* store integrals here */
     mdarray<double, 3> integrals(lmsize_rho, atom_type.num_beta_radial_functions() * (atom_type.num_beta_radial_functions() + 1) / 2,
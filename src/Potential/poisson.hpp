@@ -100,31 +100,38 @@ inline void Potential::poisson_add_pseudo_pw(mdarray<double_complex, 2>& qmt__,
 
         /* add pseudo_density to interstitial charge density so that rho(G) has the correct 
          * multipole moments in the muffin-tins */
-        #pragma omp parallel for schedule(static)
-        for (int igloc = 0; igloc < ctx_.gvec().count(); igloc++) {
-            int ig = ctx_.gvec().offset() + igloc;
-
-            double gR = ctx_.gvec().gvec_len(ig) * R;
-            double gRn = std::pow(2.0 / gR, pseudo_density_order_ + 1);
-
-            double_complex rho_G(0, 0);
-            if (ig) { // G!=0
-                /* loop over atoms of the same type */
-                for (int l = 0, lm = 0; l <= ctx_.lmax_rho(); l++) {
-                    double_complex zt1(0, 0);
-                    for (int m = -l; m <= l; m++, lm++) {
-                        zt1 += gvec_ylm_(lm, igloc) * qapf(lm, igloc);
+        #pragma omp parallel
+        {
+            std::vector<double_complex> ylm(lmmax);
+            #pragma omp for schedule(static)
+            for (int igloc = 0; igloc < ctx_.gvec().count(); igloc++) {
+                int ig = ctx_.gvec().offset() + igloc;
+                int igs = ctx_.gvec().shell(ig);
+
+                double gR = ctx_.gvec().gvec_len(ig) * R;
+                double gRn = std::pow(2.0 / gR, pseudo_density_order_ + 1);
+
+                double_complex rho_G(0, 0);
+                if (ig) { // G!=0
+                    auto rtp = SHT::spherical_coordinates(ctx_.gvec().gvec_cart<index_domain_t::local>(igloc));
+                    SHT::spherical_harmonics(ctx_.lmax_rho(), rtp[1], rtp[2], &ylm[0]);
+                    /* loop over atoms of the same type */
+                    for (int l = 0, lm = 0; l <= ctx_.lmax_rho(); l++) {
+                        double_complex zt1(0, 0);
+                        for (int m = -l; m <= l; m++, lm++) {
+                            zt1 += ylm[lm] * qapf(lm, igloc);
+                        }
+                        rho_G += (fourpi / unit_cell_.omega()) * std::conj(zil_[l]) * zt1 * gamma_factors_R_(l, iat) *
+                                 sbessel_mt_(l + pseudo_density_order_ + 1, igs, iat) * gRn;
+                    } // l
+                } else { // G=0
+                    for (int i = 0; i < unit_cell_.atom_type(iat).num_atoms(); i++) {
+                        int ia = unit_cell_.atom_type(iat).atom_id(i);
+                        rho_G += (fourpi / unit_cell_.omega()) * y00 * (qmt__(0, ia) - qit__(0, ia));
                     }
-                    rho_G += (fourpi / unit_cell_.omega()) * std::conj(zil_[l]) * zt1 * gamma_factors_R_(l, iat) * 
-                             sbessel_mt_(l + pseudo_density_order_ + 1, igloc, iat) * gRn;
-                } // l
-            } else { // G=0
-                for (int i = 0; i < unit_cell_.atom_type(iat).num_atoms(); i++) {
-                    int ia = unit_cell_.atom_type(iat).atom_id(i);
-                    rho_G += (fourpi / unit_cell_.omega()) * y00 * (qmt__(0, ia) - qit__(0, ia));
                 }
+                rho_pw__[igloc] += rho_G;
             }
-            rho_pw__[igloc] += rho_G;
         }
     }
 }
@@ -156,7 +163,7 @@ inline void Potential::poisson(Periodic_function<double> const& rho)
         /* compute multipoles of interstitial density in MT region */
         //mdarray<double_complex, 2> qit(ctx_.lmmax_rho(), unit_cell_.num_atoms());
         //poisson_sum_G(ctx_.lmmax_rho(), &rho.f_pw_local(0), sbessel_mom_, qit);
-        auto qit = ctx_.sum_fg_fl_yg(ctx_.lmax_rho(), &rho.f_pw_local(0), sbessel_mom_, gvec_ylm_);
+        auto qit = ctx_.sum_fg_fl_yg(ctx_.lmax_rho(), &rho.f_pw_local(0), sbessel_mom_);
 
         //== for (int ia = 0; ia < unit_cell_.num_atoms(); ia++) {
         //==     for (int lm = 0; lm < ctx_.lmmax_rho(); lm++) {
@@ -175,7 +182,7 @@ inline void Potential::poisson(Periodic_function<double> const& rho)
         poisson_add_pseudo_pw(qmt, qit, const_cast<double_complex*>(&rho.f_pw_local(0)));
 
         if (ctx_.control().verification_ >= 2) {
-            auto qit = ctx_.sum_fg_fl_yg(ctx_.lmax_rho(), &rho.f_pw_local(0), sbessel_mom_, gvec_ylm_);
+            auto qit = ctx_.sum_fg_fl_yg(ctx_.lmax_rho(), &rho.f_pw_local(0), sbessel_mom_);
 
             double d = 0.0;
             for (int ia = 0; ia < unit_cell_.num_atoms(); ia++) {
@@ -193,7 +200,10 @@ inline void Potential::poisson(Periodic_function<double> const& rho)
         hartree_potential_->f_pw_local(0) = 0.0;
         ig0 = 1;
     }
-    if (!ctx_.molecule()) {
+    if (free_boundary_poisson_) {
+        /* the pseudo-charge includes nuclei, so the G=0 term of the potential of the neutral system is kept */
+        free_boundary_poisson_->solve(&rho.f_pw_local(0), &hartree_potential_->f_pw_local(0));
+    } else if (!ctx_.molecule()) {
         #pragma omp parallel for schedule(static)
         for (int igloc = ig0; igloc < ctx_.gvec().count(); igloc++) {
             int ig = ctx_.gvec().offset() + igloc;
@@ -219,7 +229,7 @@ inline void Potential::poisson(Periodic_function<double> const& rho)
     /* boundary condition for muffin-tins */
     if (ctx_.full_potential()) {
         /* compute V_lm at the MT boundary */
-        auto vmtlm = ctx_.sum_fg_fl_yg(ctx_.lmax_pot(), &hartree_potential_->f_pw_local(0), sbessel_mt_, gvec_ylm_);
+        auto vmtlm = ctx_.sum_fg_fl_yg(ctx_.lmax_pot(), &hartree_potential_->f_pw_local(0), sbessel_mt_);
 
         /* add boundary condition and convert to Rlm */
         utils::timer t1("sirius::Potential::poisson|bc");
@@ -27,6 +27,7 @@
 
 #include "Density/density.hpp"
 #include "xc_functional.hpp"
+#include "free_boundary_poisson.hpp"
 
 namespace sirius {
 
@@ -53,6 +54,9 @@ class Potential : public Field4D
     /// Local part of pseudopotential.
     std::unique_ptr<Smooth_periodic_function<double>> local_potential_;
 
+    /// Poisson solver for isolated systems.
+    std::unique_ptr<Free_boundary_poisson> free_boundary_poisson_;
+
     /// Derivative \f$ \partial \epsilon^{XC} / \partial \sigma_{\alpha} \f$.
     /** \f$ \epsilon^{XC} \f$ is the exchange-correlation energy per unit volume and \f$ \sigma \f$ is one of
      *  \f$ \nabla \rho_{\uparrow} \nabla \rho_{\uparrow} \f$,  \f$ \nabla \rho_{\uparrow} \nabla \rho_{\downarrow} \f$ or
@@ -83,8 +87,6 @@ class Potential : public Field4D
 
     std::vector<int> l_by_lm_;
 
-    mdarray<double_complex, 2> gvec_ylm_;
-
     double energy_vha_;
 
     /// Electronic part of Hartree potential.
@@ -131,6 +133,9 @@ class Potential : public Field4D
 
     std::vector<paw_potential_data_t> paw_potential_data_;
 
+    /// Gaunt coefficients of each PAW atom type (empty for non-PAW types).
+    std::vector<std::shared_ptr<Gaunt_coefficients<double> const>> paw_gaunt_coefs_;
+
     mdarray<double, 4> paw_dij_;
 
     int max_paw_basis_size_{0};
@@ -365,8 +370,23 @@ class Potential : public Field4D
 
         vh_el_ = mdarray<double, 1>(unit_cell_.num_atoms());
 
+        if (ctx_.molecule()) {
+            auto& solver = ctx_.parameters_input().molecule_poisson_solver_;
+            if (solver == "hockney") {
+                /* the local potential and the Ewald energy are computed with the periodic boundary conditions;
+                 * mixing them with the free-boundary Hartree potential leaves the error of the order of N^2/L */
+                if (!ctx_.full_potential()) {
+                    TERMINATE("free-boundary Poisson solver is implemented for the full-potential case only");
+                }
+                free_boundary_poisson_ = std::unique_ptr<Free_boundary_poisson>(new Free_boundary_poisson(ctx_));
+            } else if (solver != "cutoff") {
+                std::stringstream s;
+                s << "wrong type of the molecule Poisson solver: " << solver;
+                TERMINATE(s);
+            }
+        }
+
         if (ctx_.full_potential()) {
-            gvec_ylm_ = mdarray<double_complex, 2>(ctx_.lmmax_pot(), ctx_.gvec().count(), memory_t::host, "gvec_ylm_");
 
             switch (ctx_.valence_relativity()) {
                 case relativity_t::iora: {
@@ -403,6 +423,10 @@ class Potential : public Field4D
     {
         PROFILE("sirius::Potential::update");
 
+        if (free_boundary_poisson_) {
+            free_boundary_poisson_->update();
+        }
+
         if (!ctx_.full_potential()) {
             local_potential_->zero();
 
@@ -416,7 +440,6 @@ class Potential : public Field4D
         }
 
         if (ctx_.full_potential()) {
-            gvec_ylm_ = ctx_.generate_gvec_ylm(ctx_.lmax_pot());
             sbessel_mt_ = ctx_.generate_sbessel_mt(lmax_ + pseudo_density_order_ + 1);
 
             /* compute moments of spherical Bessel functions
@@ -427,25 +450,19 @@ class Potential : public Field4D
              * and use relation between Bessel and spherical Bessel functions:
              * Subscript[j, n](z)=Sqrt[\[Pi]/2]/Sqrt[z]Subscript[J, n+1/2](z) */
             sbessel_mom_ = mdarray<double, 3>(ctx_.lmax_rho() + 1,
-                                              ctx_.gvec().count(),
+                                              ctx_.gvec().num_shells(),
                                               unit_cell_.num_atom_types(),
                                               memory_t::host, "sbessel_mom_");
             sbessel_mom_.zero();
-            int ig0{0};
-            if (ctx_.comm().rank() == 0) {
-                /* for |G| = 0 */
-                for (int iat = 0; iat < unit_cell_.num_atom_types(); iat++) {
-                    sbessel_mom_(0, 0, iat) = std::pow(unit_cell_.atom_type(iat).mt_radius(), 3) / 3.0;
-                }
-                ig0 = 1;
-            }
             for (int iat = 0; iat < unit_cell_.num_atom_types(); iat++) {
+                /* for |G| = 0 */
+                sbessel_mom_(0, 0, iat) = std::pow(unit_cell_.atom_type(iat).mt_radius(), 3) / 3.0;
                 #pragma omp parallel for schedule(static)
-                for (int igloc = ig0; igloc < ctx_.gvec().count(); igloc++) {
-                    auto len = ctx_.gvec().gvec_cart<index_domain_t::local>(igloc).length();
+                for (int igs = 1; igs < ctx_.gvec().num_shells(); igs++) {
+                    auto len = ctx_.gvec().shell_len(igs);
                     for (int l = 0; l <= ctx_.lmax_rho(); l++) {
-                        sbessel_mom_(l, igloc, iat) = std::pow(unit_cell_.atom_type(iat).mt_radius(), l + 2) *
-                                                      sbessel_mt_(l + 1, igloc, iat) / len;
+                        sbessel_mom_(l, igs, iat) = std::pow(unit_cell_.atom_type(iat).mt_radius(), l + 2) *
+                                                    sbessel_mt_(l + 1, igs, iat) / len;
                     }
                 }
             }
@@ -33,7 +33,7 @@ inline void Potential::xc_mt_nonmagnetic(Radial_grid<double> const& rgrid,
 
     bool is_gga = is_gradient_correction();
 
-    Spheric_function_gradient<spatial, double> grad_rho_tp(sht_->num_points(), rgrid);
+    Spheric_function_gradient<spatial, double> grad_rho_tp;
     Spheric_function<spatial, double> lapl_rho_tp;
     Spheric_function<spatial, double> grad_rho_grad_rho_tp;
 
@@ -42,9 +42,7 @@ inline void Potential::xc_mt_nonmagnetic(Radial_grid<double> const& rgrid,
         auto grad_rho_lm = gradient(rho_lm);
 
         /* backward transform gradient from Rlm to (theta, phi) */
-        for (int x = 0; x < 3; x++) {
-            grad_rho_tp[x] = transform(sht_.get(), grad_rho_lm[x]);
-        }
+        grad_rho_tp = transform(sht_.get(), grad_rho_lm);
 
         /* compute density gradient product */
         grad_rho_grad_rho_tp = grad_rho_tp * grad_rho_tp;
@@ -122,10 +120,7 @@ inline void Potential::xc_mt_nonmagnetic(Radial_grid<double> const& rgrid,
         auto grad_vsigma_lm = gradient(vsigma_lm);
 
         /* backward transform gradient from Rlm to (theta, phi) */
-        Spheric_function_gradient<spatial, double> grad_vsigma_tp(sht_->num_points(), rgrid);
-        for (int x = 0; x < 3; x++) {
-            grad_vsigma_tp[x] = transform(sht_.get(), grad_vsigma_lm[x]);
-        }
+        auto grad_vsigma_tp = transform(sht_.get(), grad_vsigma_lm);
 
         /* compute scalar product of two gradients */
         auto grad_vsigma_grad_rho_tp = grad_vsigma_tp * grad_rho_tp;
@@ -155,11 +150,11 @@ inline void Potential::xc_mt_magnetic(Radial_grid<double> const& rgrid,
 
     bool is_gga = is_gradient_correction();
 
-    Spheric_function_gradient<spatial, double> grad_rho_up_tp(sht_->num_points(), rgrid);
-    Spheric_function_gradient<spatial, double> grad_rho_dn_tp(sht_->num_points(), rgrid);
+    Spheric_function_gradient<spatial, double> grad_rho_up_tp;
+    Spheric_function_gradient<spatial, double> grad_rho_dn_tp;
 
-    Spheric_function<spatial, double> lapl_rho_up_tp(sht_->num_points(), rgrid);
-    Spheric_function<spatial, double> lapl_rho_dn_tp(sht_->num_points(), rgrid);
+    /* Laplacians of "up" and "dn" components are stored together and transformed to (theta, phi) at once */
+    Spheric_function_set<spatial, double> lapl_rho_tp(is_gga ? 2 : 0, sht_->num_points(), rgrid);
 
     Spheric_function<spatial, double> grad_rho_up_grad_rho_up_tp;
     Spheric_function<spatial, double> grad_rho_dn_grad_rho_dn_tp;
@@ -178,11 +173,8 @@ inline void Potential::xc_mt_magnetic(Radial_grid<double> const& rgrid,
         auto grad_rho_dn_lm = gradient(rho_dn_lm);
 
         /* backward transform gradient from Rlm to (theta, phi) */
-        for (int x = 0; x < 3; x++)
-        {
-            grad_rho_up_tp[x] = transform(sht_.get(), grad_rho_up_lm[x]);
-            grad_rho_dn_tp[x] = transform(sht_.get(), grad_rho_dn_lm[x]);
-        }
+        grad_rho_up_tp = transform(sht_.get(), grad_rho_up_lm);
+        grad_rho_dn_tp = transform(sht_.get(), grad_rho_dn_lm);
 
         /* compute density gradient products */
         grad_rho_up_grad_rho_up_tp = grad_rho_up_tp * grad_rho_up_tp;
@@ -190,27 +182,18 @@ inline void Potential::xc_mt_magnetic(Radial_grid<double> const& rgrid,
         grad_rho_dn_grad_rho_dn_tp = grad_rho_dn_tp * grad_rho_dn_tp;
 
         /* compute Laplacians in Rlm spherical harmonics */
-        auto lapl_rho_up_lm = laplacian(rho_up_lm);
-        auto lapl_rho_dn_lm = laplacian(rho_dn_lm);
+        Spheric_function_set<spectral, double> lapl_rho_lm(2, rho_up_lm.angular_domain_size(), rgrid);
+        laplacian(rho_up_lm, lapl_rho_lm[0]);
+        laplacian(rho_dn_lm, lapl_rho_lm[1]);
 
         /* backward transform Laplacians from Rlm to (theta, phi) */
-        lapl_rho_up_tp = transform(sht_.get(), lapl_rho_up_lm);
-        lapl_rho_dn_tp = transform(sht_.get(), lapl_rho_dn_lm);
+        transform(sht_.get(), lapl_rho_lm, lapl_rho_tp);
     }
 
-    Spheric_function<spatial, double> vsigma_uu_tp;
-    Spheric_function<spatial, double> vsigma_ud_tp;
-    Spheric_function<spatial, double> vsigma_dd_tp;
-    if (is_gga)
-    {
-        vsigma_uu_tp = Spheric_function<spatial, double>(sht_->num_points(), rgrid);
-        vsigma_uu_tp.zero();
-
-        vsigma_ud_tp = Spheric_function<spatial, double>(sht_->num_points(), rgrid);
-        vsigma_ud_tp.zero();
-
-        vsigma_dd_tp = Spheric_function<spatial, double>(sht_->num_points(), rgrid);
-        vsigma_dd_tp.zero();
+    /* uu, ud and dd components of vsigma are stored together and transformed to Rlm at once */
+    Spheric_function_set<spatial, double> vsigma_tp(is_gga ? 3 : 0, sht_->num_points(), rgrid);
+    for (int i = 0; i < vsigma_tp.size(); i++) {
+        vsigma_tp[i].zero();
     }
 
     /* loop over XC functionals */
@@ -265,14 +248,17 @@ inline void Potential::xc_mt_magnetic(Radial_grid<double> const& rgrid,
                         /* add Exc contribution */
                         exc_tp(itp, ir) += exc_t[itp];
 
+                        double lapl_rho_up = lapl_rho_tp[0](itp, ir);
+                        double lapl_rho_dn = lapl_rho_tp[1](itp, ir);
+
                         /* directly add to Vxc available contributions */
-                        vxc_up_tp(itp, ir) += (vrho_up_t[itp] - 2 * vsigma_uu_t[itp] * lapl_rho_up_tp(itp, ir) - vsigma_ud_t[itp] * lapl_rho_dn_tp(itp, ir));
-                        vxc_dn_tp(itp, ir) += (vrho_dn_t[itp] - 2 * vsigma_dd_t[itp] * lapl_rho_dn_tp(itp, ir) - vsigma_ud_t[itp] * lapl_rho_up_tp(itp, ir));
+                        vxc_up_tp(itp, ir) += (vrho_up_t[itp] - 2 * vsigma_uu_t[itp] * lapl_rho_up - vsigma_ud_t[itp] * lapl_rho_dn);
+                        vxc_dn_tp(itp, ir) += (vrho_dn_t[itp] - 2 * vsigma_dd_t[itp] * lapl_rho_dn - vsigma_ud_t[itp] * lapl_rho_up);
 
                         /* save the sigma derivatives */
-                        vsigma_uu_tp(itp, ir) += vsigma_uu_t[itp];
-                        vsigma_ud_tp(itp, ir) += vsigma_ud_t[itp];
-                        vsigma_dd_tp(itp, ir) += vsigma_dd_t[itp];
+                        vsigma_tp[0](itp, ir) += vsigma_uu_t[itp];
+                        vsigma_tp[1](itp, ir) += vsigma_ud_t[itp];
+                        vsigma_tp[2](itp, ir) += vsigma_dd_t[itp];
                     }
                 }
             }
@@ -281,9 +267,10 @@ inline void Potential::xc_mt_magnetic(Radial_grid<double> const& rgrid,
 
     if (is_gga) {
         /* forward transform vsigma to Rlm */
-        auto vsigma_uu_lm = transform(sht_.get(), vsigma_uu_tp);
-        auto vsigma_ud_lm = transform(sht_.get(), vsigma_ud_tp);
-        auto vsigma_dd_lm = transform(sht_.get(), vsigma_dd_tp);
+        auto vsigma_lm = transform(sht_.get(), vsigma_tp);
+        auto& vsigma_uu_lm = vsigma_lm[0];
+        auto& vsigma_ud_lm = vsigma_lm[1];
+        auto& vsigma_dd_lm = vsigma_lm[2];
 
         /* compute gradient of vsgima in spherical harmonics */
         auto grad_vsigma_uu_lm = gradient(vsigma_uu_lm);
@@ -291,15 +278,9 @@ inline void Potential::xc_mt_magnetic(Radial_grid<double> const& rgrid,
         auto grad_vsigma_dd_lm = gradient(vsigma_dd_lm);
 
         /* backward transform gradient from Rlm to (theta, phi) */
-        Spheric_function_gradient<spatial, double> grad_vsigma_uu_tp(sht_->num_points(), rgrid);
-        Spheric_function_gradient<spatial, double> grad_vsigma_ud_tp(sht_->num_points(), rgrid);
-        Spheric_function_gradient<spatial, double> grad_vsigma_dd_tp(sht_->num_points(), rgrid);
-        for (int x = 0; x < 3; x++)
-        {
-            grad_vsigma_uu_tp[x] = transform(sht_.get(), grad_vsigma_uu_lm[x]);
-            grad_vsigma_ud_tp[x] = transform(sht_.get(), grad_vsigma_ud_lm[x]);
-            grad_vsigma_dd_tp[x] = transform(sht_.get(), grad_vsigma_dd_lm[x]);
-        }
+        auto grad_vsigma_uu_tp = transform(sht_.get(), grad_vsigma_uu_lm);
+        auto grad_vsigma_ud_tp = transform(sht_.get(), grad_vsigma_ud_lm);
+        auto grad_vsigma_dd_tp = transform(sht_.get(), grad_vsigma_dd_lm);
 
         /* compute scalar product of two gradients */
         auto grad_vsigma_uu_grad_rho_up_tp = grad_vsigma_uu_tp * grad_rho_up_tp;
@@ -328,22 +309,21 @@ inline void Potential::xc_mt(Density const& density__)
         auto& rgrid = unit_cell_.atom(ia).radial_grid();
         int nmtp = unit_cell_.atom(ia).num_mt_points();
 
-        /* backward transform density from Rlm to (theta, phi) */
-        auto rho_tp = transform(sht_.get(), density__.rho().f_mt(ialoc));
-
-        /* backward transform magnetization from Rlm to (theta, phi) */
-        std::vector< Spheric_function<spatial, double> > vecmagtp(ctx_.num_mag_dims());
-        for (int j = 0; j < ctx_.num_mag_dims(); j++) {
-            vecmagtp[j] = transform(sht_.get(), density__.magnetization(j).f_mt(ialoc));
+        /* density and magnetization are copied together and transformed from Rlm to (theta, phi) at once */
+        Spheric_function_set<spectral, double> rho_mag_lm(1 + ctx_.num_mag_dims(),
+                                                          density__.rho().f_mt(ialoc).angular_domain_size(), rgrid);
+        for (int j = 0; j < rho_mag_lm.size(); j++) {
+            auto& f = (j == 0) ? density__.rho().f_mt(ialoc) : density__.magnetization(j - 1).f_mt(ialoc);
+            std::copy(&f(0, 0), &f(0, 0) + f.size(), &rho_mag_lm[j](0, 0));
         }
+        auto rho_mag_tp = transform(sht_.get(), rho_mag_lm);
+        auto& rho_tp = rho_mag_tp[0];
 
-        /* "up" component of the density */
-        Spheric_function<spectral, double> rho_up_lm;
-        Spheric_function<spatial, double> rho_up_tp(sht_->num_points(), rgrid);
-
-        /* "dn" component of the density */
-        Spheric_function<spectral, double> rho_dn_lm;
-        Spheric_function<spatial, double> rho_dn_tp(sht_->num_points(), rgrid);
+        /* "up" and "dn" components of the density */
+        Spheric_function_set<spatial, double> rho_ud_tp(2, sht_->num_points(), rgrid);
+        auto& rho_up_tp = rho_ud_tp[0];
+        auto& rho_dn_tp = rho_ud_tp[1];
+        Spheric_function_set<spectral, double> rho_ud_lm(0, sht_->lmmax(), rgrid);
 
         /* check if density has negative values */
         double rhomin = 0.0;
@@ -376,7 +356,7 @@ inline void Potential::xc_mt(Density const& density__)
                     /* compute magnitude of the magnetization vector */
                     double mag = 0.0;
                     for (int j = 0; j < ctx_.num_mag_dims(); j++) {
-                        mag += pow(vecmagtp[j](itp, ir), 2);
+                        mag += pow(rho_mag_tp[1 + j](itp, ir), 2);
                     }
                     mag = std::sqrt(mag);
 
@@ -397,35 +377,37 @@ inline void Potential::xc_mt(Density const& density__)
             }
 
             /* transform from (theta, phi) to Rlm */
-            rho_up_lm = transform(sht_.get(), rho_up_tp);
-            rho_dn_lm = transform(sht_.get(), rho_dn_tp);
+            rho_ud_lm = transform(sht_.get(), rho_ud_tp);
         }
 
-        Spheric_function<spatial, double> exc_tp(sht_->num_points(), rgrid);
-        Spheric_function<spatial, double> vxc_tp(sht_->num_points(), rgrid);
+        Spheric_function_set<spatial, double> vxc_exc_tp(2, sht_->num_points(), rgrid);
+        auto& vxc_tp = vxc_exc_tp[0];
+        auto& exc_tp = vxc_exc_tp[1];
 
         if (ctx_.num_spins() == 1) {
-            xc_mt_nonmagnetic(rgrid, xc_func_, density__.rho().f_mt(ialoc), rho_tp, vxc_tp, exc_tp);
+            xc_mt_nonmagnetic(rgrid, xc_func_, rho_mag_lm[0], rho_tp, vxc_tp, exc_tp);
         } else {
             Spheric_function<spatial, double> vxc_up_tp(sht_->num_points(), rgrid);
             Spheric_function<spatial, double> vxc_dn_tp(sht_->num_points(), rgrid);
 
-            xc_mt_magnetic(rgrid, xc_func_, rho_up_lm, rho_up_tp, rho_dn_lm, rho_dn_tp, vxc_up_tp, vxc_dn_tp, exc_tp);
+            xc_mt_magnetic(rgrid, xc_func_, rho_ud_lm[0], rho_up_tp, rho_ud_lm[1], rho_dn_tp, vxc_up_tp, vxc_dn_tp, exc_tp);
+
+            /* components of the magnetic field are stored together and transformed to Rlm at once */
+            Spheric_function_set<spatial, double> bxc_tp(ctx_.num_mag_dims(), sht_->num_points(), rgrid);
 
             for (int ir = 0; ir < nmtp; ir++) {
                 for (int itp = 0; itp < sht_->num_points(); itp++) {
                     /* align magnetic filed parallel to magnetization */
-                    /* use vecmagtp as temporary vector */
                     double mag =  rho_up_tp(itp, ir) - rho_dn_tp(itp, ir);
                     if (mag > 1e-8) {
                         /* |Bxc| = 0.5 * (V_up - V_dn) */
                         double b = 0.5 * (vxc_up_tp(itp, ir) - vxc_dn_tp(itp, ir));
                         for (int j = 0; j < ctx_.num_mag_dims(); j++) {
-                            vecmagtp[j](itp, ir) = b * vecmagtp[j](itp, ir) / mag;
+                            bxc_tp[j](itp, ir) = b * rho_mag_tp[1 + j](itp, ir) / mag;
                         }
                     } else {
                         for (int j = 0; j < ctx_.num_mag_dims(); j++) {
-                            vecmagtp[j](itp, ir) = 0.0;
+                            bxc_tp[j](itp, ir) = 0.0;
                         }
                     }
                     /* Vxc = 0.5 * (V_up + V_dn) */
@@ -435,8 +417,9 @@ inline void Potential::xc_mt(Density const& density__)
             /* z, x, y order */
             std::array<int, 3> comp_map = {2, 0, 1};
             /* convert magnetic field back to Rlm */
+            auto bxc_lm = transform(sht_.get(), bxc_tp);
             for (int j = 0; j < ctx_.num_mag_dims(); j++) {
-                auto bxcrlm = transform(sht_.get(), vecmagtp[j]);
+                auto& bxcrlm = bxc_lm[j];
                 for (int ir = 0; ir < nmtp; ir++) {
                     /* add auxiliary magnetic field antiparallel to starting magnetization */
                     bxcrlm(0, ir) -= aux_bf_(j, ia) * ctx_.unit_cell().atom(ia).vector_field()[comp_map[j]];
@@ -448,8 +431,9 @@ inline void Potential::xc_mt(Density const& density__)
         }
 
         /* forward transform from (theta, phi) to Rlm */
-        auto vxcrlm = transform(sht_.get(), vxc_tp);
-        auto excrlm = transform(sht_.get(), exc_tp);
+        auto vxc_exc_lm = transform(sht_.get(), vxc_exc_tp);
+        auto& vxcrlm = vxc_exc_lm[0];
+        auto& excrlm = vxc_exc_lm[1];
         for (int ir = 0; ir < nmtp; ir++) {
             for (int lm = 0; lm < ctx_.lmmax_pot(); lm++) {
                 xc_potential_->f_mt<index_domain_t::local>(lm, ir, ialoc) = vxcrlm(lm, ir);
@@ -468,6 +452,9 @@ inline void Potential::xc_rg_nonmagnetic(Density const& density__)
 
     bool const use_all_gvec{false};
 
+    /* number of real-space points in one block of the fused XC pipeline */
+    int const block_size{2048};
+
     std::unique_ptr<Gvec> gv_ptr;
     std::unique_ptr<Gvec_partition> gvp_ptr;
     if (use_all_gvec) {
@@ -489,18 +476,11 @@ inline void Potential::xc_rg_nonmagnetic(Density const& density__)
     int num_points = ctx_.fft().local_size();
 
     Smooth_periodic_function<double> rho(ctx_.fft(), gvp);
-    Smooth_periodic_function<double> vsigma(ctx_.fft(), gvp);
-
-    /* we can use this comm for parallelization */
-    //auto& comm = ctx_.gvec().comm_ortho_fft();
-    /* split real-space points between available ranks */
-    //splindex<block> spl_np(num_points, comm.size(), comm.rank());
 
     /* check for negative values */
     double rhomin{0};
+    #pragma omp parallel for reduction(min:rhomin)
     for (int ir = 0; ir < num_points; ir++) {
-
-        //int ir = spl_np[irloc];
         double d = density__.rho().f_rg(ir);
         if (add_pseudo_core__) {
             d += density__.rho_pseudo_core().f_rg(ir);
@@ -527,11 +507,6 @@ inline void Potential::xc_rg_nonmagnetic(Density const& density__)
 
     Smooth_periodic_vector_function<double> grad_rho;
     Smooth_periodic_function<double> lapl_rho;
-    Smooth_periodic_function<double> grad_rho_grad_rho;
-
-    Smooth_periodic_vector_function<double> vsigma_grad_rho;
-
-    Smooth_periodic_function<double> div_vsigma_grad_rho;
 
     if (is_gga) {
         /* use fft_transfrom of the base class (Smooth_periodic_function) */
@@ -551,125 +526,111 @@ inline void Potential::xc_rg_nonmagnetic(Density const& density__)
             grad_rho[x].fft_transform(1);
         }
 
-        /* product of gradients */
-        grad_rho_grad_rho = dot(grad_rho, grad_rho);
-
         if (ctx_.control().print_hash_) {
-            //auto h1 = lapl_rho.hash_f_rg();
-            auto h2 = grad_rho_grad_rho.hash_f_rg();
+            auto h2 = dot(grad_rho, grad_rho).hash_f_rg();
             if (ctx_.comm().rank() == 0) {
-                //utils::print_hash("lapl_rho", h1);
                 utils::print_hash("grad_rho_grad_rho", h2);
             }
         }
-        if (!use_2nd_deriv) {
-            vsigma_grad_rho = Smooth_periodic_vector_function<double>(ctx_.fft(), gvp);
-        }
     }
 
-    mdarray<double, 1> exc_tmp(num_points);
-    exc_tmp.zero();
-
-    mdarray<double, 1> vxc_tmp(num_points);
-    vxc_tmp.zero();
-
-    mdarray<double, 1> vsigma_tmp;
-    if (is_gga) {
-        vsigma_tmp = mdarray<double, 1>(num_points);
-        vsigma_tmp.zero();
-    }
-
-    /* loop over XC functionals */
-    for (auto& ixc: xc_func_) {
-
-        /*
-          I need to split vdw from the parallel section since it involves a fft
-          for each grid point
-        */
-        if (ixc.is_vdw()) {
+    /* van der Waals functionals work on the entire grid (they use FFT internally); their contributions
+     * are computed here and added in the block loop in the order of functionals */
+    std::vector<mdarray<double, 2>> vdw_data(xc_func_.size());
+    for (int i = 0; i < static_cast<int>(xc_func_.size()); i++) {
+        if (xc_func_[i].is_vdw()) {
 #ifdef USE_VDWXC
-            /* Van der Walls correction */
-            std::vector<double> exc_t(num_points, 0.0);
-            std::vector<double> vrho_t(num_points, 0.0);
-            std::vector<double> vsigma_t(num_points, 0.0);
-
-            ixc.get_vdw(&rho.f_rg(0),
-                        &grad_rho_grad_rho.f_rg(0),
-                        &vrho_t[0],
-                        &vsigma_t[0],
-                        &exc_t[0]);
-            #pragma omp parallel for
-            for (int i = 0; i < num_points; i++) {
-                /* add Exc contribution */
-                exc_tmp(i) += exc_t[i];
-
-                /* directly add to Vxc available contributions */
-                //if (use_2nd_deriv) {
-                //    vxc_tmp(spl_np_t[i]) += (vrho_t[i] - 2 * vsigma_t[i] * lapl_rho.f_rg(spl_np_t[i]));
-                //} else {
-                //    vxc_tmp(spl_np_t[i]) += vrho_t[i];
-                //}
-                vxc_tmp(i) += vrho_t[i];
-
-                /* save the sigma derivative */
-                vsigma_tmp(i) += vsigma_t[i];
-            }
+            auto grad_rho_grad_rho = dot(grad_rho, grad_rho);
+            vdw_data[i] = mdarray<double, 2>(num_points, 3, memory_t::host, "vdw_data");
+            vdw_data[i].zero();
+            xc_func_[i].get_vdw(&rho.f_rg(0),
+                                &grad_rho_grad_rho.f_rg(0),
+                                &vdw_data[i](0, 0),
+                                &vdw_data[i](0, 1),
+                                &vdw_data[i](0, 2));
 #else
             TERMINATE("You should not be there since SIRIUS is not compiled with libVDWXC support\n");
 #endif
-        } else {
-#pragma omp parallel
-            {
-                /* split local size between threads */
-                splindex<block> spl_np_t(num_points, omp_get_num_threads(), omp_get_thread_num());
+        }
+    }
 
-                std::vector<double> exc_t(spl_np_t.local_size());
+    /* Fused pipeline: for each block of real-space points compute |grad rho|^2, call the XC functionals,
+     * accumulate Exc, Vxc and vsigma directly in the output functions and, if needed, overwrite the
+     * gradient of the density with vsigma * grad rho. */
+    #pragma omp parallel
+    {
+        std::vector<double> sigma_t(block_size);
+        std::vector<double> exc_t(block_size);
+        std::vector<double> vrho_t(block_size);
+        std::vector<double> vsigma_t(block_size);
+
+        #pragma omp for schedule(static)
+        for (int ib = 0; ib < utils::num_blocks(num_points, block_size); ib++) {
+            int i0 = ib * block_size;
+            int n  = std::min(block_size, num_points - i0);
+
+            double* exc = &xc_energy_density_->f_rg(i0);
+            double* vxc = &xc_potential_->f_rg(i0);
+            double* vsigma{nullptr};
+
+            std::fill(exc, exc + n, 0.0);
+            std::fill(vxc, vxc + n, 0.0);
+
+            if (is_gga) {
+                vsigma = &vsigma_[0]->f_rg(i0);
+                std::fill(vsigma, vsigma + n, 0.0);
+                for (int i = 0; i < n; i++) {
+                    sigma_t[i] = std::pow(grad_rho[0].f_rg(i0 + i), 2) + std::pow(grad_rho[1].f_rg(i0 + i), 2) +
+                                 std::pow(grad_rho[2].f_rg(i0 + i), 2);
+                }
+            }
 
-                /* if this is an LDA functional */
-                if (ixc.is_lda()) {
-                    std::vector<double> vxc_t(spl_np_t.local_size());
+            /* loop over XC functionals */
+            for (int ixc = 0; ixc < static_cast<int>(xc_func_.size()); ixc++) {
+                auto& xcf = xc_func_[ixc];
+                if (xcf.is_vdw()) {
+                    for (int i = 0; i < n; i++) {
+                        /* add Exc contribution */
+                        exc[i] += vdw_data[ixc](i0 + i, 2);
+                        /* directly add to Vxc available contributions */
+                        vxc[i] += vdw_data[ixc](i0 + i, 0);
+                        /* save the sigma derivative */
+                        vsigma[i] += vdw_data[ixc](i0 + i, 1);
+                    }
+                    continue;
+                }
 
-                    ixc.get_lda(spl_np_t.local_size(),
-                                &rho.f_rg(spl_np_t.global_offset()),
-                                &vxc_t[0],
-                                &exc_t[0]);
+                /* if this is an LDA functional */
+                if (xcf.is_lda()) {
+                    xcf.get_lda(n, &rho.f_rg(i0), &vrho_t[0], &exc_t[0]);
 
-                    for (int i = 0; i < spl_np_t.local_size(); i++) {
+                    for (int i = 0; i < n; i++) {
                         /* add Exc contribution */
-                        exc_tmp(spl_np_t[i]) += exc_t[i];
-
+                        exc[i] += exc_t[i];
                         /* directly add to Vxc */
-                        vxc_tmp(spl_np_t[i]) += vxc_t[i];
+                        vxc[i] += vrho_t[i];
                     }
                 }
 
-                if (ixc.is_gga()) {
-                    std::vector<double> vrho_t(spl_np_t.local_size());
-                    std::vector<double> vsigma_t(spl_np_t.local_size());
+                if (xcf.is_gga()) {
+                    xcf.get_gga(n, &rho.f_rg(i0), &sigma_t[0], &vrho_t[0], &vsigma_t[0], &exc_t[0]);
 
-                    ixc.get_gga(spl_np_t.local_size(),
-                                &rho.f_rg(spl_np_t.global_offset()),
-                                &grad_rho_grad_rho.f_rg(spl_np_t.global_offset()),
-                                &vrho_t[0],
-                                &vsigma_t[0],
-                                &exc_t[0]);
-
-                    /* this is the same expression between gga and vdw corrections.
-                     * The functionals are different that's all */
-                    for (int i = 0; i < spl_np_t.local_size(); i++) {
+                    for (int i = 0; i < n; i++) {
                         /* add Exc contribution */
-                        exc_tmp(spl_np_t[i]) += exc_t[i];
-
+                        exc[i] += exc_t[i];
                         /* directly add to Vxc available contributions */
-                        //if (use_2nd_deriv) {
-                        //    vxc_tmp(spl_np_t[i]) += (vrho_t[i] - 2 * vsigma_t[i] * lapl_rho.f_rg(spl_np_t[i]));
-                        //} else {
-                        //    vxc_tmp(spl_np_t[i]) += vrho_t[i];
-                        //}
-                        vxc_tmp(spl_np_t[i]) += vrho_t[i];
-
+                        vxc[i] += vrho_t[i];
                         /* save the sigma derivative */
-                        vsigma_tmp(spl_np_t[i]) += vsigma_t[i];
+                        vsigma[i] += vsigma_t[i];
+                    }
+                }
+            }
+
+            if (is_gga && !use_2nd_deriv) {
+                /* gradient of the density is not needed anymore; replace it by vsigma * grad rho */
+                for (int x: {0, 1, 2}) {
+                    for (int i = 0; i < n; i++) {
+                        grad_rho[x].f_rg(i0 + i) *= vsigma[i];
                     }
                 }
             }
@@ -677,15 +638,10 @@ inline void Potential::xc_rg_nonmagnetic(Density const& density__)
     }
 
     if (is_gga) { /* generic for gga and vdw */
-        /* gather vsigma */
-        //comm.allgather(&vsigma_tmp[0], &vsigma_[0]->f_rg(0), spl_np.global_offset(), spl_np.local_size());
-        #pragma omp parallel for
-        for (int ir = 0; ir < num_points; ir++) {
-            vsigma_[0]->f_rg(ir) = vsigma_tmp[ir];
-            vsigma.f_rg(ir) = vsigma_tmp[ir];
-        }
-
         if (use_2nd_deriv) {
+            Smooth_periodic_function<double> vsigma(ctx_.fft(), gvp);
+            std::copy(&vsigma_[0]->f_rg(0), &vsigma_[0]->f_rg(0) + num_points, &vsigma.f_rg(0));
+
             /* forward transform vsigma to plane-wave domain */
             vsigma.fft_transform(-1);
 
@@ -697,37 +653,33 @@ inline void Potential::xc_rg_nonmagnetic(Density const& density__)
                 grad_vsigma[x].fft_transform(1);
             }
 
-            /* compute scalar product of two gradients */
-            auto grad_vsigma_grad_rho = dot(grad_vsigma, grad_rho);
-
             /* add remaining term to Vxc */
             #pragma omp parallel for
             for (int ir = 0; ir < num_points; ir++) {
-                vxc_tmp(ir) -= 2 * (vsigma.f_rg(ir) * lapl_rho.f_rg(ir) + grad_vsigma_grad_rho.f_rg(ir));
+                double d{0};
+                for (int x: {0, 1, 2}) {
+                    d += grad_vsigma[x].f_rg(ir) * grad_rho[x].f_rg(ir);
+                }
+                xc_potential_->f_rg(ir) -= 2 * (vsigma.f_rg(ir) * lapl_rho.f_rg(ir) + d);
             }
         } else {
+            /* add the divergence of vsigma * grad rho to Vxc one component at a time */
             for (int x: {0, 1, 2}) {
+                /* transform to plane wave domain */
+                grad_rho[x].fft_transform(-1);
+                #pragma omp parallel for schedule(static)
+                for (int igloc = 0; igloc < gvp.gvec().count(); igloc++) {
+                    auto G = gvp.gvec().gvec_cart<index_domain_t::local>(igloc);
+                    grad_rho[x].f_pw_local(igloc) *= double_complex(0, G[x]);
+                }
+                grad_rho[x].fft_transform(1);
+                #pragma omp parallel for schedule(static)
                 for (int ir = 0; ir < num_points; ir++) {
-                    vsigma_grad_rho[x].f_rg(ir) = grad_rho[x].f_rg(ir) * vsigma.f_rg(ir);
+                    xc_potential_->f_rg(ir) -= 2 * grad_rho[x].f_rg(ir);
                 }
-                /* transform to plane wave domain */
-                vsigma_grad_rho[x].fft_transform(-1);
-            }
-            div_vsigma_grad_rho = divergence(vsigma_grad_rho);
-            div_vsigma_grad_rho.fft_transform(-1);
-            for (int ir = 0; ir < num_points; ir++) {
-                vxc_tmp(ir) -= 2 * div_vsigma_grad_rho.f_rg(ir);
             }
         }
     }
-    //comm.allgather(&vxc_tmp[0], &xc_potential_->f_rg(0), spl_np.global_offset(), spl_np.local_size());
-    //comm.allgather(&exc_tmp[0], &xc_energy_density_->f_rg(0), spl_np.global_offset(), spl_np.local_size());
-
-    #pragma omp parallel for
-    for (int ir = 0; ir < num_points; ir++) {
-        xc_energy_density_->f_rg(ir) = exc_tmp(ir);
-        xc_potential_->f_rg(ir) = vxc_tmp(ir);
-    }
 
     if (use_all_gvec) {
         ctx_.fft().dismiss();
@@ -743,6 +695,9 @@ inline void Potential::xc_rg_magnetic(Density const& density__)
 {
     PROFILE("sirius::Potential::xc_rg_magnetic");
 
+    /* number of real-space points in one block of the fused XC pipeline */
+    int const block_size{2048};
+
     bool is_gga = is_gradient_correction();
 
     int num_points = ctx_.fft().local_size();
@@ -753,6 +708,7 @@ inline void Potential::xc_rg_magnetic(Density const& density__)
     utils::timer t1("sirius::Potential::xc_rg_magnetic|up_dn");
     /* compute "up" and "dn" components and also check for negative values of density */
     double rhomin{0};
+    #pragma omp parallel for reduction(min:rhomin)
     for (int ir = 0; ir < num_points; ir++) {
         double mag{0};
         for (int j = 0; j < ctx_.num_mag_dims(); j++) {
@@ -800,9 +756,6 @@ inline void Potential::xc_rg_magnetic(Density const& density__)
     Smooth_periodic_vector_function<double> grad_rho_dn;
     Smooth_periodic_function<double> lapl_rho_up;
     Smooth_periodic_function<double> lapl_rho_dn;
-    Smooth_periodic_function<double> grad_rho_up_grad_rho_up;
-    Smooth_periodic_function<double> grad_rho_up_grad_rho_dn;
-    Smooth_periodic_function<double> grad_rho_dn_grad_rho_dn;
 
     if (is_gga) {
         utils::timer t2("sirius::Potential::xc_rg_magnetic|grad1");
@@ -822,11 +775,6 @@ inline void Potential::xc_rg_magnetic(Density const& density__)
             grad_rho_dn[x].fft_transform(1);
         }
 
-        /* product of gradients */
-        grad_rho_up_grad_rho_up = dot(grad_rho_up, grad_rho_up);
-        grad_rho_up_grad_rho_dn = dot(grad_rho_up, grad_rho_dn);
-        grad_rho_dn_grad_rho_dn = dot(grad_rho_dn, grad_rho_dn);
-
         /* Laplacian in real space */
         lapl_rho_up.fft_transform(1);
         lapl_rho_dn.fft_transform(1);
@@ -835,9 +783,9 @@ inline void Potential::xc_rg_magnetic(Density const& density__)
             auto h1 = lapl_rho_up.hash_f_rg();
             auto h2 = lapl_rho_dn.hash_f_rg();
 
-            auto h3 = grad_rho_up_grad_rho_up.hash_f_rg();
-            auto h4 = grad_rho_up_grad_rho_dn.hash_f_rg();
-            auto h5 = grad_rho_dn_grad_rho_dn.hash_f_rg();
+            auto h3 = dot(grad_rho_up, grad_rho_up).hash_f_rg();
+            auto h4 = dot(grad_rho_up, grad_rho_dn).hash_f_rg();
+            auto h5 = dot(grad_rho_dn, grad_rho_dn).hash_f_rg();
 
             if (ctx_.comm().rank() == 0) {
                 utils::print_hash("lapl_rho_up", h1);
@@ -849,155 +797,161 @@ inline void Potential::xc_rg_magnetic(Density const& density__)
         }
     }
 
-    mdarray<double, 1> exc_tmp(num_points, memory_t::host, "exc_tmp");
-    exc_tmp.zero();
+    /* van der Waals functionals work on the entire grid (they use FFT internally); their contributions
+     * are computed here and added in the block loop in the order of functionals */
+    std::vector<mdarray<double, 2>> vdw_data(xc_func_.size());
+    for (int i = 0; i < static_cast<int>(xc_func_.size()); i++) {
+        if (xc_func_[i].is_vdw()) {
+#ifdef USE_VDWXC
+            auto grad_rho_up_grad_rho_up = dot(grad_rho_up, grad_rho_up);
+            auto grad_rho_dn_grad_rho_dn = dot(grad_rho_dn, grad_rho_dn);
+            vdw_data[i] = mdarray<double, 2>(num_points, 5, memory_t::host, "vdw_data");
+            vdw_data[i].zero();
+            xc_func_[i].get_vdw(&rho_up.f_rg(0),
+                                &rho_dn.f_rg(0),
+                                &grad_rho_up_grad_rho_up.f_rg(0),
+                                &grad_rho_dn_grad_rho_dn.f_rg(0),
+                                &vdw_data[i](0, 0),
+                                &vdw_data[i](0, 1),
+                                &vdw_data[i](0, 2),
+                                &vdw_data[i](0, 3),
+                                &vdw_data[i](0, 4));
+#else
+            TERMINATE("You should not be there since sirius is not compiled with libVDWXC\n");
+#endif
+        }
+    }
 
     mdarray<double, 1> vxc_up_tmp(num_points, memory_t::host, "vxc_up_tmp");
-    vxc_up_tmp.zero();
-
     mdarray<double, 1> vxc_dn_tmp(num_points, memory_t::host, "vxc_dn_dmp");
-    vxc_dn_tmp.zero();
 
-    mdarray<double, 1> vsigma_uu_tmp;
-    mdarray<double, 1> vsigma_ud_tmp;
-    mdarray<double, 1> vsigma_dd_tmp;
+    Smooth_periodic_function<double> vsigma_uu;
+    Smooth_periodic_function<double> vsigma_ud;
+    Smooth_periodic_function<double> vsigma_dd;
 
     if (is_gga) {
-        vsigma_uu_tmp = mdarray<double, 1>(num_points, memory_t::host, "vsigma_uu_tmp");
-        vsigma_uu_tmp.zero();
-
-        vsigma_ud_tmp = mdarray<double, 1>(num_points, memory_t::host, "vsigma_ud_tmp");
-        vsigma_ud_tmp.zero();
-
-        vsigma_dd_tmp = mdarray<double, 1>(num_points, memory_t::host, "vsigma_dd_tmp");
-        vsigma_dd_tmp.zero();
+        vsigma_uu = Smooth_periodic_function<double>(ctx_.fft(), ctx_.gvec_partition());
+        vsigma_ud = Smooth_periodic_function<double>(ctx_.fft(), ctx_.gvec_partition());
+        vsigma_dd = Smooth_periodic_function<double>(ctx_.fft(), ctx_.gvec_partition());
     }
 
     utils::timer t3("sirius::Potential::xc_rg_magnetic|libxc");
-    /* loop over XC functionals */
-    for (auto& ixc: xc_func_) {
-        /* treat vdw correction outside the parallel region because it uses fft
-         * internaly */
-
-        if (ixc.is_vdw()) {
-#ifdef USE_VDWXC
-            std::vector<double> vrho_up_t(num_points, 0.0);
-            std::vector<double> vrho_dn_t(num_points, 0.0);
-            std::vector<double> vsigma_uu_t(num_points, 0.0);
-//            std::vector<double> vsigma_ud_t(num_points, 0.0);
-            std::vector<double> vsigma_dd_t(num_points, 0.0);
-            std::vector<double> exc_t(num_points, 0.0);
-
-            ixc.get_vdw(&rho_up.f_rg(0),
-                        &rho_dn.f_rg(0),
-                        &grad_rho_up_grad_rho_up.f_rg(0),
-                        &grad_rho_dn_grad_rho_dn.f_rg(0),
-                        &vrho_up_t[0],
-                        &vrho_dn_t[0],
-                        &vsigma_uu_t[0],
-                        &vsigma_dd_t[0],
-                        &exc_t[0]);
-
-            #pragma omp parallel for
-            for (int i = 0; i < num_points; i++) {
-                /* add Exc contribution */
-                exc_tmp(i) += exc_t[i];
-
-                /* directly add to Vxc available contributions */
-                vxc_up_tmp(i) += vrho_up_t[i] - 2 * vsigma_uu_t[i] * lapl_rho_up.f_rg(i);
-                vxc_dn_tmp(i) += vrho_dn_t[i] - 2 * vsigma_dd_t[i] * lapl_rho_dn.f_rg(i);
-
-                /* save the sigma derivative */
-                vsigma_uu_tmp(i) += vsigma_uu_t[i];
-                //              vsigma_ud_tmp(i) += vsigma_ud_t[i];
-                vsigma_dd_tmp(i) += vsigma_dd_t[i];
+    /* Fused pipeline: for each block of real-space points compute the products of density gradients,
+     * call the XC functionals and accumulate Exc, Vxc and vsigma directly in the output arrays. */
+    #pragma omp parallel
+    {
+        std::vector<double> sigma_uu_t(block_size);
+        std::vector<double> sigma_ud_t(block_size);
+        std::vector<double> sigma_dd_t(block_size);
+        std::vector<double> exc_t(block_size);
+        std::vector<double> vrho_up_t(block_size);
+        std::vector<double> vrho_dn_t(block_size);
+        std::vector<double> vsigma_uu_t(block_size);
+        std::vector<double> vsigma_ud_t(block_size);
+        std::vector<double> vsigma_dd_t(block_size);
+
+        #pragma omp for schedule(static)
+        for (int ib = 0; ib < utils::num_blocks(num_points, block_size); ib++) {
+            int i0 = ib * block_size;
+            int n  = std::min(block_size, num_points - i0);
+
+            double* exc    = &xc_energy_density_->f_rg(i0);
+            double* vxc_up = &vxc_up_tmp(i0);
+            double* vxc_dn = &vxc_dn_tmp(i0);
+            double* vs_uu{nullptr};
+            double* vs_ud{nullptr};
+            double* vs_dd{nullptr};
+
+            std::fill(exc, exc + n, 0.0);
+            std::fill(vxc_up, vxc_up + n, 0.0);
+            std::fill(vxc_dn, vxc_dn + n, 0.0);
+
+            if (is_gga) {
+                vs_uu = &vsigma_uu.f_rg(i0);
+                vs_ud = &vsigma_ud.f_rg(i0);
+                vs_dd = &vsigma_dd.f_rg(i0);
+                std::fill(vs_uu, vs_uu + n, 0.0);
+                std::fill(vs_ud, vs_ud + n, 0.0);
+                std::fill(vs_dd, vs_dd + n, 0.0);
+                for (int i = 0; i < n; i++) {
+                    double uu{0}, ud{0}, dd{0};
+                    for (int x: {0, 1, 2}) {
+                        double gu = grad_rho_up[x].f_rg(i0 + i);
+                        double gd = grad_rho_dn[x].f_rg(i0 + i);
+                        uu += gu * gu;
+                        ud += gu * gd;
+                        dd += gd * gd;
+                    }
+                    sigma_uu_t[i] = uu;
+                    sigma_ud_t[i] = ud;
+                    sigma_dd_t[i] = dd;
+                }
             }
-#else
-            TERMINATE("You should not be there since sirius is not compiled with libVDWXC\n");
-#endif
-        } else {
-#pragma omp parallel
-            {
-                /* split local size between threads */
-                splindex<block> spl_t(num_points, omp_get_num_threads(), omp_get_thread_num());
 
-                std::vector<double> exc_t(spl_t.local_size());
+            /* loop over XC functionals */
+            for (int ixc = 0; ixc < static_cast<int>(xc_func_.size()); ixc++) {
+                auto& xcf = xc_func_[ixc];
+                if (xcf.is_vdw()) {
+                    auto& v = vdw_data[ixc];
+                    for (int i = 0; i < n; i++) {
+                        int ir = i0 + i;
+                        /* add Exc contribution */
+                        exc[i] += v(ir, 4);
 
-                /* if this is an LDA functional */
-                if (ixc.is_lda()) {
-                    std::vector<double> vxc_up_t(spl_t.local_size());
-                    std::vector<double> vxc_dn_t(spl_t.local_size());
+                        /* directly add to Vxc available contributions */
+                        vxc_up[i] += v(ir, 0) - 2 * v(ir, 2) * lapl_rho_up.f_rg(ir);
+                        vxc_dn[i] += v(ir, 1) - 2 * v(ir, 3) * lapl_rho_dn.f_rg(ir);
 
+                        /* save the sigma derivative */
+                        vs_uu[i] += v(ir, 2);
+                        vs_dd[i] += v(ir, 3);
+                    }
+                    continue;
+                }
 
-                    ixc.get_lda(spl_t.local_size(),
-                                &rho_up.f_rg(spl_t.global_offset()),
-                                &rho_dn.f_rg(spl_t.global_offset()),
-                                &vxc_up_t[0],
-                                &vxc_dn_t[0],
-                                &exc_t[0]);
+                /* if this is an LDA functional */
+                if (xcf.is_lda()) {
+                    xcf.get_lda(n, &rho_up.f_rg(i0), &rho_dn.f_rg(i0), &vrho_up_t[0], &vrho_dn_t[0], &exc_t[0]);
 
-                    for (int i = 0; i < spl_t.local_size(); i++) {
+                    for (int i = 0; i < n; i++) {
                         /* add Exc contribution */
-                        exc_tmp(spl_t[i]) += exc_t[i];
+                        exc[i] += exc_t[i];
 
                         /* directly add to Vxc */
-                        vxc_up_tmp(spl_t[i]) += vxc_up_t[i];
-                        vxc_dn_tmp(spl_t[i]) += vxc_dn_t[i];
+                        vxc_up[i] += vrho_up_t[i];
+                        vxc_dn[i] += vrho_dn_t[i];
                     }
                 }
 
-                if (ixc.is_gga()) {
-                    std::vector<double> vrho_up_t(spl_t.local_size());
-                    std::vector<double> vrho_dn_t(spl_t.local_size());
-                    std::vector<double> vsigma_uu_t(spl_t.local_size());
-                    std::vector<double> vsigma_ud_t(spl_t.local_size());
-                    std::vector<double> vsigma_dd_t(spl_t.local_size());
-
-                    ixc.get_gga(spl_t.local_size(),
-                                &rho_up.f_rg(spl_t.global_offset()),
-                                &rho_dn.f_rg(spl_t.global_offset()),
-                                &grad_rho_up_grad_rho_up.f_rg(spl_t.global_offset()),
-                                &grad_rho_up_grad_rho_dn.f_rg(spl_t.global_offset()),
-                                &grad_rho_dn_grad_rho_dn.f_rg(spl_t.global_offset()),
-                                &vrho_up_t[0],
-                                &vrho_dn_t[0],
-                                &vsigma_uu_t[0],
-                                &vsigma_ud_t[0],
-                                &vsigma_dd_t[0],
-                                &exc_t[0]);
+                if (xcf.is_gga()) {
+                    xcf.get_gga(n, &rho_up.f_rg(i0), &rho_dn.f_rg(i0), &sigma_uu_t[0], &sigma_ud_t[0],
+                                &sigma_dd_t[0], &vrho_up_t[0], &vrho_dn_t[0], &vsigma_uu_t[0], &vsigma_ud_t[0],
+                                &vsigma_dd_t[0], &exc_t[0]);
 
-                    #pragma omp parallel for
-                    for (int i = 0; i < spl_t.local_size(); i++) {
+                    for (int i = 0; i < n; i++) {
+                        int ir = i0 + i;
                         /* add Exc contribution */
-                        exc_tmp(spl_t[i]) += exc_t[i];
+                        exc[i] += exc_t[i];
 
                         /* directly add to Vxc available contributions */
-                        vxc_up_tmp(spl_t[i]) += (vrho_up_t[i] - 2 * vsigma_uu_t[i] * lapl_rho_up.f_rg(spl_t[i]) - vsigma_ud_t[i] * lapl_rho_dn.f_rg(spl_t[i]));
-                        vxc_dn_tmp(spl_t[i]) += (vrho_dn_t[i] - 2 * vsigma_dd_t[i] * lapl_rho_dn.f_rg(spl_t[i]) - vsigma_ud_t[i] * lapl_rho_up.f_rg(spl_t[i]));
+                        vxc_up[i] += (vrho_up_t[i] - 2 * vsigma_uu_t[i] * lapl_rho_up.f_rg(ir) -
+                                      vsigma_ud_t[i] * lapl_rho_dn.f_rg(ir));
+                        vxc_dn[i] += (vrho_dn_t[i] - 2 * vsigma_dd_t[i] * lapl_rho_dn.f_rg(ir) -
+                                      vsigma_ud_t[i] * lapl_rho_up.f_rg(ir));
 
                         /* save the sigma derivative */
-                        vsigma_uu_tmp(spl_t[i]) += vsigma_uu_t[i];
-                        vsigma_ud_tmp(spl_t[i]) += vsigma_ud_t[i];
-                        vsigma_dd_tmp(spl_t[i]) += vsigma_dd_t[i];
+                        vs_uu[i] += vsigma_uu_t[i];
+                        vs_ud[i] += vsigma_ud_t[i];
+                        vs_dd[i] += vsigma_dd_t[i];
                     }
                 }
             }
         }
-        t3.stop();
     }
+    t3.stop();
 
     if (is_gga) {
         utils::timer t4("sirius::Potential::xc_rg_magnetic|grad2");
-        /* gather vsigma */
-        Smooth_periodic_function<double> vsigma_uu(ctx_.fft(), ctx_.gvec_partition());
-        Smooth_periodic_function<double> vsigma_ud(ctx_.fft(), ctx_.gvec_partition());
-        Smooth_periodic_function<double> vsigma_dd(ctx_.fft(), ctx_.gvec_partition());
-        for (int ir = 0; ir < num_points; ir++) {
-            vsigma_uu.f_rg(ir) = vsigma_uu_tmp[ir];
-            vsigma_ud.f_rg(ir) = vsigma_ud_tmp[ir];
-            vsigma_dd.f_rg(ir) = vsigma_dd_tmp[ir];
-        }
-
         /* forward transform vsigma to plane-wave domain */
         vsigma_uu.fft_transform(-1);
         vsigma_ud.fft_transform(-1);
@@ -1015,23 +969,23 @@ inline void Potential::xc_rg_magnetic(Density const& density__)
             grad_vsigma_dd[x].fft_transform(1);
         }
 
-        /* compute scalar product of two gradients */
-        auto grad_vsigma_uu_grad_rho_up = dot(grad_vsigma_uu, grad_rho_up);
-        auto grad_vsigma_dd_grad_rho_dn = dot(grad_vsigma_dd, grad_rho_dn);
-        auto grad_vsigma_ud_grad_rho_up = dot(grad_vsigma_ud, grad_rho_up);
-        auto grad_vsigma_ud_grad_rho_dn = dot(grad_vsigma_ud, grad_rho_dn);
-
-        /* add remaining term to Vxc */
-        #pragma omp parallel for
+        /* add remaining term to Vxc; scalar products of the gradients are computed on the fly */
+        #pragma omp parallel for schedule(static)
         for (int ir = 0; ir < num_points; ir++) {
-            vxc_up_tmp(ir) -= (2 * grad_vsigma_uu_grad_rho_up.f_rg(ir) + grad_vsigma_ud_grad_rho_dn.f_rg(ir));
-            vxc_dn_tmp(ir) -= (2 * grad_vsigma_dd_grad_rho_dn.f_rg(ir) + grad_vsigma_ud_grad_rho_up.f_rg(ir));
+            double uu_up{0}, dd_dn{0}, ud_up{0}, ud_dn{0};
+            for (int x: {0, 1, 2}) {
+                uu_up += grad_vsigma_uu[x].f_rg(ir) * grad_rho_up[x].f_rg(ir);
+                dd_dn += grad_vsigma_dd[x].f_rg(ir) * grad_rho_dn[x].f_rg(ir);
+                ud_up += grad_vsigma_ud[x].f_rg(ir) * grad_rho_up[x].f_rg(ir);
+                ud_dn += grad_vsigma_ud[x].f_rg(ir) * grad_rho_dn[x].f_rg(ir);
+            }
+            vxc_up_tmp(ir) -= (2 * uu_up + ud_dn);
+            vxc_dn_tmp(ir) -= (2 * dd_dn + ud_up);
         }
     }
 
     #pragma omp parallel for
     for (int irloc = 0; irloc < num_points; irloc++) {
-        xc_energy_density_->f_rg(irloc) = exc_tmp(irloc);
         xc_potential_->f_rg(irloc) = 0.5 * (vxc_up_tmp(irloc) + vxc_dn_tmp(irloc));
         double m = rho_up.f_rg(irloc) - rho_dn.f_rg(irloc);
 
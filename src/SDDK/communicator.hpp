@@ -223,15 +223,95 @@ struct block_data_descriptor
     }
 };
 
+/// Handler of the non-blocking communication.
 class Request
 {
   private:
-    MPI_Request handler_;
+    MPI_Request handler_{MPI_REQUEST_NULL};
   public:
     ~Request()
     {
         //CALL_MPI(MPI_Request_free, (&handler_));
     }
+
+    /// Wait for the completion of the operation.
+    void wait()
+    {
+        CALL_MPI(MPI_Wait, (&handler_, MPI_STATUS_IGNORE));
+    }
+
+    /// Return true if the operation is completed.
+    bool test()
+    {
+        int flag;
+        CALL_MPI(MPI_Test, (&handler_, &flag, MPI_STATUS_IGNORE));
+        return flag;
+    }
+
+    MPI_Request& handler()
+    {
+        return handler_;
+    }
+};
+
+/// Handler of the persistent communication.
+/** The operation is set up once and can be started many times; each start() must be completed by wait() before
+ *  the next start(). With MPI-4 the native persistent collectives are used, otherwise start() posts the
+ *  equivalent non-blocking operation. Buffers must stay valid for the lifetime of the request. */
+class Persistent_request
+{
+  private:
+    MPI_Request handler_{MPI_REQUEST_NULL};
+    /// Posting of the non-blocking operation if native persistent request is not available.
+    std::function<void(MPI_Request*)> start_;
+  public:
+    Persistent_request()
+    {
+    }
+
+    explicit Persistent_request(std::function<void(MPI_Request*)> start__)
+        : start_(start__)
+    {
+    }
+
+    Persistent_request(Persistent_request const& src__) = delete;
+
+    Persistent_request(Persistent_request&& src__)
+        : handler_(src__.handler_)
+        , start_(std::move(src__.start_))
+    {
+        src__.handler_ = MPI_REQUEST_NULL;
+    }
+
+    Persistent_request& operator=(Persistent_request&& src__)
+    {
+        if (this != &src__) {
+            std::swap(handler_, src__.handler_);
+            std::swap(start_, src__.start_);
+        }
+        return *this;
+    }
+
+    ~Persistent_request()
+    {
+        int mpi_finalized_flag;
+        MPI_Finalized(&mpi_finalized_flag);
+        if (!start_ && handler_ != MPI_REQUEST_NULL && !mpi_finalized_flag) {
+            CALL_MPI(MPI_Request_free, (&handler_));
+        }
+    }
+
+    /// Start the operation.
+    void start()
+    {
+        if (start_) {
+            start_(&handler_);
+        } else {
+            CALL_MPI(MPI_Start, (&handler_));
+        }
+    }
+
+    /// Wait for the completion of the operation.
     void wait()
     {
         CALL_MPI(MPI_Wait, (&handler_, MPI_STATUS_IGNORE));
@@ -243,6 +323,11 @@ class Request
     }
 };
 
+/// True if MPI library provides persistent collective operations (MPI-4).
+#if defined(MPI_VERSION) && (MPI_VERSION >= 4)
+#define __MPI_PERSISTENT_COLL
+#endif
+
 struct mpi_comm_deleter
 {
     void operator()(MPI_Comm* comm__) const
@@ -514,6 +599,34 @@ class Communicator
                                   mpi_op_wrapper<mpi_op__>::kind(), mpi_comm(), req__));
     }
 
+    /// Non-blocking in-place all-to-all reduction.
+    template <typename T, mpi_op_t mpi_op__ = mpi_op_t::sum>
+    inline Request iallreduce(T* buffer__, int count__) const
+    {
+        Request req;
+        iallreduce<T, mpi_op__>(buffer__, count__, &req.handler());
+        return std::move(req);
+    }
+
+    /// Persistent in-place all-to-all reduction.
+    template <typename T, mpi_op_t mpi_op__ = mpi_op_t::sum>
+    inline Persistent_request allreduce_init(T* buffer__, int count__) const
+    {
+#if defined(__MPI_PERSISTENT_COLL)
+        Persistent_request req;
+        CALL_MPI(MPI_Allreduce_init, (MPI_IN_PLACE, buffer__, count__, mpi_type_wrapper<T>::kind(),
+                                      mpi_op_wrapper<mpi_op__>::kind(), mpi_comm(), MPI_INFO_NULL, &req.handler()));
+        return std::move(req);
+#else
+        auto comm = mpi_comm();
+        return Persistent_request([=](MPI_Request* req__)
+        {
+            CALL_MPI(MPI_Iallreduce, (MPI_IN_PLACE, buffer__, count__, mpi_type_wrapper<T>::kind(),
+                                      mpi_op_wrapper<mpi_op__>::kind(), comm, req__));
+        });
+#endif
+    }
+
     /// Perform buffer broadcast.
     template <typename T>
     inline void bcast(T* buffer__, int count__, int root__) const
@@ -524,6 +637,36 @@ class Communicator
         CALL_MPI(MPI_Bcast, (buffer__, count__, mpi_type_wrapper<T>::kind(), root__, mpi_comm()));
     }
 
+    /// Non-blocking buffer broadcast.
+    template <typename T>
+    inline Request ibcast(T* buffer__, int count__, int root__) const
+    {
+        Request req;
+#if defined(__PROFILE_MPI)
+        PROFILE("MPI_Ibcast");
+#endif
+        CALL_MPI(MPI_Ibcast, (buffer__, count__, mpi_type_wrapper<T>::kind(), root__, mpi_comm(), &req.handler()));
+        return std::move(req);
+    }
+
+    /// Persistent buffer broadcast.
+    template <typename T>
+    inline Persistent_request bcast_init(T* buffer__, int count__, int root__) const
+    {
+#if defined(__MPI_PERSISTENT_COLL)
+        Persistent_request req;
+        CALL_MPI(MPI_Bcast_init, (buffer__, count__, mpi_type_wrapper<T>::kind(), root__, mpi_comm(), MPI_INFO_NULL,
+                                  &req.handler()));
+        return std::move(req);
+#else
+        auto comm = mpi_comm();
+        return Persistent_request([=](MPI_Request* req__)
+        {
+            CALL_MPI(MPI_Ibcast, (buffer__, count__, mpi_type_wrapper<T>::kind(), root__, comm, req__));
+        });
+#endif
+    }
+
     inline void bcast(std::string& str__, int root__) const
     {
         int sz;
@@ -551,6 +694,39 @@ class Communicator
                                   mpi_type_wrapper<T>::kind(), mpi_comm()));
     }
 
+    /// Non-blocking in-place MPI_Allgatherv.
+    /** Count and displacement arrays must stay valid until the request is completed. */
+    template <typename T>
+    Request iallgather(T* buffer__, int const* recvcounts__, int const* displs__) const
+    {
+        Request req;
+#if defined(__PROFILE_MPI)
+        PROFILE("MPI_Iallgatherv");
+#endif
+        CALL_MPI(MPI_Iallgatherv, (MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, buffer__, recvcounts__, displs__,
+                                   mpi_type_wrapper<T>::kind(), mpi_comm(), &req.handler()));
+        return std::move(req);
+    }
+
+    /// Persistent in-place MPI_Allgatherv.
+    template <typename T>
+    Persistent_request allgather_init(T* buffer__, int const* recvcounts__, int const* displs__) const
+    {
+#if defined(__MPI_PERSISTENT_COLL)
+        Persistent_request req;
+        CALL_MPI(MPI_Allgatherv_init, (MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, buffer__, recvcounts__, displs__,
+                                       mpi_type_wrapper<T>::kind(), mpi_comm(), MPI_INFO_NULL, &req.handler()));
+        return std::move(req);
+#else
+        auto comm = mpi_comm();
+        return Persistent_request([=](MPI_Request* req__)
+        {
+            CALL_MPI(MPI_Iallgatherv, (MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, buffer__, recvcounts__, displs__,
+                                       mpi_type_wrapper<T>::kind(), comm, req__));
+        });
+#endif
+    }
+
     /// Out-of-place MPI_Allgatherv.
     template <typename T>
     void
@@ -721,6 +897,64 @@ class Communicator
                                  recvcounts__, rdispls__, mpi_type_wrapper<T>::kind(), mpi_comm()));
     }
 
+    /// Non-blocking MPI_Alltoallv.
+    /** Buffers and count / displacement arrays must stay valid until the request is completed. */
+    template <typename T>
+    void ialltoall(T const* sendbuf__,
+                   int const* sendcounts__,
+                   int const* sdispls__,
+                   T* recvbuf__,
+                   int const* recvcounts__,
+                   int const* rdispls__,
+                   MPI_Request* req__) const
+    {
+#if defined(__PROFILE_MPI)
+        PROFILE("MPI_Ialltoallv");
+#endif
+        CALL_MPI(MPI_Ialltoallv, (sendbuf__, sendcounts__, sdispls__, mpi_type_wrapper<T>::kind(), recvbuf__,
+                                  recvcounts__, rdispls__, mpi_type_wrapper<T>::kind(), mpi_comm(), req__));
+    }
+
+    /// Non-blocking MPI_Alltoallv.
+    /** Buffers and count / displacement arrays must stay valid until the request is completed. */
+    template <typename T>
+    Request ialltoall(T const* sendbuf__,
+                      int const* sendcounts__,
+                      int const* sdispls__,
+                      T* recvbuf__,
+                      int const* recvcounts__,
+                      int const* rdispls__) const
+    {
+        Request req;
+        ialltoall(sendbuf__, sendcounts__, sdispls__, recvbuf__, recvcounts__, rdispls__, &req.handler());
+        return std::move(req);
+    }
+
+    /// Persistent MPI_Alltoallv.
+    template <typename T>
+    Persistent_request alltoall_init(T const* sendbuf__,
+                                     int const* sendcounts__,
+                                     int const* sdispls__,
+                                     T* recvbuf__,
+                                     int const* recvcounts__,
+                                     int const* rdispls__) const
+    {
+#if defined(__MPI_PERSISTENT_COLL)
+        Persistent_request req;
+        CALL_MPI(MPI_Alltoallv_init, (sendbuf__, sendcounts__, sdispls__, mpi_type_wrapper<T>::kind(), recvbuf__,
+                                      recvcounts__, rdispls__, mpi_type_wrapper<T>::kind(), mpi_comm(),
+                                      MPI_INFO_NULL, &req.handler()));
+        return std::move(req);
+#else
+        auto comm = mpi_comm();
+        return Persistent_request([=](MPI_Request* req__)
+        {
+            CALL_MPI(MPI_Ialltoallv, (sendbuf__, sendcounts__, sdispls__, mpi_type_wrapper<T>::kind(), recvbuf__,
+                                      recvcounts__, rdispls__, mpi_type_wrapper<T>::kind(), comm, req__));
+        });
+#endif
+    }
+
     //==alltoall_descriptor map_alltoall(std::vector<int> local_sizes_in, std::vector<int> local_sizes_out) const
     //=={
     //==    alltoall_descriptor a2a;
@@ -853,6 +853,12 @@ class FFT3D : public FFT3D_grid
         return offset_z_;
     }
 
+    /// Distribution of z-planes between ranks.
+    inline splindex<block> const& spl_z() const
+    {
+        return spl_z_;
+    }
+
     /// Direct access to the FFT buffer
     inline double_complex& buffer(int idx__)
     {
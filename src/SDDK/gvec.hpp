@@ -26,6 +26,7 @@
 #define __GVEC_HPP__
 
 #include <numeric>
+#include <algorithm>
 #include <map>
 #include <iostream>
 #include <assert.h>
@@ -1354,6 +1355,159 @@ struct remap_gvec_to_shells
     }
 };
 
+/// Mapping between the local G-vectors of SIRIUS and an external (caller-provided) list of G-vectors.
+/** The external list is distributed over the ranks of an external communicator which must contain the same set
+ *  of ranks as the communicator of G-vectors. The communication plan is computed once; the coefficients are then
+ *  exchanged with a single alltoallv call without the intermediate global arrays. G-vectors of the external list
+ *  which are missing in the reduced set are taken as \f$ -{\bf G} \f$ with the complex conjugated coefficient;
+ *  G-vectors which are not found at all are skipped (zero is returned for them). */
+class remap_gvec_to_external
+{
+  private:
+    /// External communicator.
+    Communicator comm_;
+
+    /// G-vectors of SIRIUS.
+    Gvec const& gvec_;
+
+    /// Number of G-vectors in the local part of the external list.
+    int num_gvec_ext_;
+
+    /// Sending side of the plan (external list to SIRIUS distribution).
+    block_data_descriptor a2a_send_;
+
+    /// Receiving side of the plan.
+    block_data_descriptor a2a_recv_;
+
+    /// Index of the external G-vector for each element of the send buffer.
+    std::vector<int> idx_ext_;
+
+    /// True if the coefficient has to be complex conjugated.
+    std::vector<bool> conj_ext_;
+
+    /// Local index of the SIRIUS G-vector for each element of the receive buffer.
+    std::vector<int> idx_loc_;
+
+  public:
+    remap_gvec_to_external(Communicator&& comm__, Gvec const& gvec__, int num_gvec_ext__, int const* gvec_ext__)
+        : comm_(std::move(comm__))
+        , gvec_(gvec__)
+        , num_gvec_ext_(num_gvec_ext__)
+    {
+        PROFILE("sddk::remap_gvec_to_external|init");
+
+        if (comm_.size() != gvec_.comm().size()) {
+            TERMINATE("external communicator and communicator of G-vectors must have the same size");
+        }
+        /* rank of the external communicator for each rank of the G-vector communicator */
+        std::vector<int> rank_map(comm_.size(), -1);
+        rank_map[comm_.rank()] = gvec_.comm().rank();
+        comm_.allgather(rank_map.data(), comm_.rank(), 1);
+        std::vector<int> ext_rank(comm_.size(), -1);
+        for (int r = 0; r < comm_.size(); r++) {
+            ext_rank[rank_map[r]] = r;
+        }
+
+        std::vector<int> offsets(gvec_.comm().size());
+        for (int r = 0; r < gvec_.comm().size(); r++) {
+            offsets[r] = gvec_.gvec_offset(r);
+        }
+
+        /* find the destination rank and the local index of each external G-vector */
+        std::vector<int> dest(num_gvec_ext_, -1);
+        std::vector<int> igloc(num_gvec_ext_, -1);
+        std::vector<bool> conj(num_gvec_ext_, false);
+        a2a_send_ = block_data_descriptor(comm_.size());
+        for (int i = 0; i < num_gvec_ext_; i++) {
+            vector3d<int> G(&gvec_ext__[3 * i]);
+            int ig = gvec_.index_by_gvec(G);
+            if (ig == -1 && gvec_.reduced()) {
+                ig = gvec_.index_by_gvec(G * (-1));
+                conj[i] = true;
+            }
+            if (ig == -1) {
+                continue;
+            }
+            /* rank of the G-vector communicator which stores this G-vector */
+            int r    = static_cast<int>(std::upper_bound(offsets.begin(), offsets.end(), ig) - offsets.begin()) - 1;
+            dest[i]  = ext_rank[r];
+            igloc[i] = ig - offsets[r];
+            a2a_send_.counts[dest[i]]++;
+        }
+        a2a_send_.calc_offsets();
+
+        /* order the external G-vectors by destination */
+        idx_ext_  = std::vector<int>(a2a_send_.size());
+        conj_ext_ = std::vector<bool>(a2a_send_.size());
+        std::vector<int> idx_send(a2a_send_.size());
+        std::vector<int> counts(comm_.size(), 0);
+        for (int i = 0; i < num_gvec_ext_; i++) {
+            if (dest[i] >= 0) {
+                int j        = a2a_send_.offsets[dest[i]] + counts[dest[i]]++;
+                idx_ext_[j]  = i;
+                conj_ext_[j] = conj[i];
+                idx_send[j]  = igloc[i];
+            }
+        }
+
+        /* exchange the counts and send the local indices of G-vectors to their owners */
+        a2a_recv_ = block_data_descriptor(comm_.size());
+        comm_.alltoall(a2a_send_.counts.data(), 1, a2a_recv_.counts.data(), 1);
+        a2a_recv_.calc_offsets();
+
+        idx_loc_ = std::vector<int>(a2a_recv_.size());
+        comm_.alltoall(idx_send.data(), a2a_send_.counts.data(), a2a_send_.offsets.data(), idx_loc_.data(),
+                       a2a_recv_.counts.data(), a2a_recv_.offsets.data());
+    }
+
+    /// Number of G-vectors in the local part of the external list.
+    inline int num_gvec_ext() const
+    {
+        return num_gvec_ext_;
+    }
+
+    /// Get the coefficients of the external G-vectors from the local part of SIRIUS coefficients.
+    template <typename T>
+    void remap_forward(T const* data__, T* data_ext__) const
+    {
+        PROFILE("sddk::remap_gvec_to_external|remap_forward");
+
+        std::vector<T> send_buf(a2a_recv_.size());
+        for (int i = 0; i < a2a_recv_.size(); i++) {
+            send_buf[i] = data__[idx_loc_[i]];
+        }
+        std::vector<T> recv_buf(a2a_send_.size());
+        comm_.alltoall(send_buf.data(), a2a_recv_.counts.data(), a2a_recv_.offsets.data(), recv_buf.data(),
+                       a2a_send_.counts.data(), a2a_send_.offsets.data());
+
+        std::fill(data_ext__, data_ext__ + num_gvec_ext_, T(0));
+        for (int i = 0; i < a2a_send_.size(); i++) {
+            data_ext__[idx_ext_[i]] = conj_ext_[i] ? std::conj(recv_buf[i]) : recv_buf[i];
+        }
+    }
+
+    /// Set the local part of SIRIUS coefficients from the coefficients of the external G-vectors.
+    /** Coefficients of the G-vectors which are not in the external list are set to zero. */
+    template <typename T>
+    void remap_backward(T const* data_ext__, T* data__) const
+    {
+        PROFILE("sddk::remap_gvec_to_external|remap_backward");
+
+        std::vector<T> send_buf(a2a_send_.size());
+        for (int i = 0; i < a2a_send_.size(); i++) {
+            send_buf[i] = conj_ext_[i] ? std::conj(data_ext__[idx_ext_[i]]) : data_ext__[idx_ext_[i]];
+        }
+        std::vector<T> recv_buf(a2a_recv_.size());
+        comm_.alltoall(send_buf.data(), a2a_send_.counts.data(), a2a_send_.offsets.data(), recv_buf.data(),
+                       a2a_recv_.counts.data(), a2a_recv_.offsets.data());
+
+        std::fill(data__, data__ + gvec_.count(), T(0));
+        for (int i = 0; i < a2a_recv_.size(); i++) {
+            data__[idx_loc_[i]] = recv_buf[i];
+        }
+    }
+};
+
 } // namespace sddk
 
 #endif //__GVEC_HPP__
@@ -67,6 +67,10 @@ class linalg2
     /// Inversion of a triangular matrix.
     template <typename T>
     inline int trtri(ftn_int n, T* A, ftn_int lda, ftn_int const* desca = nullptr);
+
+    /// QR factorization of a general matrix; on exit the upper triangle of A contains R.
+    template <typename T>
+    inline int geqrf(ftn_int m, ftn_int n, T* A, ftn_int lda);
 };
 
 template <>
@@ -415,6 +419,54 @@ inline int linalg2::trtri<ftn_double_complex>(ftn_int n, ftn_double_complex* A,
     return -1;
 }
 
+template <>
+inline int linalg2::geqrf<ftn_double>(ftn_int m, ftn_int n, ftn_double* A, ftn_int lda)
+{
+    switch (la_) {
+        case linalg_t::lapack: {
+            ftn_int lwork = -1;
+            ftn_double z;
+            ftn_int info;
+            FORTRAN(dgeqrf)(&m, &n, A, &lda, &z, &z, &lwork, &info);
+            lwork = static_cast<int>(z + 1);
+            std::vector<ftn_double> work(lwork);
+            std::vector<ftn_double> tau(std::max(1, std::min(m, n)));
+            FORTRAN(dgeqrf)(&m, &n, A, &lda, tau.data(), work.data(), &lwork, &info);
+            return info;
+            break;
+        }
+        default: {
+            throw std::runtime_error("wrong type of linear algebra library");
+            break;
+        }
+    }
+    return -1;
+}
+
+template <>
+inline int linalg2::geqrf<ftn_double_complex>(ftn_int m, ftn_int n, ftn_double_complex* A, ftn_int lda)
+{
+    switch (la_) {
+        case linalg_t::lapack: {
+            ftn_int lwork = -1;
+            ftn_double_complex z;
+            ftn_int info;
+            FORTRAN(zgeqrf)(&m, &n, A, &lda, &z, &z, &lwork, &info);
+            lwork = static_cast<int>(z.real() + 1);
+            std::vector<ftn_double_complex> work(lwork);
+            std::vector<ftn_double_complex> tau(std::max(1, std::min(m, n)));
+            FORTRAN(zgeqrf)(&m, &n, A, &lda, tau.data(), work.data(), &lwork, &info);
+            return info;
+            break;
+        }
+        default: {
+            throw std::runtime_error("wrong type of linear algebra library");
+            break;
+        }
+    }
+    return -1;
+}
+
 /// Conjugate transponse of the sub-matrix.
 /** \param [in] m Number of rows of the target sub-matrix.
  *  \param [in] n Number of columns of the target sub-matrix.
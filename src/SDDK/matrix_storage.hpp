@@ -78,6 +78,16 @@ class matrix_storage<T, matrix_storage_t::slab>
     /// Column distribution in auxiliary matrix.
     splindex<block> spl_num_col_;
 
+    /// Send and receive layouts of the pending non-blocking remap.
+    block_data_descriptor remap_sd_;
+    block_data_descriptor remap_rd_;
+
+    /// Request handler of the pending non-blocking remap.
+    MPI_Request remap_req_;
+
+    /// True if remap_forward_begin() was called and remap_forward_end() was not called yet.
+    bool remap_pending_{false};
+
   public:
     /// Constructor.
     matrix_storage(Gvec_partition const& gvp__, int num_cols__)
@@ -184,6 +194,19 @@ class matrix_storage<T, matrix_storage_t::slab>
     {
         PROFILE("sddk::matrix_storage::remap_forward");
 
+        remap_forward_begin(n__, idx0__, mp__);
+        remap_forward_end();
+    }
+
+    /// Start the non-blocking remap from prime to extra storage.
+    /** The extra storage can't be used before remap_forward_end() is called. This allows to overlap the
+     *  communication with the computation on other data (e.g. the FFTs of another k-point). */
+    inline void remap_forward_begin(int n__, int idx0__, memory_pool* mp__)
+    {
+        PROFILE("sddk::matrix_storage::remap_forward_begin");
+
+        assert(!remap_pending_);
+
         set_num_extra(n__, idx0__, mp__);
 
         /* trivial case when extra storage mirrors the prime storage */
@@ -195,24 +218,43 @@ class matrix_storage<T, matrix_storage_t::slab>
 
         auto& comm_col = gvp_->comm_ortho_fft();
 
-        /* local number of columns */
-        int n_loc = spl_num_col_.local_size();
-
         /* send and recieve dimensions */
-        block_data_descriptor sd(comm_col.size()), rd(comm_col.size());
+        remap_sd_ = block_data_descriptor(comm_col.size());
+        remap_rd_ = block_data_descriptor(comm_col.size());
         for (int j = 0; j < comm_col.size(); j++) {
-            sd.counts[j] = spl_num_col_.local_size(j) * row_distr.counts[comm_col.rank()];
-            rd.counts[j] = spl_num_col_.local_size(comm_col.rank()) * row_distr.counts[j];
+            remap_sd_.counts[j] = spl_num_col_.local_size(j) * row_distr.counts[comm_col.rank()];
+            remap_rd_.counts[j] = spl_num_col_.local_size(comm_col.rank()) * row_distr.counts[j];
         }
-        sd.calc_offsets();
-        rd.calc_offsets();
+        remap_sd_.calc_offsets();
+        remap_rd_.calc_offsets();
 
         T* send_buf = (num_rows_loc_ == 0) ? nullptr : prime_.at(memory_t::host, 0, idx0__);
 
+        comm_col.ialltoall(send_buf, remap_sd_.counts.data(), remap_sd_.offsets.data(), send_recv_buf_.at(memory_t::host),
+                           remap_rd_.counts.data(), remap_rd_.offsets.data(), &remap_req_);
+        remap_pending_ = true;
+    }
+
+    /// Complete the remap started by remap_forward_begin().
+    inline void remap_forward_end()
+    {
+        PROFILE("sddk::matrix_storage::remap_forward_end");
+
+        if (!remap_pending_) {
+            return;
+        }
+
         utils::timer t1("sddk::matrix_storage::remap_forward|mpi");
-        comm_col.alltoall(send_buf, sd.counts.data(), sd.offsets.data(), send_recv_buf_.at(memory_t::host),
-                          rd.counts.data(), rd.offsets.data());
+        CALL_MPI(MPI_Wait, (&remap_req_, MPI_STATUS_IGNORE));
         t1.stop();
+        remap_pending_ = false;
+
+        auto& row_distr = gvp_->gvec_fft_slab();
+
+        auto& comm_col = gvp_->comm_ortho_fft();
+
+        /* local number of columns */
+        int n_loc = spl_num_col_.local_size();
 
         /* reorder recieved blocks */
         #pragma omp parallel for
@@ -171,7 +171,45 @@ inline void inner(memory_t        mem__,
                    ngop * m__ * n__ * k / time, m__, n__, k, time);
         }
         return;
-    } else if (result__.comm().size() == 1) { /* parallel wave-functions distribution but sequential diagonalization */
+    } else if (result__.comm().size() == 1 && is_host_memory(mem__)) { /* parallel wave-functions distribution but
+                                                                           sequential diagonalization */
+        /* the reduction of each panel of columns proceeds in the background while the next panel is computed */
+        int nb = std::max(1, std::min(n__, sddk_block_size));
+        int np = utils::num_blocks(n__, nb);
+
+        mdarray<T, 2> tmp(m__, n__);
+        std::vector<Request> req(np);
+        for (int ip = 0; ip < np; ip++) {
+            int j0 = ip * nb;
+            int ncol = std::min(nb, n__ - j0);
+            inner_local<T>(mem__, la__, ispn__, bra__, i0__, m__, ket__, j0__ + j0, ncol, &beta,
+                           tmp.at(memory_t::host, 0, j0), m__, stream_id(-1));
+            req[ip] = comm.iallreduce(tmp.at(memory_t::host, 0, j0), m__ * ncol);
+        }
+        for (int ip = 0; ip < np; ip++) {
+            int j0 = ip * nb;
+            int ncol = std::min(nb, n__ - j0);
+            utils::timer t1("sddk::inner|mpi");
+            req[ip].wait();
+            t1.stop();
+            utils::timer t2("sddk::inner|store");
+            #pragma omp parallel for schedule(static)
+            for (int j = j0; j < j0 + ncol; j++) {
+                for (int i = 0; i < m__; i++) {
+                    result__(irow0__ + i, jcol0__ + j) = tmp(i, j);
+                }
+            }
+        }
+        if (sddk_pp) {
+            time += omp_get_wtime();
+            int k = bra__.gkvec().num_gvec() + bra__.num_mt_coeffs();
+            if (comm.rank() == 0) {
+                printf("inner() performance: %12.6f GFlops/rank, [m,n,k=%i %i %i, time=%f (sec)]\n",
+                       ngop * m__ * n__ * k / time / comm.size(), m__, n__, k, time);
+            }
+        }
+        return;
+    } else if (result__.comm().size() == 1) { /* the same for the device memory */
         inner_local<T>(mem__, la__, ispn__, bra__, i0__, m__, ket__, j0__, n__, &beta,
                        result__.at(mem__, irow0__, jcol0__), result__.ld(), stream_id(-1));
         if (is_device_memory(mem__)) {
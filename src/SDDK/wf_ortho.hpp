@@ -22,6 +22,252 @@
  *  \brief Wave-function orthonormalization.
  */
 
+/// Method of orthonormalization of the new block of wave-functions.
+enum class ortho_method_t
+{
+    /// Cholesky factorization of the (distributed) overlap matrix.
+    cholesky,
+    /// Two passes of Cholesky QR with the overlap matrix replicated on all ranks.
+    cholesky_qr2,
+    /// Tall-skinny QR with a tree reduction of the triangular factors.
+    tsqr
+};
+
+inline ortho_method_t get_ortho_method_t(std::string name__)
+{
+    std::transform(name__.begin(), name__.end(), name__.begin(), ::tolower);
+
+    static const std::map<std::string, ortho_method_t> map_to_type = {
+        {"cholesky",     ortho_method_t::cholesky},
+        {"cholesky_qr2", ortho_method_t::cholesky_qr2},
+        {"tsqr",         ortho_method_t::tsqr}
+    };
+
+    if (map_to_type.count(name__) == 0) {
+        std::stringstream s;
+        s << "wrong label of orthogonalization method: " << name__;
+        throw std::runtime_error(s.str());
+    }
+
+    return map_to_type.at(name__);
+}
+
+/// Multiply n wave-functions starting from index N by the upper triangular matrix from the right.
+/** Matrix is expected to be in the memory of type mem__. */
+template <typename T>
+inline void trmm_wf(memory_t mem__, linalg_t la__, int ispn__, std::vector<Wave_functions*>& wfs__, int N__, int n__,
+                    T* r__, int ld__)
+{
+    for (int s: get_spins(ispn__)) {
+        /* multiplication by triangular matrix */
+        for (auto& e: wfs__) {
+            /* wave functions are complex, transformation matrix is complex */
+            if (std::is_same<T, double_complex>::value) {
+                linalg2(la__).trmm('R', 'U', 'N', e->pw_coeffs(s).num_rows_loc(), n__,
+                                   &linalg_const<double_complex>::one(),
+                                   reinterpret_cast<double_complex*>(r__), ld__,
+                                   e->pw_coeffs(s).prime().at(e->preferred_memory_t(), 0, N__), e->pw_coeffs(s).prime().ld());
+
+                if (e->has_mt()) {
+                    linalg2(la__).trmm('R', 'U', 'N', e->mt_coeffs(s).num_rows_loc(), n__,
+                                       &linalg_const<double_complex>::one(),
+                                       reinterpret_cast<double_complex*>(r__), ld__,
+                                       e->mt_coeffs(s).prime().at(e->preferred_memory_t(), 0, N__), e->mt_coeffs(s).prime().ld());
+                }
+            }
+            /* wave functions are real (psi(G) = psi^{*}(-G)), transformation matrix is real */
+            if (std::is_same<T, double>::value) {
+                linalg2(la__).trmm('R', 'U', 'N', 2 * e->pw_coeffs(s).num_rows_loc(), n__,
+                                   &linalg_const<double>::one(),
+                                   reinterpret_cast<double*>(r__), ld__,
+                                   reinterpret_cast<double*>(e->pw_coeffs(s).prime().at(e->preferred_memory_t(), 0, N__)),
+                                   2 * e->pw_coeffs(s).prime().ld());
+
+                if (e->has_mt()) {
+                    linalg2(la__).trmm('R', 'U', 'N', 2 * e->mt_coeffs(s).num_rows_loc(), n__,
+                                       &linalg_const<double>::one(),
+                                       reinterpret_cast<double*>(r__), ld__,
+                                       reinterpret_cast<double*>(e->mt_coeffs(s).prime().at(e->preferred_memory_t(), 0, N__)),
+                                       2 * e->mt_coeffs(s).prime().ld());
+                }
+            }
+        }
+    }
+}
+
+/// Check the diagonal of the triangular factor R of the overlap matrix.
+/** The ratio of the smallest and largest diagonal elements is a cheap lower bound estimate of the inverse
+ *  condition number of the wave-functions block. */
+template <typename T>
+inline bool is_well_conditioned(mdarray<T, 2> const& r__, int n__, double rcond__)
+{
+    double dmin = std::abs(r__(0, 0));
+    double dmax = std::abs(r__(0, 0));
+    for (int i = 1; i < n__; i++) {
+        dmin = std::min(dmin, std::abs(r__(i, i)));
+        dmax = std::max(dmax, std::abs(r__(i, i)));
+    }
+    return dmin > rcond__ * dmax;
+}
+
+/// One step of Cholesky QR: S = R^{H} R, |phi> <- |phi> R^{-1}.
+/** The overlap matrix is computed with a single allreduce and factorized by each rank redundantly. Returns false
+ *  without touching the wave-functions if the overlap matrix is not positive definite or if the block is too
+ *  ill-conditioned. */
+template <typename T, int idx_bra__, int idx_ket__>
+inline bool cholesky_qr(memory_t mem__, linalg_t la__, int ispn__, std::vector<Wave_functions*>& wfs__, int N__,
+                        int n__, double rcond__)
+{
+    utils::timer t1("sddk::orthogonalize|cholesky_qr");
+
+    auto& comm = wfs__[0]->comm();
+
+    mdarray<T, 2> r(n__, n__, memory_t::host, "cholesky_qr::r");
+    if (is_device_memory(mem__)) {
+        r.allocate(mem__);
+    }
+
+    T beta = 0;
+    inner_local<T>(mem__, la__, ispn__, *wfs__[idx_bra__], N__, n__, *wfs__[idx_ket__], N__, n__, &beta,
+                   r.at(mem__), n__, stream_id(-1));
+    if (is_device_memory(mem__)) {
+        acc::copyout(r.at(memory_t::host), r.at(memory_t::device), n__ * n__);
+    }
+    comm.allreduce(r.at(memory_t::host), n__ * n__);
+
+    if (linalg2(linalg_t::lapack).potrf(n__, r.at(memory_t::host), n__)) {
+        return false;
+    }
+    /* R is the square root of the overlap matrix, hence the square of the ratio */
+    if (!is_well_conditioned(r, n__, std::sqrt(rcond__))) {
+        return false;
+    }
+    if (linalg2(linalg_t::lapack).trtri(n__, r.at(memory_t::host), n__)) {
+        return false;
+    }
+    if (is_device_memory(mem__)) {
+        acc::copyin(r.at(memory_t::device), r.at(memory_t::host), n__ * n__);
+    }
+    trmm_wf<T>(mem__, la__, ispn__, wfs__, N__, n__, r.at(mem__), n__);
+
+    return true;
+}
+
+/// Tall-skinny QR of the new block of wave-functions.
+/** Each rank computes the R factor of its local rows; the factors are combined with a binary tree of QR
+ *  factorizations of the stacked [R_1; R_2] matrices and the final R is broadcast. The wave-functions are then
+ *  multiplied by R^{-1}. Only the Euclidean metric is supported. */
+template <typename T>
+inline bool tsqr(int ispn__, std::vector<Wave_functions*>& wfs__, int N__, int n__, double rcond__)
+{
+    utils::timer t1("sddk::orthogonalize|tsqr");
+
+    auto& wf   = *wfs__[0];
+    auto& comm = wf.comm();
+    auto spins = get_spins(ispn__);
+
+    /* number of real or complex rows of the local matrix */
+    int nc = std::is_same<T, double>::value ? 2 : 1;
+    int nrow{0};
+    for (int s: spins) {
+        nrow += nc * wf.pw_coeffs(s).num_rows_loc();
+        if (wf.has_mt()) {
+            nrow += nc * wf.mt_coeffs(s).num_rows_loc();
+        }
+    }
+    int ld = std::max(nrow, n__);
+
+    mdarray<T, 2> a(ld, n__, memory_t::host, "tsqr::a");
+    a.zero();
+    /* real wave-functions are stored as a half of G-vectors; rows are scaled to reproduce the inner product
+       2 Re <a|b> - a(0) b(0) */
+    double w = std::is_same<T, double>::value ? std::sqrt(2.0) : 1.0;
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n__; i++) {
+        int irow{0};
+        for (int s: spins) {
+            auto src = reinterpret_cast<T const*>(wf.pw_coeffs(s).prime().at(memory_t::host, 0, N__ + i));
+            for (int j = 0; j < nc * wf.pw_coeffs(s).num_rows_loc(); j++) {
+                a(irow++, i) = w * src[j];
+            }
+            if (std::is_same<T, double>::value && comm.rank() == 0) {
+                a(irow - nc * wf.pw_coeffs(s).num_rows_loc(), i) = src[0];
+            }
+            if (wf.has_mt()) {
+                auto src = reinterpret_cast<T const*>(wf.mt_coeffs(s).prime().at(memory_t::host, 0, N__ + i));
+                for (int j = 0; j < nc * wf.mt_coeffs(s).num_rows_loc(); j++) {
+                    a(irow++, i) = w * src[j];
+                }
+            }
+        }
+    }
+    linalg2(linalg_t::lapack).geqrf(ld, n__, a.at(memory_t::host), ld);
+
+    mdarray<T, 2> r(n__, n__, memory_t::host, "tsqr::r");
+    auto get_r = [n__](mdarray<T, 2> const& a__, mdarray<T, 2>& r__)
+    {
+        for (int j = 0; j < n__; j++) {
+            for (int i = 0; i < n__; i++) {
+                r__(i, j) = (i <= j) ? a__(i, j) : 0;
+            }
+        }
+    };
+    get_r(a, r);
+
+    /* binary tree reduction of R factors to rank 0 */
+    mdarray<T, 2> r1(n__, n__, memory_t::host, "tsqr::r1");
+    mdarray<T, 2> rr(2 * n__, n__, memory_t::host, "tsqr::rr");
+    for (int step = 1; step < comm.size(); step *= 2) {
+        if (comm.rank() % (2 * step) == 0) {
+            if (comm.rank() + step < comm.size()) {
+                comm.recv(r1.at(memory_t::host), n__ * n__, comm.rank() + step, step);
+                /* stack [R; R_1] and factorize again */
+                for (int j = 0; j < n__; j++) {
+                    for (int i = 0; i < n__; i++) {
+                        rr(i, j)       = r(i, j);
+                        rr(n__ + i, j) = r1(i, j);
+                    }
+                }
+                linalg2(linalg_t::lapack).geqrf(2 * n__, n__, rr.at(memory_t::host), 2 * n__);
+                get_r(rr, r);
+            }
+        } else {
+            comm.send(r.at(memory_t::host), n__ * n__, comm.rank() - step, step);
+            break;
+        }
+    }
+    comm.bcast(r.at(memory_t::host), n__ * n__, 0);
+
+    if (!is_well_conditioned(r, n__, rcond__)) {
+        return false;
+    }
+    if (linalg2(linalg_t::lapack).trtri(n__, r.at(memory_t::host), n__)) {
+        return false;
+    }
+    trmm_wf<T>(memory_t::host, linalg_t::blas, ispn__, wfs__, N__, n__, r.at(memory_t::host), n__);
+
+    return true;
+}
+
+/// Orthonormalize the new block of wave-functions with a replicated triangular factor.
+/** No ScaLAPACK calls and O(1) collectives are required. Returns false if the block is ill-conditioned and the
+ *  standard Cholesky orthogonalization must be used. */
+template <typename T, int idx_bra__, int idx_ket__>
+inline bool orthonormalize_replicated(memory_t mem__, linalg_t la__, int ispn__, std::vector<Wave_functions*>& wfs__,
+                                      int N__, int n__, ortho_method_t method__)
+{
+    /* TSQR is restricted to the Euclidean metric and wave-functions in host memory */
+    if (method__ == ortho_method_t::tsqr && idx_bra__ == idx_ket__ && is_host_memory(mem__)) {
+        return tsqr<T>(ispn__, wfs__, N__, n__, 1e-12);
+    }
+    /* CholeskyQR2 is stable for condition numbers below ~1/sqrt(eps); the second pass restores orthogonality
+       lost in the first one */
+    if (!cholesky_qr<T, idx_bra__, idx_ket__>(mem__, la__, ispn__, wfs__, N__, n__, 1e-14)) {
+        return false;
+    }
+    return cholesky_qr<T, idx_bra__, idx_ket__>(mem__, la__, ispn__, wfs__, N__, n__, 0);
+}
+
 /// Orthogonalize n new wave-functions to the N old wave-functions
 template <typename T, int idx_bra__, int idx_ket__>
 inline void orthogonalize(memory_t                     mem__,
@@ -31,7 +277,8 @@ inline void orthogonalize(memory_t                     mem__,
                           int                          N__,
                           int                          n__,
                           dmatrix<T>&                  o__,
-                          Wave_functions&              tmp__)
+                          Wave_functions&              tmp__,
+                          ortho_method_t               method__ = ortho_method_t::cholesky)
 {
     PROFILE("sddk::orthogonalize");
 
@@ -119,6 +366,12 @@ inline void orthogonalize(memory_t                     mem__,
         }
     }
 
+    /* orthonormalize new n__ x n__ block with the triangular factor computed on each rank */
+    if (method__ != ortho_method_t::cholesky && orthonormalize_replicated<T, idx_bra__, idx_ket__>(mem__, la__,
+        ispn__, wfs__, N__, n__, method__)) {
+        return;
+    }
+
     /* orthogonalize new n__ x n__ block */
     inner(mem__, la__, ispn__, *wfs__[idx_bra__], N__, n__, *wfs__[idx_ket__], N__, n__, o__, 0, 0);
 
@@ -192,42 +445,7 @@ inline void orthogonalize(memory_t                     mem__,
         t1.stop();
 
         utils::timer t2("sddk::orthogonalize|transform");
-
-        for (int s: spins) {
-            /* multiplication by triangular matrix */
-            for (auto& e: wfs__) {
-                /* wave functions are complex, transformation matrix is complex */
-                if (std::is_same<T, double_complex>::value) {
-                    linalg2(la__).trmm('R', 'U', 'N', e->pw_coeffs(s).num_rows_loc(), n__,
-                                       &linalg_const<double_complex>::one(),
-                                       reinterpret_cast<double_complex*>(o__.at(mem__)), o__.ld(),
-                                       e->pw_coeffs(s).prime().at(e->preferred_memory_t(), 0, N__), e->pw_coeffs(s).prime().ld());
-
-                    if (e->has_mt()) {
-                        linalg2(la__).trmm('R', 'U', 'N', e->mt_coeffs(s).num_rows_loc(), n__,
-                                           &linalg_const<double_complex>::one(),
-                                           reinterpret_cast<double_complex*>(o__.at(mem__)), o__.ld(),
-                                           e->mt_coeffs(s).prime().at(e->preferred_memory_t(), 0, N__), e->mt_coeffs(s).prime().ld());
-                    }
-                }
-                /* wave functions are real (psi(G) = psi^{*}(-G)), transformation matrix is real */
-                if (std::is_same<T, double>::value) {
-                    linalg2(la__).trmm('R', 'U', 'N', 2 * e->pw_coeffs(s).num_rows_loc(), n__,
-                                       &linalg_const<double>::one(),
-                                       reinterpret_cast<double*>(o__.at(mem__)), o__.ld(),
-                                       reinterpret_cast<double*>(e->pw_coeffs(s).prime().at(e->preferred_memory_t(), 0, N__)),
-                                       2 * e->pw_coeffs(s).prime().ld());
-
-                    if (e->has_mt()) {
-                        linalg2(la__).trmm('R', 'U', 'N', 2 * e->mt_coeffs(s).num_rows_loc(), n__,
-                                           &linalg_const<double>::one(),
-                                           reinterpret_cast<double*>(o__.at(mem__)), o__.ld(),
-                                           reinterpret_cast<double*>(e->mt_coeffs(s).prime().at(e->preferred_memory_t(), 0, N__)),
-                                           2 * e->mt_coeffs(s).prime().ld());
-                    }
-                }
-            }
-        }
+        trmm_wf<T>(mem__, la__, ispn__, wfs__, N__, n__, o__.at(mem__), o__.ld());
         t2.stop();
     } else { /* parallel transformation */
         utils::timer t1("sddk::orthogonalize|potrf");
@@ -278,13 +496,14 @@ inline void orthogonalize(memory_t        mem__,
                           int             N__,
                           int             n__,
                           dmatrix<T>&     o__,
-                          Wave_functions& tmp__)
+                          Wave_functions& tmp__,
+                          ortho_method_t  method__ = ortho_method_t::cholesky)
 {
     static_assert(std::is_same<T, double>::value || std::is_same<T, double_complex>::value, "wrong type");
 
     auto wfs = {&phi__, &hphi__};
 
-    orthogonalize<T, 0, 0>(mem__, la__, ispn__, wfs, N__, n__, o__, tmp__);
+    orthogonalize<T, 0, 0>(mem__, la__, ispn__, wfs, N__, n__, o__, tmp__, method__);
 }
 
 template <typename T>
@@ -297,11 +516,12 @@ inline void orthogonalize(memory_t        mem__,
                           int             N__,
                           int             n__,
                           dmatrix<T>&     o__,
-                          Wave_functions& tmp__)
+                          Wave_functions& tmp__,
+                          ortho_method_t  method__ = ortho_method_t::cholesky)
 {
     static_assert(std::is_same<T, double>::value || std::is_same<T, double_complex>::value, "wrong type");
 
     auto wfs = {&phi__, &hphi__, &ophi__};
 
-    orthogonalize<T, 0, 2>(mem__, la__, ispn__, wfs, N__, n__, o__, tmp__);
+    orthogonalize<T, 0, 2>(mem__, la__, ispn__, wfs, N__, n__, o__, tmp__, method__);
 }
@@ -25,10 +25,153 @@
 #ifndef __GAUNT_HPP__
 #define __GAUNT_HPP__
 
+#include <mutex>
+#include <array>
 #include "memory.hpp"
+#include "sht.hpp"
 
 namespace sirius {
 
+/// Type of the Gaunt coefficients in the shared tables.
+enum class gaunt_t
+{
+    /// Three complex harmonics \f$ \langle Y_{\ell_1 m_1} | Y_{\ell_2 m_2} | Y_{\ell_3 m_3} \rangle \f$.
+    ylm,
+
+    /// Three real harmonics \f$ \langle R_{\ell_1 m_1} | R_{\ell_2 m_2} | R_{\ell_3 m_3} \rangle \f$.
+    rlm,
+
+    /// Real inner harmonic \f$ \langle Y_{\ell_1 m_1} | R_{\ell_2 m_2} | Y_{\ell_3 m_3} \rangle \f$.
+    hybrid
+};
+
+/// Evaluation of the Gaunt coefficients with the tabulated Wigner 3j-symbols.
+/** Same definitions as in SHT::gaunt_ylm(), SHT::gaunt_rlm() and SHT::gaunt_hybrid(), but the 3j-symbols
+ *  \f$ (\ell_1 \ell_2 \ell_3 | m_1 m_2 m_3) \f$ are computed for all \f$ \ell_3 \f$ at once by SHT::wigner_3j()
+ *  on the first request for a given pair \f$ \ell_1 m_1, \ell_2 m_2 \f$ and stored. */
+class Gaunt_evaluator
+{
+  private:
+    /// 3j-symbols for all allowed \f$ \ell_3 \f$ and fixed \f$ \ell_1 m_1, \ell_2 m_2 \f$.
+    mdarray<std::vector<double>, 2> w3j_;
+
+    /// Return 3j-symbol \f$ (\ell_1 \ell_2 \ell_3 | m_1 m_2, -m_1-m_2) \f$.
+    inline double w3j(int l1, int l2, int l3, int m1, int m2)
+    {
+        int lmin = std::max(std::abs(l1 - l2), std::abs(m1 + m2));
+        if (l3 < lmin || l3 > l1 + l2) {
+            return 0;
+        }
+        auto& v = w3j_(utils::lm(l1, m1), utils::lm(l2, m2));
+        if (v.empty()) {
+            /* cyclic permutation (l3 l1 l2) of the columns doesn't change the symbol */
+            v = SHT::wigner_3j(l1, l2, m1, m2);
+        }
+        return v[l3 - lmin];
+    }
+
+  public:
+    /// Constructor.
+    /** \param [in] lmax1 Maximum \f$ \ell \f$ of the first harmonic.
+     *  \param [in] lmax2 Maximum \f$ \ell \f$ of the second harmonic.
+     */
+    Gaunt_evaluator(int lmax1__, int lmax2__)
+        : w3j_(utils::lmmax(lmax1__), utils::lmmax(lmax2__))
+    {
+    }
+
+    /// Gaunt coefficient of three complex spherical harmonics.
+    inline double ylm(int l1, int l2, int l3, int m1, int m2, int m3)
+    {
+        if (m3 != m1 - m2 || (l1 + l2 + l3) % 2 || l3 < std::abs(l1 - l2) || l3 > l1 + l2) {
+            return 0;
+        }
+        return std::pow(-1.0, std::abs(m1)) *
+               std::sqrt(double(2 * l1 + 1) * double(2 * l2 + 1) * double(2 * l3 + 1) / fourpi) *
+               w3j(l1, l2, l3, 0, 0) * w3j(l1, l2, l3, -m1, m2);
+    }
+
+    /// Gaunt coefficient of three real spherical harmonics.
+    inline double rlm(int l1, int l2, int l3, int m1, int m2, int m3)
+    {
+        if ((l1 + l2 + l3) % 2 || l3 < std::abs(l1 - l2) || l3 > l1 + l2) {
+            return 0;
+        }
+        /* real harmonic R_{lm} is a combination of Y_{l,m} and Y_{l,-m} only */
+        double d = 0;
+        for (int k1 : {m1, -m1}) {
+            for (int k2 : {m2, -m2}) {
+                for (int k3 : {m3, -m3}) {
+                    if (k1 - k2 - k3 == 0) {
+                        d += std::real(std::conj(SHT::ylm_dot_rlm(l1, k1, m1)) * SHT::ylm_dot_rlm(l2, k2, m2) *
+                                       SHT::ylm_dot_rlm(l3, k3, m3)) * ylm(l1, l2, l3, k1, k2, k3);
+                    }
+                    if (m3 == 0) {
+                        break;
+                    }
+                }
+                if (m2 == 0) {
+                    break;
+                }
+            }
+            if (m1 == 0) {
+                break;
+            }
+        }
+        return d;
+    }
+
+    /// Gaunt coefficient of two complex and one real spherical harmonics.
+    inline double_complex hybrid(int l1, int l2, int l3, int m1, int m2, int m3)
+    {
+        if (m2 == 0) {
+            return double_complex(ylm(l1, l2, l3, m1, m2, m3), 0.0);
+        } else {
+            return (SHT::ylm_dot_rlm(l2, m2, m2) * ylm(l1, l2, l3, m1, m2, m3) +
+                    SHT::ylm_dot_rlm(l2, -m2, m2) * ylm(l1, l2, l3, m1, -m2, m3));
+        }
+    }
+
+    /// Gaunt coefficient of a given type.
+    template <typename T>
+    inline T get(gaunt_t type__, int l1, int l2, int l3, int m1, int m2, int m3);
+};
+
+template <>
+inline double Gaunt_evaluator::get<double>(gaunt_t type__, int l1, int l2, int l3, int m1, int m2, int m3)
+{
+    switch (type__) {
+        case gaunt_t::ylm: {
+            return ylm(l1, l2, l3, m1, m2, m3);
+        }
+        case gaunt_t::rlm: {
+            return rlm(l1, l2, l3, m1, m2, m3);
+        }
+        default: {
+            TERMINATE("complex Gaunt coefficients can't be stored in a real table");
+        }
+    }
+    return 0;
+}
+
+template <>
+inline double_complex Gaunt_evaluator::get<double_complex>(gaunt_t type__, int l1, int l2, int l3, int m1, int m2,
+                                                           int m3)
+{
+    switch (type__) {
+        case gaunt_t::ylm: {
+            return ylm(l1, l2, l3, m1, m2, m3);
+        }
+        case gaunt_t::rlm: {
+            return rlm(l1, l2, l3, m1, m2, m3);
+        }
+        case gaunt_t::hybrid: {
+            return hybrid(l1, l2, l3, m1, m2, m3);
+        }
+    }
+    return 0;
+}
+
 /// Used in the {lm1, lm2} : {lm3, coefficient} way of grouping non-zero Gaunt coefficients
 template <typename T>
 struct gaunt_L3
@@ -201,6 +344,44 @@ class Gaunt_coefficients
     {
         return gaunt_packed_L3_(lm1, lm2);
     }
+
+    /// Return the shared table of Gaunt coefficients.
+    /** Tables are computed on the first request for a given combination of \f$ \ell_{max} \f$ values and type and
+     *  are kept until the end of the program, so the repeated setups of the same system don't recompute them. The
+     *  function can be called from several threads.
+     *
+     *  Example:
+     *  \code{.cpp}
+     *  auto gc = Gaunt_coefficients<double>::get(lmax, 2 * lmax, lmax, gaunt_t::rlm);
+     *  for (int inz = 0; inz < gc->num_gaunt(lm1, lm2); inz++) {
+     *      auto& lm3coef = gc->gaunt(lm1, lm2, inz);
+     *  }
+     *  \endcode
+     */
+    static std::shared_ptr<Gaunt_coefficients<T> const> get(int lmax1__, int lmax3__, int lmax2__, gaunt_t type__)
+    {
+        static std::mutex mtx;
+        static std::map<std::array<int, 4>, std::shared_ptr<Gaunt_coefficients<T> const>> tables;
+
+        std::array<int, 4> key = {lmax1__, lmax3__, lmax2__, static_cast<int>(type__)};
+
+        std::lock_guard<std::mutex> lock(mtx);
+
+        auto it = tables.find(key);
+        if (it != tables.end()) {
+            return it->second;
+        }
+
+        /* first two arguments of the Gaunt functions are the bra and inner harmonics */
+        Gaunt_evaluator ge(lmax1__, lmax3__);
+        auto gc = std::make_shared<Gaunt_coefficients<T> const>(lmax1__, lmax3__, lmax2__,
+            [&](int l1, int l2, int l3, int m1, int m2, int m3)
+            {
+                return ge.get<T>(type__, l1, l2, l3, m1, m2, m3);
+            });
+        tables[key] = gc;
+        return gc;
+    }
 };
 
 }; // namespace sirius
@@ -79,6 +79,83 @@ class SHT // TODO: better name
     /// Type of spherical grid (0: Lebedev-Laikov, 1: uniform).
     int mesh_type_{0};
 
+    /// Multiply the batch of functions by the transposed transformation matrix.
+    /** Compute \f$ out_i = tbl^{T} in_i \f$ for each function, where tbl is a k x m matrix; k rows of each input
+     *  column are used and m rows of each output column are written. Inputs (outputs) which follow each other in
+     *  memory are used in place; otherwise their radial columns are packed into (unpacked from) a buffer. If nrb is
+     *  positive, the columns are processed in blocks of this size. */
+    template <typename T>
+    static void transform_batch(int m__, int k__, T const* tbl__, int ld_tbl__, std::vector<T const*> const& in__,
+                                int ld_in__, std::vector<T*> const& out__, int ld_out__, int nr__, int nrb__)
+    {
+        assert(in__.size() == out__.size());
+
+        int nf = static_cast<int>(in__.size());
+        if (nf == 0 || nr__ == 0) {
+            return;
+        }
+
+        /* check if the functions follow each other in memory */
+        bool contig_in{true};
+        bool contig_out{true};
+        for (int i = 1; i < nf; i++) {
+            if (in__[i] != in__[0] + static_cast<size_t>(ld_in__) * nr__ * i) {
+                contig_in = false;
+            }
+            if (out__[i] != out__[0] + static_cast<size_t>(ld_out__) * nr__ * i) {
+                contig_out = false;
+            }
+        }
+
+        int ncol = nf * nr__;
+        int nb   = (nrb__ > 0) ? std::min(nrb__, ncol) : ncol;
+
+        mdarray<T, 2> buf_in;
+        if (!contig_in) {
+            buf_in = mdarray<T, 2>(k__, nb);
+        }
+        mdarray<T, 2> buf_out;
+        if (!contig_out) {
+            buf_out = mdarray<T, 2>(m__, nb);
+        }
+
+        for (int c0 = 0; c0 < ncol; c0 += nb) {
+            int n = std::min(nb, ncol - c0);
+
+            T const* ptr_in = in__[0] + static_cast<size_t>(ld_in__) * c0;
+            int ld_in       = ld_in__;
+            if (!contig_in) {
+                #pragma omp parallel for schedule(static)
+                for (int c = 0; c < n; c++) {
+                    int i  = (c0 + c) / nr__;
+                    int ir = (c0 + c) % nr__;
+                    std::copy(in__[i] + static_cast<size_t>(ld_in__) * ir,
+                              in__[i] + static_cast<size_t>(ld_in__) * ir + k__, &buf_in(0, c));
+                }
+                ptr_in = &buf_in(0, 0);
+                ld_in  = k__;
+            }
+
+            T* ptr_out = out__[0] + static_cast<size_t>(ld_out__) * c0;
+            int ld_out = ld_out__;
+            if (!contig_out) {
+                ptr_out = &buf_out(0, 0);
+                ld_out  = m__;
+            }
+
+            linalg<CPU>::gemm(1, 0, m__, n, k__, tbl__, ld_tbl__, ptr_in, ld_in, ptr_out, ld_out);
+
+            if (!contig_out) {
+                #pragma omp parallel for schedule(static)
+                for (int c = 0; c < n; c++) {
+                    int i  = (c0 + c) / nr__;
+                    int ir = (c0 + c) % nr__;
+                    std::copy(&buf_out(0, c), &buf_out(0, c) + m__, out__[i] + static_cast<size_t>(ld_out__) * ir);
+                }
+            }
+        }
+    }
+
   public:
     /// Default constructor.
     SHT(int lmax__)
@@ -243,6 +320,39 @@ class SHT // TODO: better name
     template <typename T>
     void forward_transform(T const* ftp, int nr, int lmmax, int ld, T* flm);
 
+    /// Perform a backward transformation of several functions.
+    /** All functions have the same number of radial points and the same leading dimension. If the functions are
+     *  placed in memory one after another (like the slices of a 3D array, see Spheric_function_set) the
+     *  transformation is done in place, otherwise the radial points of all functions are packed into a buffer. In
+     *  both cases a single GEMM with \f$ N_{f} \times N_{r} \f$ columns is executed. If the block size nrb is
+     *  positive, columns are processed in blocks of this size, which keeps the buffers and the output in cache for
+     *  the very long radial grids.
+     *
+     *  \param [in] ld Size of leading dimension of each flm.
+     *  \param [in] flm Raw pointers to \f$ f_{\ell m}(r) \f$ of each function.
+     *  \param [in] nr Number of radial points.
+     *  \param [in] lmmax Maximum number of lm- harmonics to take into sum.
+     *  \param [out] ftp Raw pointers to \f$ f(\theta, \phi, r) \f$ of each function.
+     *  \param [in] nrb Number of columns in a block or 0 to transform all columns at once.
+     */
+    template <typename T>
+    void backward_transform(int ld, std::vector<T const*> const& flm, int nr, int lmmax, std::vector<T*> const& ftp,
+                            int nrb = 0);
+
+    /// Perform a forward transformation of several functions.
+    /** Batched counterpart of forward_transform(); see backward_transform() for the description of the batching.
+     *
+     *  \param [in] ftp Raw pointers to \f$ f(\theta, \phi, r) \f$ of each function.
+     *  \param [in] nr Number of radial points.
+     *  \param [in] lmmax Maximum number of lm- coefficients to generate.
+     *  \param [in] ld Size of leading dimension of each flm.
+     *  \param [out] flm Raw pointers to \f$ f_{\ell m}(r) \f$ of each function.
+     *  \param [in] nrb Number of columns in a block or 0 to transform all columns at once.
+     */
+    template <typename T>
+    void forward_transform(std::vector<T const*> const& ftp, int nr, int lmmax, int ld, std::vector<T*> const& flm,
+                           int nrb = 0);
+
     /// Convert form Rlm to Ylm representation.
     static void convert(int lmax__, double const* f_rlm__, double_complex* f_ylm__)
     {
@@ -504,16 +614,28 @@ class SHT // TODO: better name
         assert(m2 >= -l2 && m2 <= l2);
         assert(m3 >= -l3 && m3 <= l3);
 
+        /* real harmonic R_{lm} is a combination of Y_{l,m} and Y_{l,-m} only */
         double d = 0;
-        for (int k1 = -l1; k1 <= l1; k1++) {
-            for (int k2 = -l2; k2 <= l2; k2++) {
-                for (int k3 = -l3; k3 <= l3; k3++) {
-                    d += std::real(std::conj(SHT::ylm_dot_rlm(l1, k1, m1)) *
-                                   SHT::ylm_dot_rlm(l2, k2, m2) *
-                                   SHT::ylm_dot_rlm(l3, k3, m3)) *
-                         SHT::gaunt_ylm(l1, l2, l3, k1, k2, k3);
+        for (int k1 : {m1, -m1}) {
+            for (int k2 : {m2, -m2}) {
+                for (int k3 : {m3, -m3}) {
+                    if (k1 - k2 - k3 == 0) {
+                        d += std::real(std::conj(SHT::ylm_dot_rlm(l1, k1, m1)) *
+                                       SHT::ylm_dot_rlm(l2, k2, m2) *
+                                       SHT::ylm_dot_rlm(l3, k3, m3)) *
+                             SHT::gaunt_ylm(l1, l2, l3, k1, k2, k3);
+                    }
+                    if (m3 == 0) {
+                        break;
+                    }
+                }
+                if (m2 == 0) {
+                    break;
                 }
             }
+            if (m1 == 0) {
+                break;
+            }
         }
         return d;
     }
@@ -600,6 +722,86 @@ class SHT // TODO: better name
                gsl_sf_coupling_3j(2 * l1, 2 * l2, 2 * l3, 2 * m1, 2 * m2, -2 * m3);
     }
 
+    /// Wigner 3j-symbols for all allowed values of the first angular momentum.
+    /** Return the values of
+     *  \f[
+     *    \left( \begin{array}{ccc} \ell & \ell_2 & \ell_3 \\ -m_2-m_3 & m_2 & m_3 \end{array} \right)
+     *  \f]
+     *  for \f$ \ell = \max(|\ell_2 - \ell_3|, |m_2 + m_3|) \dots \ell_2 + \ell_3 \f$ or an empty vector if
+     *  there are no such values. The symbols are computed with the three-term recurrence of Schulten and Gordon
+     *  (J. Math. Phys. 16, 1961 (1975)), which is run from both ends of the interval and matched in the middle,
+     *  and are normalized with the sum rule \f$ \sum_{\ell} (2\ell + 1) (\dots)^2 = 1 \f$.
+     */
+    static std::vector<double> wigner_3j(int l2, int l3, int m2, int m3)
+    {
+        int m1   = -m2 - m3;
+        int jmin = std::max(std::abs(l2 - l3), std::abs(m1));
+        int jmax = l2 + l3;
+        if (std::abs(m2) > l2 || std::abs(m3) > l3 || jmin > jmax) {
+            return std::vector<double>();
+        }
+        int n = jmax - jmin + 1;
+
+        auto A = [&](int j)
+        {
+            double j2 = double(j) * j;
+            return std::sqrt((j2 - double(l2 - l3) * (l2 - l3)) * (double(l2 + l3 + 1) * (l2 + l3 + 1) - j2) *
+                             (j2 - double(m1) * m1));
+        };
+        auto B = [&](int j)
+        {
+            return -(2.0 * j + 1) * (double(l2) * (l2 + 1) * m1 - double(l3) * (l3 + 1) * m1 -
+                                     double(j) * (j + 1) * (m3 - m2));
+        };
+
+        /* backward recursion from jmax; A(j) is non-zero for jmin < j <= jmax */
+        std::vector<double> f(n, 0);
+        f[n - 1] = 1;
+        for (int j = jmax; j > jmin; j--) {
+            int i = j - jmin;
+            double t = (j < jmax) ? j * A(j + 1) * f[i + 1] : 0;
+            f[i - 1] = -(B(j) * f[i] + t) / ((j + 1) * A(j));
+        }
+
+        /* forward recursion from jmin is stable in the other classically forbidden region; it is not defined
+           for jmin = 0 */
+        if (jmin > 0 && n > 2) {
+            std::vector<double> ff(n, 0);
+            ff[0] = 1;
+            for (int j = jmin; j < jmax; j++) {
+                int i = j - jmin;
+                double t = (j > jmin) ? (j + 1) * A(j) * ff[i - 1] : 0;
+                ff[i + 1] = -(B(j) * ff[i] + t) / (j * A(j + 1));
+            }
+            /* match two solutions in the middle at the point where both are large */
+            int im{-1};
+            double p{0};
+            for (int i = n / 3; i <= n - 1 - n / 3; i++) {
+                if (std::abs(ff[i] * f[i]) > p) {
+                    p  = std::abs(ff[i] * f[i]);
+                    im = i;
+                }
+            }
+            if (im >= 0) {
+                double s = f[im] / ff[im];
+                for (int i = 0; i < im; i++) {
+                    f[i] = ff[i] * s;
+                }
+            }
+        }
+
+        double norm{0};
+        for (int i = 0; i < n; i++) {
+            norm += (2 * (jmin + i) + 1) * f[i] * f[i];
+        }
+        /* sign convention: the symbol with the largest l has the sign (-1)^(l2 - l3 - m1) */
+        norm = ((l2 - l3 - m1) % 2 == 0 ? 1 : -1) / std::sqrt(norm);
+        for (int i = 0; i < n; i++) {
+            f[i] *= norm;
+        }
+        return f;
+    }
+
     inline double_complex ylm_backward(int lm, int itp) const
     {
         return ylm_backward_(lm, itp);
@@ -1291,6 +1493,42 @@ inline void SHT::forward_transform<double_complex>(double_complex const* ftp, in
     linalg<CPU>::gemm(1, 0, lmmax, nr, num_points_, &ylm_forward_(0, 0), num_points_, ftp, num_points_, flm, ld);
 }
 
+template <>
+inline void SHT::backward_transform<double>(int ld, std::vector<double const*> const& flm, int nr, int lmmax,
+                                            std::vector<double*> const& ftp, int nrb)
+{
+    assert(lmmax <= lmmax_);
+    assert(ld >= lmmax);
+    transform_batch(num_points_, lmmax, &rlm_backward_(0, 0), lmmax_, flm, ld, ftp, num_points_, nr, nrb);
+}
+
+template <>
+inline void SHT::backward_transform<double_complex>(int ld, std::vector<double_complex const*> const& flm, int nr,
+                                                    int lmmax, std::vector<double_complex*> const& ftp, int nrb)
+{
+    assert(lmmax <= lmmax_);
+    assert(ld >= lmmax);
+    transform_batch(num_points_, lmmax, &ylm_backward_(0, 0), lmmax_, flm, ld, ftp, num_points_, nr, nrb);
+}
+
+template <>
+inline void SHT::forward_transform<double>(std::vector<double const*> const& ftp, int nr, int lmmax, int ld,
+                                           std::vector<double*> const& flm, int nrb)
+{
+    assert(lmmax <= lmmax_);
+    assert(ld >= lmmax);
+    transform_batch(lmmax, num_points_, &rlm_forward_(0, 0), num_points_, ftp, num_points_, flm, ld, nr, nrb);
+}
+
+template <>
+inline void SHT::forward_transform<double_complex>(std::vector<double_complex const*> const& ftp, int nr, int lmmax,
+                                                   int ld, std::vector<double_complex*> const& flm, int nrb)
+{
+    assert(lmmax <= lmmax_);
+    assert(ld >= lmmax);
+    transform_batch(lmmax, num_points_, &ylm_forward_(0, 0), num_points_, ftp, num_points_, flm, ld, nr, nrb);
+}
+
 } // namespace sirius
 
 #endif // __SHT_HPP__
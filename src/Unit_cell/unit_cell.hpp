@@ -164,6 +164,44 @@ class Unit_cell
 
     Communicator const& comm_;
 
+    /// Lattice vectors at the time of the last call to update().
+    matrix3d<double> lattice_vectors_at_update_;
+
+    /// Atomic positions at the time of the last call to update().
+    std::vector<vector3d<double>> positions_at_update_;
+
+    /// True if lattice vectors were changed since the previous call to update().
+    bool lattice_changed_{true};
+
+    /// True if atomic positions were changed since the previous call to update().
+    bool positions_changed_{true};
+
+    /// Compare the current lattice vectors and atomic positions with the ones stored at the previous update.
+    inline void find_changes()
+    {
+        lattice_changed_ = false;
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                if (lattice_vectors_(i, j) != lattice_vectors_at_update_(i, j)) {
+                    lattice_changed_ = true;
+                }
+            }
+        }
+        lattice_vectors_at_update_ = lattice_vectors_;
+
+        positions_changed_ = (static_cast<int>(positions_at_update_.size()) != num_atoms());
+        positions_at_update_.resize(num_atoms());
+        for (int ia = 0; ia < num_atoms(); ia++) {
+            auto pos = atom(ia).position();
+            for (int x : {0, 1, 2}) {
+                if (pos[x] != positions_at_update_[ia][x]) {
+                    positions_changed_ = true;
+                }
+            }
+            positions_at_update_[ia] = pos;
+        }
+    }
+
     /// Automatically determine new muffin-tin radii as a half distance between neighbor atoms.
     /** In order to guarantee a unique solution muffin-tin radii are dermined as a half distance
      *  bethween nearest atoms. Initial values of the muffin-tin radii are ignored. */
@@ -390,10 +428,18 @@ class Unit_cell
     inline std::string chemical_formula();
 
     /// Update the parameters that depend on atomic positions or lattice vectors.
+    /** Nothing is done if neither the lattice vectors nor the atomic positions were changed since the previous
+     *  call. The type of change is stored and can be queried with lattice_changed() and positions_changed(). */
     inline void update()
     {
         PROFILE("sirius::Unit_cell::update");
 
+        find_changes();
+
+        if (!lattice_changed_ && !positions_changed_) {
+            return;
+        }
+
         auto v0 = lattice_vector(0);
         auto v1 = lattice_vector(1);
         auto v2 = lattice_vector(2);
@@ -449,6 +495,10 @@ class Unit_cell
 
         volume_it_ = omega() - volume_mt_;
 
+        if (!positions_changed_) {
+            return;
+        }
+
         for (int iat = 0; iat < num_atom_types(); iat++) {
             int nat = atom_type(iat).num_atoms();
             if (nat > 0) {
@@ -465,6 +515,18 @@ class Unit_cell
         }
     }
 
+    /// True if the lattice vectors were changed during the last call to update().
+    inline bool lattice_changed() const
+    {
+        return lattice_changed_;
+    }
+
+    /// True if the atomic positions were changed during the last call to update().
+    inline bool positions_changed() const
+    {
+        return positions_changed_;
+    }
+
     inline int atom_id_by_position(vector3d<double> position__)
     {
         for (int ia = 0; ia < num_atoms(); ia++) {
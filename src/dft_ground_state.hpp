@@ -70,6 +70,22 @@ class DFT_ground_state
     /// Store Ewald energy which is computed once and which doesn't change during the run.
     double ewald_energy_{0};
 
+    /// Order of the density extrapolation between ionic steps (0 switches the extrapolation off).
+    int extrapolation_order_{0};
+
+    /// True if the SCF loop was run for the current atomic configuration.
+    bool scf_done_{false};
+
+    /// True if the initial state was extrapolated from the previous ionic steps.
+    bool extrapolated_state_{false};
+
+    /// History of the plane-wave coefficients of the density without the superposition of atomic densities.
+    /** The most recent ionic step goes first. */
+    std::vector<std::vector<double_complex>> rho_history_;
+
+    /// Wave-functions of the previous ionic step for each local k-point.
+    std::vector<std::unique_ptr<Wave_functions>> psi_history_;
+
     /// Compute the ion-ion electrostatic energy using Ewald method.
     /** The following contribution (per unit cell) to the total energy has to be computed:
      *  \f[
@@ -201,6 +217,132 @@ class DFT_ground_state
         return (ewald_g + ewald_r);
     }
 
+    /// Plane-wave coefficients of the superposition of atomic densities for the current phase factors.
+    std::vector<double_complex> atomic_density_pw() const
+    {
+        return ctx_.make_periodic_function<index_domain_t::local>([&](int iat, double g)
+                                                                  {
+                                                                      return ctx_.ps_rho_ri().value<int>(iat, g);
+                                                                  });
+    }
+
+    /// Store the difference between the density and the superposition of atomic densities.
+    /** This must be called before the simulation context is updated with the new atomic positions, because
+     *  the atomic densities are computed with the phase factors of the previous ionic step. */
+    void save_density_history()
+    {
+        PROFILE("sirius::DFT_ground_state::save_density_history");
+
+        auto rho_at = atomic_density_pw();
+        std::vector<double_complex> drho(ctx_.gvec().count());
+        for (int igloc = 0; igloc < ctx_.gvec().count(); igloc++) {
+            drho[igloc] = density_.rho().f_pw_local(igloc) - rho_at[igloc];
+        }
+        rho_history_.insert(rho_history_.begin(), std::move(drho));
+        if (static_cast<int>(rho_history_.size()) > std::min(extrapolation_order_, 3)) {
+            rho_history_.resize(std::min(extrapolation_order_, 3));
+        }
+    }
+
+    /// Predict the density of the new ionic step.
+    /** The difference \f$ \Delta \rho = \rho - \rho^{at} \f$ between the self-consistent density and the
+     *  superposition of atomic densities is extrapolated from the previous ionic steps and the atomic densities
+     *  at the new positions are added back:
+     *  \f[
+     *    \rho(t + dt) = \rho^{at}(t + dt) + \sum_{i} c_i \Delta \rho(t - i\,dt)
+     *  \f]
+     *  with the coefficients \f$ \{1\} \f$, \f$ \{2, -1\} \f$ or \f$ \{3, -3, 1\} \f$ depending on the
+     *  available history. Magnetization is taken from the previous step. Negative values of the predicted density
+     *  are clipped only for the norm-conserving pseudopotentials.
+     */
+    void extrapolate_density()
+    {
+        PROFILE("sirius::DFT_ground_state::extrapolate_density");
+
+        const double c[3][3] = {{1, 0, 0}, {2, -1, 0}, {3, -3, 1}};
+
+        int n = static_cast<int>(rho_history_.size());
+
+        auto rho_at = atomic_density_pw();
+        #pragma omp parallel for schedule(static)
+        for (int igloc = 0; igloc < ctx_.gvec().count(); igloc++) {
+            double_complex z = rho_at[igloc];
+            for (int i = 0; i < n; i++) {
+                z += c[n - 1][i] * rho_history_[i][igloc];
+            }
+            density_.rho().f_pw_local(igloc) = z;
+        }
+        density_.rho().fft_transform(1);
+        /* remove possible negative noise; with the ultrasoft or PAW pseudopotentials the density contains the
+           augmentation charge, which can be negative, and it must not be clipped */
+        bool augment{false};
+        for (int iat = 0; iat < unit_cell_.num_atom_types(); iat++) {
+            augment |= unit_cell_.atom_type(iat).augment();
+        }
+        if (!augment) {
+            for (int ir = 0; ir < ctx_.fft().local_size(); ir++) {
+                density_.rho().f_rg(ir) = std::max(density_.rho().f_rg(ir), 0.0);
+            }
+        }
+        /* renormalize charge */
+        density_.normalize();
+        density_.rho().fft_transform(-1);
+    }
+
+    /// Predict the wave-functions of the new ionic step.
+    /** Wave-functions of the previous step are aligned with the current ones by the subspace rotation
+     *  \f$ O = \langle \psi(t - dt) | \psi(t) \rangle \f$, which removes the arbitrary unitary mixing of the
+     *  (possibly degenerate) states between the steps, and the first order extrapolation is made:
+     *  \f[
+     *    \psi(t + dt) = 2 \psi(t) - \psi(t - dt) O
+     *  \f]
+     *  The result is not orthonormal; the first Rayleigh-Ritz step of the iterative solver takes care of this.
+     */
+    template <typename T>
+    void extrapolate_wave_functions()
+    {
+        PROFILE("sirius::DFT_ground_state::extrapolate_wave_functions");
+
+        const int nb      = ctx_.num_bands();
+        const int ns      = ctx_.num_spins();
+        const bool nc_mag = (ctx_.num_mag_dims() == 3);
+
+        psi_history_.resize(kset_.spl_num_kpoints().local_size());
+
+        for (int ikloc = 0; ikloc < kset_.spl_num_kpoints().local_size(); ikloc++) {
+            int ik    = kset_.spl_num_kpoints(ikloc);
+            auto kp   = kset_[ik];
+            auto& psi = kp->spinor_wave_functions();
+
+            if (!psi_history_[ikloc]) {
+                psi_history_[ikloc] = std::unique_ptr<Wave_functions>(
+                    new Wave_functions(kp->gkvec_partition(), nb, memory_t::host, ns));
+                for (int ispn = 0; ispn < ns; ispn++) {
+                    psi_history_[ikloc]->copy_from(CPU, nb, psi, ispn, 0, ispn, 0);
+                }
+                continue;
+            }
+            auto& psi_prev = *psi_history_[ikloc];
+
+            Wave_functions psi_new(kp->gkvec_partition(), nb, memory_t::host, ns);
+            for (int ispn = 0; ispn < ns; ispn++) {
+                psi_new.copy_from(CPU, nb, psi, ispn, 0, ispn, 0);
+            }
+
+            dmatrix<T> o(nb, nb, ctx_.blacs_grid(), ctx_.cyclic_block_size(), ctx_.cyclic_block_size());
+            for (int ispin_step = 0; ispin_step < ctx_.num_spin_dims(); ispin_step++) {
+                int ispn = nc_mag ? 2 : ispin_step;
+                inner(memory_t::host, linalg_t::blas, ispn, psi_prev, 0, nb, psi, 0, nb, o, 0, 0);
+                transform<T>(memory_t::host, linalg_t::blas, ispn, -1.0, {&psi_prev}, 0, nb, o, 0, 0, 2.0,
+                             {&psi_new}, 0, nb);
+            }
+            for (int ispn = 0; ispn < ns; ispn++) {
+                psi_prev.copy_from(CPU, nb, psi, ispn, 0, ispn, 0);
+                psi.copy_from(CPU, nb, psi_new, ispn, 0, ispn, 0);
+            }
+        }
+    }
+
   public:
     /// Constructor.
     DFT_ground_state(K_point_set& kset__)
@@ -212,7 +354,7 @@ class DFT_ground_state
         , hamiltonian_(ctx_, potential_)
         , stress_(ctx_, density_, potential_, hamiltonian_, kset__)
         , forces_(ctx_, density_, potential_, hamiltonian_, kset__)
-
+        , extrapolation_order_(ctx_.settings().extrapolation_order_)
     {
         if (!ctx_.full_potential()) {
             ewald_energy_ = ewald_energy();
@@ -220,8 +362,13 @@ class DFT_ground_state
     }
 
     /// Generate initial densty, potential and a subspace of wave-functions.
+    /** If the state was already extrapolated from the previous ionic steps by update(), it is kept. */
     void initial_state()
     {
+        if (extrapolated_state_) {
+            extrapolated_state_ = false;
+            return;
+        }
         density_.initial_density();
         potential_.generate(density_);
         if (!ctx_.full_potential()) {
@@ -230,10 +377,19 @@ class DFT_ground_state
     }
 
     /// Update the parameters after the change of lattice vectors or atomic positions.
+    /** If the extrapolation is switched on and the SCF loop was run for the previous atomic configuration,
+     *  the density, potential and wave-functions of the new configuration are predicted from the history
+     *  of the previous ionic steps. */
     void update()
     {
         PROFILE("sirius::DFT_ground_state::update");
 
+        bool extrapolate = (extrapolation_order_ > 0) && !ctx_.full_potential() && scf_done_;
+        if (extrapolate) {
+            save_density_history();
+        }
+        scf_done_ = false;
+
         ctx_.update();
         kset_.update();
         potential_.update();
@@ -242,6 +398,32 @@ class DFT_ground_state
         if (!ctx_.full_potential()) {
             ewald_energy_ = ewald_energy();
         }
+
+        if (extrapolate) {
+            extrapolate_density();
+            potential_.generate(density_);
+            if (extrapolation_order_ > 1) {
+                if (ctx_.gamma_point() && (ctx_.so_correction() == false)) {
+                    extrapolate_wave_functions<double>();
+                } else {
+                    extrapolate_wave_functions<double_complex>();
+                }
+            }
+        }
+        extrapolated_state_ = extrapolate;
+    }
+
+    /// Set the order of the density extrapolation between ionic steps.
+    /** Order 0 switches the extrapolation off, order 1 reuses the density response of the previous step,
+     *  orders 2 and 3 make linear and quadratic extrapolation of the density; wave-functions are extrapolated
+     *  for orders 2 and 3. */
+    void extrapolation_order(int order__)
+    {
+        extrapolation_order_ = order__;
+        if (order__ <= 0) {
+            rho_history_.clear();
+            psi_history_.clear();
+        }
     }
 
     /// Return reference to a simulation context.
@@ -709,6 +891,8 @@ inline json DFT_ground_state::find(double potential_tol, double energy_tol, int
         //kset_.save(storage_file_name);
     }
 
+    scf_done_ = true;
+
     json dict = serialize();
     if (num_iter >= 0) {
         dict["converged"]          = true;
@@ -1539,6 +1539,153 @@ class Eigensolver_cuda: public Eigensolver
 //    }
 //};
 
+/// Solve small distributed eigen-value problems redundantly on each rank of the BLACS grid.
+/** The block-cyclic matrix is gathered on all ranks of the grid, the lowest eigen-pairs are found with the
+ *  threaded partial-spectrum LAPACK drivers (dsyevr/zheevr for the standard and dsygvx/zhegvx for the generalized
+ *  problem) and only the local panels of the requested eigen-vectors are copied back into the distributed matrix.
+ *  For the subspace sizes of a few thousands this avoids most of the communication of ScaLAPACK or ELPA. */
+class Eigensolver_replicated : public Eigensolver
+{
+  private:
+    Eigensolver_lapack lapack_;
+
+    /// Gather upper triangle of the distributed matrix into a full matrix on each rank.
+    template <typename T>
+    void gather(ftn_int matrix_size__, dmatrix<T>& A__, dmatrix<T>& A_full__)
+    {
+        A_full__.zero();
+        #pragma omp parallel for schedule(static)
+        for (int j = 0; j < A__.num_cols_local(); j++) {
+            int jc = A__.icol(j);
+            if (jc >= matrix_size__) {
+                continue;
+            }
+            for (int i = 0; i < A__.num_rows_local(); i++) {
+                int ir = A__.irow(i);
+                if (ir <= jc) {
+                    A_full__(ir, jc) = A__(i, j);
+                }
+            }
+        }
+        A__.comm().allreduce(A_full__.at(memory_t::host), static_cast<int>(A_full__.size()));
+    }
+
+    /// Copy the local panels of the first nev eigen-vectors into the distributed matrix.
+    template <typename T>
+    void scatter(ftn_int matrix_size__, ftn_int nev__, dmatrix<T>& Z_full__, dmatrix<T>& Z__)
+    {
+        #pragma omp parallel for schedule(static)
+        for (int j = 0; j < Z__.num_cols_local(); j++) {
+            int jc = Z__.icol(j);
+            if (jc >= nev__) {
+                continue;
+            }
+            for (int i = 0; i < Z__.num_rows_local(); i++) {
+                int ir = Z__.irow(i);
+                if (ir < matrix_size__) {
+                    Z__(i, j) = Z_full__(ir, jc);
+                }
+            }
+        }
+    }
+
+    template <typename T>
+    int solve_std(ftn_int matrix_size__, ftn_int nev__, dmatrix<T>& A__, double* eval__, dmatrix<T>& Z__)
+    {
+        utils::timer t1("Eigensolver_replicated|gather");
+        dmatrix<T> a(matrix_size__, matrix_size__);
+        dmatrix<T> z(matrix_size__, nev__);
+        gather(matrix_size__, A__, a);
+        t1.stop();
+
+        int info = lapack_.solve(matrix_size__, nev__, a, eval__, z);
+        if (!info) {
+            utils::timer t2("Eigensolver_replicated|scatter");
+            scatter(matrix_size__, nev__, z, Z__);
+        }
+        return info;
+    }
+
+    template <typename T>
+    int solve_gen(ftn_int matrix_size__, ftn_int nev__, dmatrix<T>& A__, dmatrix<T>& B__, double* eval__,
+                  dmatrix<T>& Z__)
+    {
+        utils::timer t1("Eigensolver_replicated|gather");
+        dmatrix<T> a(matrix_size__, matrix_size__);
+        dmatrix<T> b(matrix_size__, matrix_size__);
+        dmatrix<T> z(matrix_size__, nev__);
+        gather(matrix_size__, A__, a);
+        gather(matrix_size__, B__, b);
+        t1.stop();
+
+        int info = lapack_.solve(matrix_size__, nev__, a, b, eval__, z);
+        if (!info) {
+            utils::timer t2("Eigensolver_replicated|scatter");
+            scatter(matrix_size__, nev__, z, Z__);
+        }
+        return info;
+    }
+
+  public:
+    inline bool is_parallel()
+    {
+        return true;
+    }
+
+    /// Solve a standard eigen-value problem for all eigen-pairs.
+    int solve(ftn_int matrix_size__, dmatrix<double>& A__, double* eval__, dmatrix<double>& Z__)
+    {
+        return solve_std(matrix_size__, matrix_size__, A__, eval__, Z__);
+    }
+
+    /// Solve a standard eigen-value problem for all eigen-pairs.
+    int solve(ftn_int matrix_size__, dmatrix<double_complex>& A__, double* eval__, dmatrix<double_complex>& Z__)
+    {
+        return solve_std(matrix_size__, matrix_size__, A__, eval__, Z__);
+    }
+
+    /// Solve a generalized eigen-value problem for all eigen-pairs.
+    int solve(ftn_int matrix_size__, dmatrix<double>& A__, dmatrix<double>& B__, double* eval__,
+              dmatrix<double>& Z__)
+    {
+        return solve_gen(matrix_size__, matrix_size__, A__, B__, eval__, Z__);
+    }
+
+    /// Solve a generalized eigen-value problem for all eigen-pairs.
+    int solve(ftn_int matrix_size__, dmatrix<double_complex>& A__, dmatrix<double_complex>& B__, double* eval__,
+              dmatrix<double_complex>& Z__)
+    {
+        return solve_gen(matrix_size__, matrix_size__, A__, B__, eval__, Z__);
+    }
+
+    /// Solve a standard eigen-value problem for N lowest eigen-pairs.
+    int solve(ftn_int matrix_size__, ftn_int nev__, dmatrix<double>& A__, double* eval__, dmatrix<double>& Z__)
+    {
+        return solve_std(matrix_size__, nev__, A__, eval__, Z__);
+    }
+
+    /// Solve a standard eigen-value problem for N lowest eigen-pairs.
+    int solve(ftn_int matrix_size__, ftn_int nev__, dmatrix<double_complex>& A__, double* eval__,
+              dmatrix<double_complex>& Z__)
+    {
+        return solve_std(matrix_size__, nev__, A__, eval__, Z__);
+    }
+
+    /// Solve a generalized eigen-value problem for N lowest eigen-pairs.
+    int solve(ftn_int matrix_size__, ftn_int nev__, dmatrix<double>& A__, dmatrix<double>& B__, double* eval__,
+              dmatrix<double>& Z__)
+    {
+        return solve_gen(matrix_size__, nev__, A__, B__, eval__, Z__);
+    }
+
+    /// Solve a generalized eigen-value problem for N lowest eigen-pairs.
+    int solve(ftn_int matrix_size__, ftn_int nev__, dmatrix<double_complex>& A__, dmatrix<double_complex>& B__,
+              double* eval__, dmatrix<double_complex>& Z__)
+    {
+        return solve_gen(matrix_size__, nev__, A__, B__, eval__, Z__);
+    }
+};
+
 std::unique_ptr<Eigensolver> Eigensolver_factory(ev_solver_t ev_solver_type__)
 {
     Eigensolver* ptr;
@@ -0,0 +1,282 @@
+// Copyright (c) 2013-2019 Anton Kozhevnikov, Thomas Schulthess
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+// the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of conditions and the
+//    following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+//    and the following disclaimer in the documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/** \file evp_autotune.hpp
+ *
+ *  \brief Selection of the eigen-value solver and BLACS grid by timing of the representative subspace problems.
+ */
+
+#ifndef __EVP_AUTOTUNE_HPP__
+#define __EVP_AUTOTUNE_HPP__
+
+#include <fstream>
+#include "eigenproblem.hpp"
+#include "utils/json.hpp"
+
+namespace sirius {
+
+/// Default block size of the block-cyclic distribution.
+inline int default_cyclic_block_size(int num_bands__, int npr__, int npc__)
+{
+    double a = std::min(std::log2(double(num_bands__) / npc__), std::log2(double(num_bands__) / npr__));
+    if (a < 1) {
+        return 2;
+    } else {
+        return static_cast<int>(std::min(128.0, std::pow(2.0, static_cast<int>(a))) + 1e-12);
+    }
+}
+
+/// Result of the eigen-solver autotuning.
+struct evp_autotune_result
+{
+    /// Name of the standard eigen-value solver.
+    std::string std_evp_solver_name;
+    /// Name of the generalized eigen-value solver.
+    std::string gen_evp_solver_name;
+    /// Dimensions of the BLACS grid.
+    std::vector<int> blacs_grid_dims;
+};
+
+/// Time the subspace problems for the eigen-value solvers and BLACS grids and pick the fastest combination.
+/** For each compiled CPU solver (LAPACK, ScaLAPACK, ELPA) and each factorization of the communicator size into a
+ *  2D grid (only 1x1 for LAPACK) a generalized and a standard eigen-value problem of size N with nev lowest
+ *  eigen-pairs and one N x N x N matrix multiplication are timed. The choice is stored in a JSON cache keyed by the
+ *  problem size and the number of ranks and is reused by the subsequent runs.
+ *
+ *  The timing is done within the communicator of the eigen-value problem (e.g. comm_band()), so all groups of ranks
+ *  work at the same time as they do in production. The cache is read and written only by the rank 0 of the global
+ *  communicator and its choice is broadcast to all ranks, so that all groups use the same solver. */
+class Evp_autotune
+{
+  private:
+    /// Global communicator.
+    Communicator const& comm_global_;
+
+    /// Communicator of the eigen-value problem.
+    Communicator const& comm_;
+
+    int matrix_size_;
+
+    int nev_;
+
+    int cyclic_block_size_;
+
+    bool real_;
+
+    std::string cache_file_;
+
+    std::string key() const
+    {
+        std::stringstream s;
+        s << (real_ ? "real" : "complex") << "_N" << matrix_size_ << "_nev" << nev_ << "_ranks" << comm_.size();
+        return s.str();
+    }
+
+    template <typename T>
+    static T cast(double_complex z__);
+
+    /// Hermitian test matrix with a spread spectrum.
+    template <typename T>
+    static T a_elem(int i__, int j__)
+    {
+        double a = 1.0 / (1 + std::abs(i__ - j__));
+        if (i__ == j__) {
+            a += i__;
+        }
+        return cast<T>(a * std::exp(double_complex(0, 0.01 * (j__ - i__))));
+    }
+
+    /// Diagonally dominant positive definite test overlap matrix.
+    template <typename T>
+    static T b_elem(int i__, int j__)
+    {
+        return (i__ == j__) ? 1.0 : 0.1 / std::pow(1 + std::abs(i__ - j__), 2);
+    }
+
+    template <typename T>
+    static void fill(dmatrix<T>& m__, std::function<T(int, int)> f__)
+    {
+        #pragma omp parallel for schedule(static)
+        for (int j = 0; j < m__.num_cols_local(); j++) {
+            for (int i = 0; i < m__.num_rows_local(); i++) {
+                m__(i, j) = f__(m__.irow(i), m__.icol(j));
+            }
+        }
+    }
+
+    /// Time a solver on a given grid; return negative value if the solver failed.
+    template <typename T>
+    double time_candidate(Eigensolver& solver__, BLACS_grid const& grid__, int bs__)
+    {
+        int n = matrix_size_;
+
+        dmatrix<T> A(n, n, grid__, bs__, bs__);
+        dmatrix<T> B(n, n, grid__, bs__, bs__);
+        dmatrix<T> Z(n, n, grid__, bs__, bs__);
+        std::vector<double> eval(n);
+
+        fill<T>(A, a_elem<T>);
+        fill<T>(B, b_elem<T>);
+
+        comm_.barrier();
+        double t = -omp_get_wtime();
+        int info = solver__.solve(n, nev_, A, B, eval.data(), Z);
+
+        fill<T>(A, a_elem<T>);
+        info += solver__.solve(n, nev_, A, eval.data(), Z);
+
+        fill<T>(A, a_elem<T>);
+        linalg<CPU>::gemm(0, 0, n, n, n, linalg_const<T>::one(), A, Z, linalg_const<T>::zero(), B);
+        t += omp_get_wtime();
+
+        comm_.template allreduce<int, mpi_op_t::max>(&info, 1);
+        comm_.template allreduce<double, mpi_op_t::max>(&t, 1);
+
+        return (info == 0) ? t : -1;
+    }
+
+    template <typename T>
+    evp_autotune_result run()
+    {
+        PROFILE("sirius::Evp_autotune::run");
+
+        std::vector<std::string> names = {"lapack"};
+#if defined(__SCALAPACK)
+        names.push_back("scalapack");
+#endif
+#if defined(__ELPA)
+        names.push_back("elpa1");
+        names.push_back("elpa2");
+#endif
+
+        evp_autotune_result best;
+        double tbest{-1};
+
+        for (auto& name: names) {
+            auto solver = Eigensolver_factory(get_ev_solver_t(name));
+
+            std::vector<std::vector<int>> grids;
+            if (solver->is_parallel()) {
+                for (int npr = 1; npr <= comm_.size(); npr++) {
+                    if (comm_.size() % npr == 0) {
+                        grids.push_back({npr, comm_.size() / npr});
+                    }
+                }
+            } else {
+                grids.push_back({1, 1});
+            }
+
+            for (auto& g: grids) {
+                std::unique_ptr<BLACS_grid> grid;
+                if (solver->is_parallel()) {
+                    grid = std::unique_ptr<BLACS_grid>(new BLACS_grid(comm_, g[0], g[1]));
+                } else {
+                    grid = std::unique_ptr<BLACS_grid>(new BLACS_grid(Communicator::self(), 1, 1));
+                }
+                int bs = (cyclic_block_size_ > 0) ? cyclic_block_size_ : default_cyclic_block_size(nev_, g[0], g[1]);
+
+                double t = time_candidate<T>(*solver, *grid, bs);
+
+                if (comm_.rank() == 0) {
+                    printf("[evp_autotune] solver: %-10s grid: %i x %i, time: %12.6f sec.\n", name.c_str(), g[0],
+                           g[1], t);
+                }
+                if (t >= 0 && (tbest < 0 || t < tbest)) {
+                    tbest                    = t;
+                    best.std_evp_solver_name = name;
+                    best.gen_evp_solver_name = name;
+                    best.blacs_grid_dims     = g;
+                }
+            }
+        }
+        if (tbest < 0) {
+            TERMINATE("no working eigen-value solver was found");
+        }
+        return best;
+    }
+
+  public:
+    Evp_autotune(Communicator const& comm_global__, Communicator const& comm__, int matrix_size__, int nev__,
+                 int cyclic_block_size__, bool real__, std::string cache_file__)
+        : comm_global_(comm_global__)
+        , comm_(comm__)
+        , matrix_size_(matrix_size__)
+        , nev_(nev__)
+        , cyclic_block_size_(cyclic_block_size__)
+        , real_(real__)
+        , cache_file_(cache_file__)
+    {
+    }
+
+    /// Return cached result or run the autotuning and update the cache.
+    evp_autotune_result find()
+    {
+        nlohmann::json cache;
+        /* global rank 0 reads the cache and broadcasts the content */
+        std::string str;
+        if (comm_global_.rank() == 0 && utils::file_exists(cache_file_)) {
+            std::ifstream ifs(cache_file_);
+            str = std::string((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+        }
+        comm_global_.bcast(str, 0);
+        if (str.size()) {
+            cache = nlohmann::json::parse(str);
+        }
+
+        if (!cache.count(key())) {
+            auto r = real_ ? run<double>() : run<double_complex>();
+
+            /* groups can pick different solvers because of the timing noise; the choice of global rank 0 is used */
+            nlohmann::json entry = {{"std_evp_solver_type", r.std_evp_solver_name},
+                                    {"gen_evp_solver_type", r.gen_evp_solver_name},
+                                    {"blacs_grid_dims", r.blacs_grid_dims}};
+            str = entry.dump();
+            comm_global_.bcast(str, 0);
+            cache[key()] = nlohmann::json::parse(str);
+
+            if (comm_global_.rank() == 0) {
+                std::ofstream ofs(cache_file_, std::ofstream::out | std::ofstream::trunc);
+                ofs << cache.dump(4);
+            }
+        }
+
+        evp_autotune_result r;
+        r.std_evp_solver_name = cache[key()]["std_evp_solver_type"].get<std::string>();
+        r.gen_evp_solver_name = cache[key()]["gen_evp_solver_type"].get<std::string>();
+        r.blacs_grid_dims     = cache[key()]["blacs_grid_dims"].get<std::vector<int>>();
+        return r;
+    }
+};
+
+template <>
+inline double Evp_autotune::cast<double>(double_complex z__)
+{
+    /* drop the phase in the real case; the matrix stays symmetric */
+    return std::abs(z__);
+}
+
+template <>
+inline double_complex Evp_autotune::cast<double_complex>(double_complex z__)
+{
+    return z__;
+}
+
+} // namespace sirius
+
+#endif // __EVP_AUTOTUNE_HPP__
@@ -496,6 +496,27 @@ end interface
 call sirius_update_context_aux(handler)
 end subroutine sirius_update_context
 
+!> @brief Re-bind simulation context to a new structure.
+!> @details The context must be initialized. New lattice vectors and atomic positions are set before this call using
+!> sirius_set_lattice_vectors() and sirius_set_atom_position(). The atom types and cutoffs must stay the same.
+!> G-vectors are regenerated for the new lattice while the radial integrals, atom types and FFT drivers
+!> (if the FFT box is unchanged) are reused. All handlers of the objects that depend on the context (k-point sets,
+!> ground state) must be re-created after this call.
+!> @param [in] handler Simulation context handler.
+subroutine sirius_rebind_context(handler)
+implicit none
+type(C_PTR), intent(in) :: handler
+interface
+subroutine sirius_rebind_context_aux(handler)&
+&bind(C, name="sirius_rebind_context")
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), intent(in) :: handler
+end subroutine
+end interface
+
+call sirius_rebind_context_aux(handler)
+end subroutine sirius_rebind_context
+
 !> @brief Print basic info
 !> @param [in] handler Simulation context handler.
 subroutine sirius_print_info(handler)
@@ -660,21 +681,67 @@ call sirius_find_ground_state_aux(gs_handler,save___ptr)
 end subroutine sirius_find_ground_state
 
 !> @brief Update a ground state object after change of atomic coordinates or lattice vectors.
+!> @details If the extrapolation order is positive, the density, potential and wave-functions of the new atomic configuration
+!> are predicted from the previous ionic steps and used as the starting point of the next call to
+!> sirius_find_ground_state().
 !> @param [in] gs_handler Ground-state handler.
-subroutine sirius_update_ground_state(gs_handler)
+!> @param [in] extrapolation_order Order of density and wave-function extrapolation between ionic steps.
+subroutine sirius_update_ground_state(gs_handler,extrapolation_order)
 implicit none
 type(C_PTR), intent(in) :: gs_handler
+integer(C_INT), optional, target, intent(in) :: extrapolation_order
+type(C_PTR) :: extrapolation_order_ptr
 interface
-subroutine sirius_update_ground_state_aux(gs_handler)&
+subroutine sirius_update_ground_state_aux(gs_handler,extrapolation_order)&
 &bind(C, name="sirius_update_ground_state")
 use, intrinsic :: ISO_C_BINDING
 type(C_PTR), intent(in) :: gs_handler
+type(C_PTR), value, intent(in) :: extrapolation_order
 end subroutine
 end interface
 
-call sirius_update_ground_state_aux(gs_handler)
+extrapolation_order_ptr = C_NULL_PTR
+if (present(extrapolation_order)) extrapolation_order_ptr = C_LOC(extrapolation_order)
+
+call sirius_update_ground_state_aux(gs_handler,extrapolation_order_ptr)
 end subroutine sirius_update_ground_state
 
+!> @brief Run a batch of independent ground-state calculations.
+!> @details The communicator is split into num_groups groups (by default, one group per calculation as long as there are
+!> enough MPI ranks). Calculations are distributed between the groups in a round-robin fashion and the groups run
+!> concurrently. Each element of the output array is the dictionary returned by DFT_ground_state::find(), i.e. the
+!> serialized ground state with the convergence status. The output is identical on all ranks of fcomm.
+!> @param [in] fcomm Communicator shared by all calculations of the batch.
+!> @param [in] inputs JSON array with the input dictionaries (or file names).
+!> @param [in] num_groups Number of groups of MPI ranks.
+!> @param [out] output JSON array with the results of the calculations.
+!> @param [in] output_len Size of the output buffer.
+subroutine sirius_run_batch(fcomm,inputs,num_groups,output,output_len)
+implicit none
+integer(C_INT), intent(in) :: fcomm
+character(C_CHAR), dimension(*), intent(in) :: inputs
+integer(C_INT), optional, target, intent(in) :: num_groups
+character(C_CHAR), dimension(*), intent(out) :: output
+integer(C_INT), intent(in) :: output_len
+type(C_PTR) :: num_groups_ptr
+interface
+subroutine sirius_run_batch_aux(fcomm,inputs,num_groups,output,output_len)&
+&bind(C, name="sirius_run_batch")
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT), intent(in) :: fcomm
+character(C_CHAR), dimension(*), intent(in) :: inputs
+type(C_PTR), value, intent(in) :: num_groups
+character(C_CHAR), dimension(*), intent(out) :: output
+integer(C_INT), intent(in) :: output_len
+end subroutine
+end interface
+
+num_groups_ptr = C_NULL_PTR
+if (present(num_groups)) num_groups_ptr = C_LOC(num_groups)
+
+call sirius_run_batch_aux(fcomm,inputs,num_groups_ptr,output,output_len)
+end subroutine sirius_run_batch
+
 !> @brief Add new atom type to the unit cell.
 !> @param [in] handler Simulation context handler.
 !> @param [in] label Atom type unique label.
@@ -970,6 +1037,38 @@ end interface
 call sirius_set_atom_position_aux(handler,ia,position)
 end subroutine sirius_set_atom_position
 
+!> @brief Create a mapping between the external and SIRIUS G-vectors.
+!> @details The communication plan between the external distribution of G-vectors and the distribution of SIRIUS is computed
+!> once and can be passed to sirius_set_pw_coeffs() and sirius_get_pw_coeffs() instead of the list of G-vectors.
+!> The communicator must contain the same ranks as the communicator of the simulation context and must stay valid
+!> while the mapping is used. The mapping must be re-created after sirius_rebind_context(). The handler is released
+!> with sirius_free_handler().
+!> @param [in] handler Simulation context handler.
+!> @param [in] ngv Local number of G-vectors.
+!> @param [in] gvl List of G-vectors in lattice coordinates (Miller indices).
+!> @param [in] comm MPI communicator used in distribution of G-vectors.
+function sirius_create_pw_coeffs_mapping(handler,ngv,gvl,comm) result(res)
+implicit none
+type(C_PTR), intent(in) :: handler
+integer(C_INT), intent(in) :: ngv
+integer(C_INT), intent(in) :: gvl
+integer(C_INT), intent(in) :: comm
+type(C_PTR) :: res
+interface
+function sirius_create_pw_coeffs_mapping_aux(handler,ngv,gvl,comm) result(res)&
+&bind(C, name="sirius_create_pw_coeffs_mapping")
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), intent(in) :: handler
+integer(C_INT), intent(in) :: ngv
+integer(C_INT), intent(in) :: gvl
+integer(C_INT), intent(in) :: comm
+type(C_PTR) :: res
+end function
+end interface
+
+res = sirius_create_pw_coeffs_mapping_aux(handler,ngv,gvl,comm)
+end function sirius_create_pw_coeffs_mapping
+
 !> @brief Set plane-wave coefficients of a periodic function.
 !> @param [in] handler Ground state handler.
 !> @param [in] label Label of the function.
@@ -978,8 +1077,9 @@ end subroutine sirius_set_atom_position
 !> @param [in] ngv Local number of G-vectors.
 !> @param [in] gvl List of G-vectors in lattice coordinates (Miller indices).
 !> @param [in] comm MPI communicator used in distribution of G-vectors
+!> @param [in] mapping Handler of the G-vector mapping (replaces ngv, gvl and comm).
 subroutine sirius_set_pw_coeffs(handler,label,pw_coeffs,transform_to_rg,ngv,gvl,&
-&comm)
+&comm,mapping)
 implicit none
 type(C_PTR), intent(in) :: handler
 character(C_CHAR), dimension(*), intent(in) :: label
@@ -988,13 +1088,15 @@ logical(C_BOOL), optional, target, intent(in) :: transform_to_rg
 integer(C_INT), optional, target, intent(in) :: ngv
 integer(C_INT), optional, target, intent(in) :: gvl
 integer(C_INT), optional, target, intent(in) :: comm
+type(C_PTR), optional, target, intent(in) :: mapping
 type(C_PTR) :: transform_to_rg_ptr
 type(C_PTR) :: ngv_ptr
 type(C_PTR) :: gvl_ptr
 type(C_PTR) :: comm_ptr
+type(C_PTR) :: mapping_ptr
 interface
 subroutine sirius_set_pw_coeffs_aux(handler,label,pw_coeffs,transform_to_rg,ngv,&
-&gvl,comm)&
+&gvl,comm,mapping)&
 &bind(C, name="sirius_set_pw_coeffs")
 use, intrinsic :: ISO_C_BINDING
 type(C_PTR), intent(in) :: handler
@@ -1004,6 +1106,7 @@ type(C_PTR), value, intent(in) :: transform_to_rg
 type(C_PTR), value, intent(in) :: ngv
 type(C_PTR), value, intent(in) :: gvl
 type(C_PTR), value, intent(in) :: comm
+type(C_PTR), value, intent(in) :: mapping
 end subroutine
 end interface
 
@@ -1019,8 +1122,11 @@ if (present(gvl)) gvl_ptr = C_LOC(gvl)
 comm_ptr = C_NULL_PTR
 if (present(comm)) comm_ptr = C_LOC(comm)
 
+mapping_ptr = C_NULL_PTR
+if (present(mapping)) mapping_ptr = C_LOC(mapping)
+
 call sirius_set_pw_coeffs_aux(handler,label,pw_coeffs,transform_to_rg_ptr,ngv_ptr,&
-&gvl_ptr,comm_ptr)
+&gvl_ptr,comm_ptr,mapping_ptr)
 end subroutine sirius_set_pw_coeffs
 
 !> @brief Get plane-wave coefficients of a periodic function.
@@ -1030,7 +1136,8 @@ end subroutine sirius_set_pw_coeffs
 !> @param [in] ngv Local number of G-vectors.
 !> @param [in] gvl List of G-vectors in lattice coordinates (Miller indices).
 !> @param [in] comm MPI communicator used in distribution of G-vectors
-subroutine sirius_get_pw_coeffs(handler,label,pw_coeffs,ngv,gvl,comm)
+!> @param [in] mapping Handler of the G-vector mapping (replaces ngv, gvl and comm).
+subroutine sirius_get_pw_coeffs(handler,label,pw_coeffs,ngv,gvl,comm,mapping)
 implicit none
 type(C_PTR), intent(in) :: handler
 character(C_CHAR), dimension(*), intent(in) :: label
@@ -1038,11 +1145,13 @@ complex(C_DOUBLE), intent(in) :: pw_coeffs
 integer(C_INT), optional, target, intent(in) :: ngv
 integer(C_INT), optional, target, intent(in) :: gvl
 integer(C_INT), optional, target, intent(in) :: comm
+type(C_PTR), optional, target, intent(in) :: mapping
 type(C_PTR) :: ngv_ptr
 type(C_PTR) :: gvl_ptr
 type(C_PTR) :: comm_ptr
+type(C_PTR) :: mapping_ptr
 interface
-subroutine sirius_get_pw_coeffs_aux(handler,label,pw_coeffs,ngv,gvl,comm)&
+subroutine sirius_get_pw_coeffs_aux(handler,label,pw_coeffs,ngv,gvl,comm,mapping)&
 &bind(C, name="sirius_get_pw_coeffs")
 use, intrinsic :: ISO_C_BINDING
 type(C_PTR), intent(in) :: handler
@@ -1051,6 +1160,7 @@ complex(C_DOUBLE), intent(in) :: pw_coeffs
 type(C_PTR), value, intent(in) :: ngv
 type(C_PTR), value, intent(in) :: gvl
 type(C_PTR), value, intent(in) :: comm
+type(C_PTR), value, intent(in) :: mapping
 end subroutine
 end interface
 
@@ -1063,7 +1173,10 @@ if (present(gvl)) gvl_ptr = C_LOC(gvl)
 comm_ptr = C_NULL_PTR
 if (present(comm)) comm_ptr = C_LOC(comm)
 
-call sirius_get_pw_coeffs_aux(handler,label,pw_coeffs,ngv_ptr,gvl_ptr,comm_ptr)
+mapping_ptr = C_NULL_PTR
+if (present(mapping)) mapping_ptr = C_LOC(mapping)
+
+call sirius_get_pw_coeffs_aux(handler,label,pw_coeffs,ngv_ptr,gvl_ptr,comm_ptr,mapping_ptr)
 end subroutine sirius_get_pw_coeffs
 
 !> @brief Get atom type contribution to plane-wave coefficients of a periodic function.
@@ -268,10 +268,20 @@ struct Iterative_solver_input
     bool init_eval_old_{true};
 
     /// Tell how to initialize the subspace.
-    /** It can be either "lcao", i.e. start from the linear combination of atomic orbitals or "random" –- start from
-     *  the randomized wave functions. */
+    /** It can be either "lcao", i.e. start from the linear combination of atomic orbitals, "random" –- start from
+     *  the randomized wave functions or "chebyshev" -- start from the randomized wave functions refined by a few
+     *  steps of the Chebyshev filter. */
     std::string init_subspace_{"lcao"};
 
+    /// Order of the Chebyshev filter used to initialize the subspace.
+    int init_chebyshev_order_{4};
+
+    /// Method to orthonormalize the new basis functions.
+    /** It can be "cholesky" (factorization of the distributed overlap matrix), "cholesky_qr2" or "tsqr"; the last
+     *  two compute the triangular factor redundantly on each rank and fall back to "cholesky" for ill-conditioned
+     *  blocks. */
+    std::string orthogonalization_{"cholesky"};
+
     void read(json const& parser)
     {
         if (parser.count("iterative_solver")) {
@@ -289,6 +299,8 @@ struct Iterative_solver_input
             init_eval_old_          = section.value("init_eval_old", init_eval_old_);
             init_subspace_          = section.value("init_subspace", init_subspace_);
             std::transform(init_subspace_.begin(), init_subspace_.end(), init_subspace_.begin(), ::tolower);
+            init_chebyshev_order_   = section.value("init_chebyshev_order", init_chebyshev_order_);
+            orthogonalization_      = section.value("orthogonalization", orthogonalization_);
         }
     }
 };
@@ -330,6 +342,17 @@ struct Control_input
     /// Generalized eigen-value solver to use.
     std::string gen_evp_solver_name_{""};
 
+    /// Maximum size of the distributed eigen-value problem which is solved redundantly on each rank with LAPACK.
+    /** Used only with the parallel eigen-value solvers; 0 disables the replicated solver. */
+    int evp_replicated_max_size_{0};
+
+    /// Choose the eigen-value solver and the BLACS grid by timing the subspace problems at startup.
+    /** Used only if the solver types are not set explicitly. */
+    bool evp_autotune_{false};
+
+    /// File with the cached results of the eigen-value solver autotuning.
+    std::string evp_autotune_cache_{"sirius_evp_autotune.json"};
+
     /// Coarse grid FFT mode ("serial" or "parallel").
     std::string fft_mode_{"serial"};
 
@@ -390,6 +413,14 @@ struct Control_input
     /// Number of atoms in the beta-projectors chunk.
     int beta_chunk_size_{256};
 
+    /// If true, the non-local part of the Hamiltonian is applied on the real-space grid points around atoms.
+    bool beta_real_space_{false};
+
+    /// Ratio between the radius of the mask function and the cutoff radius of the beta-projectors.
+    /** This parameter is used in the real-space mode of beta-projectors and controls the error against the
+        reciprocal-space application of the non-local operator. */
+    double beta_mask_ratio_{2.0};
+
     void read(json const& parser)
     {
         if (parser.count("control")) {
@@ -398,6 +429,9 @@ struct Control_input
             cyclic_block_size_   = section.value("cyclic_block_size", cyclic_block_size_);
             std_evp_solver_name_ = section.value("std_evp_solver_type", std_evp_solver_name_);
             gen_evp_solver_name_ = section.value("gen_evp_solver_type", gen_evp_solver_name_);
+            evp_replicated_max_size_ = section.value("evp_replicated_max_size", evp_replicated_max_size_);
+            evp_autotune_        = section.value("evp_autotune", evp_autotune_);
+            evp_autotune_cache_  = section.value("evp_autotune_cache", evp_autotune_cache_);
             processing_unit_     = section.value("processing_unit", processing_unit_);
             fft_mode_            = section.value("fft_mode", fft_mode_);
             reduce_gvec_         = section.value("reduce_gvec", reduce_gvec_);
@@ -416,6 +450,8 @@ struct Control_input
             print_neighbors_     = section.value("print_neighbors", print_neighbors_);
             memory_usage_        = section.value("memory_usage", memory_usage_);
             beta_chunk_size_     = section.value("beta_chunk_size", beta_chunk_size_);
+            beta_real_space_     = section.value("beta_real_space", beta_real_space_);
+            beta_mask_ratio_     = section.value("beta_mask_ratio", beta_mask_ratio_);
 
             auto strings = {&std_evp_solver_name_, &gen_evp_solver_name_, &fft_mode_, &processing_unit_, &memory_usage_};
             for (auto s : strings) {
@@ -427,6 +463,9 @@ struct Control_input
             if (std::find(kw.begin(), kw.end(), memory_usage_) == kw.end()) {
                 TERMINATE("wrong memory_usage input");
             }
+            if (beta_mask_ratio_ <= 1) {
+                TERMINATE("beta_mask_ratio must be larger than 1");
+            }
         }
     }
 };
@@ -499,6 +538,12 @@ struct Parameters_input
     /// True if this is a molecule calculation.
     bool molecule_{false};
 
+    /// Poisson solver for the molecule calculation.
+    /** "cutoff" uses the spherically truncated Coulomb kernel in the original cell; "hockney" uses the truncated
+     *  kernel on the doubled grid, which allows for much less vacuum in the cell. "hockney" is available in the
+     *  full-potential case only. */
+    std::string molecule_poisson_solver_{"cutoff"};
+
     /// True if gamma-point (real) version of the PW code is used.
     bool gamma_point_{false};
 
@@ -568,6 +613,7 @@ struct Parameters_input
             energy_tol_     = parser["parameters"].value("energy_tol", energy_tol_);
             potential_tol_  = parser["parameters"].value("potential_tol", potential_tol_);
             molecule_       = parser["parameters"].value("molecule", molecule_);
+            molecule_poisson_solver_ = parser["parameters"].value("molecule_poisson_solver", molecule_poisson_solver_);
             nn_radius_      = parser["parameters"].value("nn_radius", nn_radius_);
             reduce_aux_bf_  = parser["parameters"].value("reduce_aux_bf", reduce_aux_bf_);
 
@@ -601,17 +647,21 @@ struct Settings_input
     double auto_enu_tol_{0};
     std::string radial_grid_{"exponential, 1.0"};
 
+    /// Order of the density and wave-function extrapolation between ionic steps (0 means no extrapolation).
+    int extrapolation_order_{0};
+
     void read(json const& parser)
     {
         if (parser.count("settings")) {
-            nprii_vloc_       = parser["settings"].value("nprii_vloc", nprii_vloc_);
-            nprii_beta_       = parser["settings"].value("nprii_beta", nprii_beta_);
-            nprii_aug_        = parser["settings"].value("nprii_aug", nprii_aug_);
-            nprii_rho_core_   = parser["settings"].value("nprii_rho_core", nprii_rho_core_);
-            always_update_wf_ = parser["settings"].value("always_update_wf", always_update_wf_);
-            mixer_rss_min_    = parser["settings"].value("mixer_rss_min", mixer_rss_min_);
-            auto_enu_tol_     = parser["settings"].value("auto_enu_tol", auto_enu_tol_);
-            radial_grid_      = parser["settings"].value("radial_grid", radial_grid_);
+            nprii_vloc_          = parser["settings"].value("nprii_vloc", nprii_vloc_);
+            nprii_beta_          = parser["settings"].value("nprii_beta", nprii_beta_);
+            nprii_aug_           = parser["settings"].value("nprii_aug", nprii_aug_);
+            nprii_rho_core_      = parser["settings"].value("nprii_rho_core", nprii_rho_core_);
+            always_update_wf_    = parser["settings"].value("always_update_wf", always_update_wf_);
+            mixer_rss_min_       = parser["settings"].value("mixer_rss_min", mixer_rss_min_);
+            auto_enu_tol_        = parser["settings"].value("auto_enu_tol", auto_enu_tol_);
+            radial_grid_         = parser["settings"].value("radial_grid", radial_grid_);
+            extrapolation_order_ = parser["settings"].value("extrapolation_order", extrapolation_order_);
         }
     }
 };
@@ -178,20 +178,23 @@ class Matching_coefficients
         alm_b_ = mdarray<double_complex, 4>(3, num_gkvec_, lmax_apw__ + 1, unit_cell_.num_atom_types());
         alm_b_.zero();
 
-        /* value and first two derivatives of spherical Bessel functions */
-        mdarray<double, 2> sbessel_mt(lmax_apw__ + 2, 3);
+        /* spherical Bessel functions at the MT boundary for all G+k vectors */
+        mdarray<double, 2> sbessel_mt(lmax_apw__ + 2, num_gkvec_);
+        std::vector<double> RGk(num_gkvec_);
 
-        for (int igk = 0; igk < num_gkvec_; igk++) {
-            for (int iat = 0; iat < unit_cell_.num_atom_types(); iat++) {
-                double R = unit_cell_.atom_type(iat).mt_radius();
+        for (int iat = 0; iat < unit_cell_.num_atom_types(); iat++) {
+            double R = unit_cell_.atom_type(iat).mt_radius();
 
-                double RGk = R * gkvec_len_[igk];
+            for (int igk = 0; igk < num_gkvec_; igk++) {
+                RGk[igk] = R * gkvec_len_[igk];
+            }
+            Spherical_Bessel_functions::sbessel(lmax_apw__ + 1, num_gkvec_, RGk.data(),
+                                                [&](int l, int igk) -> double& { return sbessel_mt(l, igk); });
 
+            for (int igk = 0; igk < num_gkvec_; igk++) {
                 /* compute values and first and second derivatives of the spherical Bessel functions at the MT boundary
-                 */
-                gsl_sf_bessel_jl_array(lmax_apw__ + 1, RGk, &sbessel_mt(0, 0));
-
-                /* Bessel function derivative: f_{{n}}^{{\prime}}(z)=-f_{{n+1}}(z)+(n/z)f_{{n}}(z)
+                 *
+                 * Bessel function derivative: f_{{n}}^{{\prime}}(z)=-f_{{n+1}}(z)+(n/z)f_{{n}}(z)
                  *
                  * In[]:= FullSimplify[D[SphericalBesselJ[n,a*x],{x,1}]]
                  * Out[]= (n SphericalBesselJ[n,a x])/x-a SphericalBesselJ[1+n,a x]
@@ -200,17 +203,16 @@ class Matching_coefficients
                  * Out[]= (((-1+n) n-a^2 x^2) SphericalBesselJ[n,a x]+2 a x SphericalBesselJ[1+n,a x])/x^2
                  */
                 for (int l = 0; l <= lmax_apw__; l++) {
-                    sbessel_mt(l, 1) = -sbessel_mt(l + 1, 0) * gkvec_len_[igk] + (l / R) * sbessel_mt(l, 0);
-                    sbessel_mt(l, 2) = 2 * gkvec_len_[igk] * sbessel_mt(l + 1, 0) / R +
-                                       ((l - 1) * l - std::pow(RGk, 2)) * sbessel_mt(l, 0) / std::pow(R, 2);
-                }
+                    double jl   = sbessel_mt(l, igk);
+                    double djl  = -sbessel_mt(l + 1, igk) * gkvec_len_[igk] + (l / R) * jl;
+                    double d2jl = 2 * gkvec_len_[igk] * sbessel_mt(l + 1, igk) / R +
+                                  ((l - 1) * l - std::pow(RGk[igk], 2)) * jl / std::pow(R, 2);
 
-                for (int l = 0; l <= lmax_apw__; l++) {
                     double_complex z       = std::pow(double_complex(0, 1), l);
                     double f               = fourpi / std::sqrt(unit_cell_.omega());
-                    alm_b_(0, igk, l, iat) = z * f * sbessel_mt(l, 0);
-                    alm_b_(1, igk, l, iat) = z * f * sbessel_mt(l, 1);
-                    alm_b_(2, igk, l, iat) = z * f * sbessel_mt(l, 2);
+                    alm_b_(0, igk, l, iat) = z * f * jl;
+                    alm_b_(1, igk, l, iat) = z * f * djl;
+                    alm_b_(2, igk, l, iat) = z * f * d2jl;
                 }
             }
         }
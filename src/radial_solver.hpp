@@ -144,6 +144,86 @@ class Radial_solver
     /// Electronic part of potential.
     Spline<double> ve_;
 
+    /// Total potential at the grid points.
+    std::vector<double> v_;
+
+    /// Total potential at the mid-points of the grid intervals.
+    /** The values don't depend on energy and are computed once instead of the spline evaluation in each RK4 step. */
+    std::vector<double> v_half_;
+
+    /// Radial solutions at the last grid point for a batch of energies.
+    struct surface_t
+    {
+        /// Number of nodes of p(r).
+        std::vector<int> nn;
+        /// Scaled value of p(R).
+        std::vector<double> p;
+        /// Scaled value of p'(R).
+        std::vector<double> dpdr;
+        /// Number of 1e-4 rescalings applied to the solution during the integration.
+        std::vector<int> nscale;
+
+        /// Logarithm of the absolute value of the unscaled function.
+        inline double ln_abs(double f__, int j__) const
+        {
+            return std::log(std::abs(f__)) - nscale[j__] * std::log(1e-4);
+        }
+    };
+
+    /// Relativistic mass for a given energy and potential.
+    template <relativity_t rel>
+    static inline double rel_mass(double sq_alpha_half__, double enu__, double v__)
+    {
+        switch (rel) {
+            case relativity_t::none: {
+                return 1.0;
+            }
+            case relativity_t::koelling_harmon: {
+                return 1.0 + sq_alpha_half__ * (enu__ - v__);
+            }
+            case relativity_t::zora: {
+                return 1.0 - sq_alpha_half__ * v__;
+            }
+            case relativity_t::iora: {
+                double m0 = 1.0 - sq_alpha_half__ * v__;
+                return m0 / (1 - sq_alpha_half__ * enu__ / m0);
+            }
+            default: {
+                return 1.0;
+            }
+        }
+    }
+
+    /// Relativistic quantum number kappa of the Dirac equation.
+    static inline double dirac_kappa(int l__, int k__)
+    {
+        if (k__ == l__) {
+            return k__;
+        } else if (k__ == l__ + 1) {
+            return -k__;
+        } else {
+            TERMINATE("wrong k");
+        }
+        return 0;
+    }
+
+    /// Values of p(r) and q(r) at the first grid point from the r->0 asymptotics.
+    template <relativity_t rel>
+    inline std::array<double, 2> solution_at_origin(int l__, double kappa__) const
+    {
+        double x = radial_grid_[0];
+        if (rel != relativity_t::dirac) {
+            if (l__ == 0) {
+                return {2 * zn_ * x, -std::pow(zn_, 2) * x};
+            } else {
+                return {std::pow(x, l__ + 1), std::pow(x, l__) * l__ / 2};
+            }
+        } else {
+            double b = std::sqrt(std::pow(kappa__, 2) - std::pow(zn_ / speed_of_light, 2));
+            return {std::pow(x, b), std::pow(x, b) * speed_of_light * (b + kappa__) / zn_};
+        }
+    }
+
     /// Integrate system of two first-order differential equations forward starting from the origin.
     /** Use Runge-Kutta 4th order method */
     template <relativity_t rel, bool prevent_overflow>
@@ -166,42 +246,16 @@ class Radial_solver
 
         double ll_half = l__ * (l__ + 1) / 2.0;
 
-        double kappa{0};
-        if (rel == relativity_t::dirac) {
-            if (k__ == l__) {
-                kappa = k__;
-            } else if (k__ == l__ + 1) {
-                kappa = -k__;
-            } else {
-                TERMINATE("wrong k");
-            }
-        }
+        double kappa = (rel == relativity_t::dirac) ? dirac_kappa(l__, k__) : 0;
 
         auto rel_mass = [sq_alpha_half](double enu__, double v__) -> double {
-            switch (rel) {
-                case relativity_t::none: {
-                    return 1.0;
-                }
-                case relativity_t::koelling_harmon: {
-                    return 1.0 + sq_alpha_half * (enu__ - v__);
-                }
-                case relativity_t::zora: {
-                    return 1.0 - sq_alpha_half * v__;
-                }
-                case relativity_t::iora: {
-                    double m0 = 1.0 - sq_alpha_half * v__;
-                    return m0 / (1 - sq_alpha_half * enu__ / m0);
-                }
-                default: {
-                    return 1.0;
-                }
-            }
+            return Radial_solver::rel_mass<rel>(sq_alpha_half, enu__, v__);
         };
 
         /* try to find classical turning point */
         int idx_ctp{-1};
         for (int ir = 0; ir < nr; ir++) {
-            if (ve_(ir) - zn_ * radial_grid_.x_inv(ir) > enu__) {
+            if (v_[ir] > enu__) {
                 idx_ctp = ir;
                 break;
             }
@@ -227,19 +281,9 @@ class Radial_solver
         double chi_q2 = chi_q__(0);
 
         /* r->0 asymptotics */
-        if (rel != relativity_t::dirac) {
-            if (l__ == 0) {
-                p__[0] = 2 * zn_ * x2;
-                q__[0] = -std::pow(zn_, 2) * x2;
-            } else {
-                p__[0] = std::pow(x2, l__ + 1);
-                q__[0] = std::pow(x2, l__) * l__ / 2;
-            }
-        } else {
-            double b = std::sqrt(std::pow(kappa, 2) - std::pow(zn_ / speed_of_light, 2));
-            p__[0]   = std::pow(x2, b);
-            q__[0]   = std::pow(x2, b) * speed_of_light * (b + kappa) / zn_;
-        }
+        auto pq0 = solution_at_origin<rel>(l__, kappa);
+        p__[0]   = pq0[0];
+        q__[0]   = pq0[1];
 
         // p__[0] = std::pow(radial_grid_[0], l_ + 1);
         // if (l_ == 0)
@@ -277,7 +321,7 @@ class Radial_solver
             double xinv1  = 1.0 / x1;
             double chi_p1 = chi_p__(i, h_half);
             double chi_q1 = chi_q__(i, h_half);
-            double v1     = ve_(i, h_half) - zn_ * xinv1;
+            double v1     = v_half_[i];
             double M1     = rel_mass(enu__, v1);
 
             /* next point */
@@ -285,7 +329,7 @@ class Radial_solver
             xinv2  = radial_grid_.x_inv(i + 1);
             chi_p2 = chi_p__(i + 1);
             chi_q2 = chi_q__(i + 1);
-            v2     = ve_(i + 1) - zn_ * xinv2;
+            v2     = v_[i + 1];
             M2     = rel_mass(enu__, v2);
 
             if (rel == relativity_t::none || rel == relativity_t::koelling_harmon || rel == relativity_t::zora) {
@@ -422,7 +466,7 @@ class Radial_solver
 
         for (int i = 0; i < nr; i++) {
             if (rel == relativity_t::none || rel == relativity_t::koelling_harmon || rel == relativity_t::zora) {
-                double V  = ve_(i) - zn_ * radial_grid_.x_inv(i);
+                double V  = v_[i];
                 double M  = rel_mass(enu__, V);
                 double v1 = ll_half / M / std::pow(radial_grid_[i], 2);
 
@@ -433,7 +477,7 @@ class Radial_solver
                 dqdr__[i] = (V - enu__ + v1) * p__[i] - q__[i] * radial_grid_.x_inv(i) + chi_q__(i);
             }
             if (rel == relativity_t::iora) {
-                double V  = ve_(i) - zn_ * radial_grid_.x_inv(i);
+                double V  = v_[i];
                 double M  = rel_mass(enu__, V);
                 double M0 = 1 - sq_alpha_half * V;
                 double v1 = ll_half / M0 / std::pow(radial_grid_[i], 2);
@@ -446,7 +490,7 @@ class Radial_solver
                 dqdr__[i] = (V - enu__ + v1 - v2) * p__[i] - q__[i] * radial_grid_.x_inv(i) + chi_q__(i);
             }
             if (rel == relativity_t::dirac) {
-                double V = ve_(i) - zn_ * radial_grid_.x_inv(i);
+                double V = v_[i];
                 /* P' = ... */
                 dpdr__[i] = alpha * (2 * rest_energy + enu__ - V) * q__[i] - kappa * p__[i] * radial_grid_.x_inv(i);
                 /* Q' = ... */
@@ -457,6 +501,315 @@ class Radial_solver
         return nn;
     }
 
+    /// Integrate the radial equations forward for a batch of energies in lockstep.
+    /** Only the surface values and the number of nodes are computed; this is what the energy searches need.
+     *  The energy-independent quantities are evaluated once per grid interval and the inner loop over the
+     *  energies is free of branches, so it can be vectorized. The solutions are rescaled by 1e-4 whenever
+     *  |p| exceeds 1e4; this keeps the sign and the number of nodes. */
+    template <relativity_t rel>
+    void integrate_forward_rk4(int l__, int k__, std::vector<double> const& enu__, surface_t& s__) const
+    {
+        int nb = static_cast<int>(enu__.size());
+        int nr = num_points();
+
+        double rest_energy   = std::pow(speed_of_light, 2);
+        double alpha         = 1.0 / speed_of_light;
+        double sq_alpha_half = (rel == relativity_t::none) ? 0 : 0.5 / rest_energy;
+        double ll_half       = l__ * (l__ + 1) / 2.0;
+        double kappa         = (rel == relativity_t::dirac) ? dirac_kappa(l__, k__) : 0;
+
+        auto pq0 = solution_at_origin<rel>(l__, kappa);
+
+        std::vector<double> p(nb, pq0[0]);
+        std::vector<double> q(nb, pq0[1]);
+        s__.nn     = std::vector<int>(nb, 0);
+        s__.nscale = std::vector<int>(nb, 0);
+
+        double const* enu = enu__.data();
+        int* nn           = s__.nn.data();
+        int* nscale       = s__.nscale.data();
+
+        for (int i = 0; i < nr - 1; i++) {
+            double x0     = radial_grid_[i];
+            double xinv0  = radial_grid_.x_inv(i);
+            double h      = radial_grid_.dx(i);
+            double h_half = h / 2;
+            double x1     = x0 + h_half;
+            double xinv1  = 1.0 / x1;
+            double xinv2  = radial_grid_.x_inv(i + 1);
+            double v0     = v_[i];
+            double v1     = v_half_[i];
+            double v2     = v_[i + 1];
+            double a0     = ll_half * std::pow(xinv0, 2);
+            double a1     = ll_half * std::pow(xinv1, 2);
+            double a2     = ll_half * std::pow(xinv2, 2);
+            /* energy-independent part of IORA mass */
+            double m0 = 1 - sq_alpha_half * v0;
+            double m1 = 1 - sq_alpha_half * v1;
+            double m2 = 1 - sq_alpha_half * v2;
+
+            #pragma omp simd
+            for (int j = 0; j < nb; j++) {
+                double e  = enu[j];
+                double p0 = p[j];
+                double q0 = q[j];
+                double pk0, pk1, pk2, pk3, qk0, qk1, qk2, qk3;
+
+                if (rel == relativity_t::dirac) {
+                    pk0 = alpha * (2 * rest_energy + e - v0) * q0 - kappa * p0 * xinv0;
+                    qk0 = alpha * (v0 - e) * p0 + kappa * q0 * xinv0;
+
+                    pk1 = alpha * (2 * rest_energy + e - v1) * (q0 + qk0 * h_half) -
+                          kappa * (p0 + pk0 * h_half) * xinv1;
+                    qk1 = alpha * (v1 - e) * (p0 + pk0 * h_half) + kappa * (q0 + qk0 * h_half) * xinv1;
+
+                    pk2 = alpha * (2 * rest_energy + e - v1) * (q0 + qk1 * h_half) -
+                          kappa * (p0 + pk1 * h_half) * xinv1;
+                    qk2 = alpha * (v1 - e) * (p0 + pk1 * h_half) + kappa * (q0 + qk1 * h_half) * xinv1;
+
+                    pk3 = alpha * (2 * rest_energy + e - v2) * (q0 + qk2 * h) - kappa * (p0 + pk2 * h) * xinv2;
+                    qk3 = alpha * (v2 - e) * (p0 + pk2 * h) + kappa * (q0 + qk2 * h) * xinv2;
+                } else {
+                    double M0 = rel_mass<rel>(sq_alpha_half, e, v0);
+                    double M1 = rel_mass<rel>(sq_alpha_half, e, v1);
+                    double M2 = rel_mass<rel>(sq_alpha_half, e, v2);
+                    /* effective potential V - E + l(l+1) / 2Mr^2 */
+                    double w0, w1, w2;
+                    if (rel == relativity_t::iora) {
+                        w0 = v0 - e + a0 / m0 - sq_alpha_half * a0 * e / std::pow(m0, 2);
+                        w1 = v1 - e + a1 / m1 - sq_alpha_half * a1 * e / std::pow(m1, 2);
+                        w2 = v2 - e + a2 / m2 - sq_alpha_half * a2 * e / std::pow(m2, 2);
+                    } else {
+                        w0 = v0 - e + a0 / M0;
+                        w1 = v1 - e + a1 / M1;
+                        w2 = v2 - e + a2 / M2;
+                    }
+
+                    pk0 = 2 * M0 * q0 + p0 * xinv0;
+                    qk0 = w0 * p0 - q0 * xinv0;
+
+                    pk1 = 2 * M1 * (q0 + qk0 * h_half) + (p0 + pk0 * h_half) * xinv1;
+                    qk1 = w1 * (p0 + pk0 * h_half) - (q0 + qk0 * h_half) * xinv1;
+
+                    pk2 = 2 * M1 * (q0 + qk1 * h_half) + (p0 + pk1 * h_half) * xinv1;
+                    qk2 = w1 * (p0 + pk1 * h_half) - (q0 + qk1 * h_half) * xinv1;
+
+                    pk3 = 2 * M2 * (q0 + qk2 * h) + (p0 + pk2 * h) * xinv2;
+                    qk3 = w2 * (p0 + pk2 * h) - (q0 + qk2 * h) * xinv2;
+                }
+                double p2 = p0 + (pk0 + 2 * (pk1 + pk2) + pk3) * h / 6.0;
+                double q2 = q0 + (qk0 + 2 * (qk1 + qk2) + qk3) * h / 6.0;
+
+                nn[j] += (p0 * p2 < 0) ? 1 : 0;
+
+                double f = (std::abs(p2) > 1e4) ? 1e-4 : 1.0;
+                nscale[j] += (std::abs(p2) > 1e4) ? 1 : 0;
+
+                p[j] = p2 * f;
+                q[j] = q2 * f;
+            }
+        }
+
+        s__.p    = p;
+        s__.dpdr = std::vector<double>(nb);
+        double V = v_[nr - 1];
+        for (int j = 0; j < nb; j++) {
+            if (rel == relativity_t::dirac) {
+                s__.dpdr[j] = alpha * (2 * rest_energy + enu[j] - V) * q[j] - kappa * p[j] / radial_grid_.last();
+            } else {
+                s__.dpdr[j] = 2 * rel_mass<rel>(sq_alpha_half, enu[j], V) * q[j] + p[j] / radial_grid_.last();
+            }
+        }
+    }
+
+    /// Surface values of the radial solutions for a batch of energies.
+    surface_t integrate_surface(relativity_t rel__, int l__, int k__, std::vector<double> const& enu__) const
+    {
+        surface_t s;
+        switch (rel__) {
+            case relativity_t::none: {
+                integrate_forward_rk4<relativity_t::none>(l__, k__, enu__, s);
+                break;
+            }
+            case relativity_t::koelling_harmon: {
+                integrate_forward_rk4<relativity_t::koelling_harmon>(l__, k__, enu__, s);
+                break;
+            }
+            case relativity_t::zora: {
+                integrate_forward_rk4<relativity_t::zora>(l__, k__, enu__, s);
+                break;
+            }
+            case relativity_t::iora: {
+                integrate_forward_rk4<relativity_t::iora>(l__, k__, enu__, s);
+                break;
+            }
+            case relativity_t::dirac: {
+                integrate_forward_rk4<relativity_t::dirac>(l__, k__, enu__, s);
+                break;
+            }
+            default: {
+                TERMINATE_NOT_IMPLEMENTED
+            }
+        }
+        return s;
+    }
+
+    /// Refine the root of a function bracketed by two energies.
+    /** The function is given by the logarithm of its absolute value and a flag telling if it has the sign of f(a).
+     *  The logarithm keeps the values of the exponentially growing solutions comparable. The secant step is
+     *  taken inside the bracket (Illinois variant of the regula falsi); the bisection step is used when the
+     *  bracket doesn't shrink fast enough. Iterations stop when the bracket is smaller than tol or the function
+     *  value is smaller than ftol. Returns the last evaluated energy. */
+    template <typename F>
+    static double refine_root(F&& f__, double& a__, double ln_fa__, double& b__, double ln_fb__, double tol__,
+                              double ftol__ = 0)
+    {
+        double ln_ftol = (ftol__ > 0) ? std::log(ftol__) : -std::numeric_limits<double>::infinity();
+        double c{a__};
+        int side{0};
+        int nslow{0};
+        double w = std::abs(b__ - a__);
+        for (int iter = 0; iter < 200 && std::abs(b__ - a__) > tol__; iter++) {
+            /* root of the secant: c = a + t (b - a), t = f(a) / (f(a) - f(b)) */
+            double t = 1.0 / (1.0 + std::exp(std::max(-700.0, std::min(700.0, ln_fb__ - ln_fa__))));
+            if (nslow >= 2) {
+                t     = 0.5;
+                nslow = 0;
+            }
+            c = a__ + t * (b__ - a__);
+            if (c == a__ || c == b__) {
+                c = 0.5 * (a__ + b__);
+                if (c == a__ || c == b__) {
+                    break;
+                }
+            }
+            auto fc = f__(c);
+            if (fc.second < ln_ftol) {
+                break;
+            }
+            if (fc.first) {
+                a__     = c;
+                ln_fa__ = fc.second;
+                if (side == -1) {
+                    ln_fb__ -= std::log(2.0);
+                }
+                side = -1;
+            } else {
+                b__     = c;
+                ln_fb__ = fc.second;
+                if (side == 1) {
+                    ln_fa__ -= std::log(2.0);
+                }
+                side = 1;
+            }
+            if (std::abs(b__ - a__) > 0.5 * w) {
+                nslow++;
+            } else {
+                w     = std::abs(b__ - a__);
+                nslow = 0;
+            }
+        }
+        return c;
+    }
+
+    /// Find the energy at which the radial solution acquires the (nn+1)-th node on the radial grid.
+    /** The number of nodes doesn't decrease with energy and p(R) changes sign each time a new node enters the
+     *  grid. The transition is bracketed by scanning a batch of energies around the starting value, the bracket
+     *  is narrowed by the multisection until it contains a single transition and then the root of p(R) is
+     *  refined by the secant search. On success e_lo has nn nodes, e_hi has nn+1 nodes and
+     *  e_hi - e_lo < tol max(1, |e_lo|); the tolerance is relative for the large energies, where the absolute
+     *  tolerance is below the spacing of the double precision numbers.
+     *
+     *  The search fails and returns false if the transition is not found within \f$ 10^5 \f$ Ha of the starting
+     *  energy (well beyond the deepest core levels), or if the multisection stops shrinking the bracket. */
+    bool find_node_transition(relativity_t rel__, int l__, int k__, int nn__, double enu_start__, double de__,
+                              double tol__, double& e_lo__, double& e_hi__) const
+    {
+        int const nb{8};
+        std::vector<double> e(nb);
+
+        bool found_lo{false};
+        bool found_hi{false};
+        int nn_lo{0};
+        int nn_hi{0};
+        double ln_lo{0};
+        double ln_hi{0};
+
+        auto update = [&](surface_t const& s) {
+            for (int j = 0; j < static_cast<int>(e.size()); j++) {
+                if (s.nn[j] > nn__) {
+                    if (!found_hi || e[j] < e_hi__) {
+                        e_hi__   = e[j];
+                        nn_hi    = s.nn[j];
+                        ln_hi    = s.ln_abs(s.p[j], j);
+                        found_hi = true;
+                    }
+                } else {
+                    if (!found_lo || e[j] > e_lo__) {
+                        e_lo__   = e[j];
+                        nn_lo    = s.nn[j];
+                        ln_lo    = s.ln_abs(s.p[j], j);
+                        found_lo = true;
+                    }
+                }
+            }
+        };
+
+        /* maximum distance of the scanned energies from the starting value */
+        double const e_range{1e5};
+
+        auto tol = [tol__](double e) { return tol__ * std::max(1.0, std::abs(e)); };
+
+        /* scan with the growing step until the transition is bracketed */
+        double de = de__;
+        for (int iter = 0; iter < 30 && !(found_lo && found_hi); iter++) {
+            for (int j = 0; j < nb; j++) {
+                if (found_lo) {
+                    e[j] = e_lo__ + de * (j + 1);
+                } else if (found_hi) {
+                    e[j] = e_hi__ - de * (j + 1);
+                } else {
+                    e[j] = enu_start__ + de * (j - nb / 2);
+                }
+                if (std::abs(e[j] - enu_start__) > e_range) {
+                    return false;
+                }
+            }
+            update(integrate_surface(rel__, l__, k__, e));
+            de *= 4;
+        }
+        if (!(found_lo && found_hi)) {
+            return false;
+        }
+
+        /* multisection until the bracket contains a single node transition and is small enough for the secant */
+        for (int iter = 0; nn_hi - nn_lo > 1 || e_hi__ - e_lo__ > 1e-3 * std::max(1.0, std::abs(e_lo__)); iter++) {
+            double w = e_hi__ - e_lo__;
+            if (w < tol(e_lo__) || iter >= 100) {
+                return false;
+            }
+            for (int j = 0; j < nb; j++) {
+                e[j] = e_lo__ + w * (j + 1) / (nb + 1);
+            }
+            update(integrate_surface(rel__, l__, k__, e));
+            /* the bracket must shrink; it doesn't when the energies are at the precision limit */
+            if (!(e_hi__ - e_lo__ < w)) {
+                return false;
+            }
+        }
+
+        /* secant search for p(R) = 0 */
+        e.resize(1);
+        auto f = [&](double enu) {
+            e[0]   = enu;
+            auto s = integrate_surface(rel__, l__, k__, e);
+            return std::make_pair(s.nn[0] <= nn__, s.ln_abs(s.p[0], 0));
+        };
+        refine_root(f, e_lo__, ln_lo, e_hi__, ln_hi, tol(e_lo__));
+
+        return (e_hi__ - e_lo__ <= tol(e_lo__));
+    }
+
     //== inline double extrapolate_to_zero(int istep, double y, double* x, double* work) const
     //== {
     //==     double dy = y;
@@ -646,6 +999,16 @@ class Radial_solver
             ve_(i) = v__[i] + zn_ * radial_grid_.x_inv(i);
         }
         ve_.interpolate();
+
+        v_      = std::vector<double>(num_points());
+        v_half_ = std::vector<double>(num_points() - 1);
+        for (int i = 0; i < num_points(); i++) {
+            v_[i] = ve_(i) - zn_ * radial_grid_.x_inv(i);
+        }
+        for (int i = 0; i < num_points() - 1; i++) {
+            double h_half = radial_grid_.dx(i) / 2;
+            v_half_[i]    = ve_(i, h_half) - zn_ * (1.0 / (radial_grid_[i] + h_half));
+        }
     }
 
     std::tuple<int, std::vector<double>, std::vector<double>, std::vector<double>, std::vector<double>>
@@ -854,58 +1217,43 @@ class Bound_state : public Radial_solver
         std::vector<double> rdudr(np);
         dpdr_ = std::vector<double>(np);
 
-        int s{1};
-        int sp;
-        enu_ = enu_start__;
-        double denu{0.1};
-
         /* search for the bound state */
-        for (int iter = 0; iter < 1000; iter++) {
-            int nn{0};
+        double e_lo{0};
+        double e_hi{0};
+        bool found = find_node_transition(rel__, l_, k_, n_ - l_ - 1, enu_start__, 0.1, enu_tolerance_, e_lo, e_hi);
+        enu_ = e_lo;
 
-            switch (rel__) {
-                case relativity_t::none: {
-                    nn = integrate_forward_rk4<relativity_t::none, true>(enu_, l_, k_, chi_p, chi_q, p, dpdr_, q, dqdr);
-                    break;
-                }
-                case relativity_t::koelling_harmon: {
-                    nn = integrate_forward_rk4<relativity_t::koelling_harmon, true>(enu_, l_, k_, chi_p, chi_q, p,
-                                                                                    dpdr_, q, dqdr);
-                    break;
-                }
-                case relativity_t::zora: {
-                    nn = integrate_forward_rk4<relativity_t::zora, true>(enu_, l_, k_, chi_p, chi_q, p, dpdr_, q, dqdr);
-                    break;
-                }
-                case relativity_t::dirac: {
-                    nn = integrate_forward_rk4<relativity_t::dirac, true>(enu_, l_, k_, chi_p, chi_q, p, dpdr_, q,
-                                                                          dqdr);
-                    break;
-                }
-                default: {
-                    TERMINATE_NOT_IMPLEMENTED
-                }
-            }
-
-            sp   = s;
-            s    = (nn > (n_ - l_ - 1)) ? -1 : 1;
-            denu = s * std::abs(denu);
-            denu = (s != sp) ? denu * 0.5 : denu * 1.25;
-            enu_ += denu;
-
-            if (std::abs(denu) < enu_tolerance_ && iter > 4) {
-                break;
-            }
-        }
-
-        if (std::abs(denu) >= enu_tolerance_) {
+        if (!found) {
             std::stringstream s;
             s << "enu is not converged for n = " << n_ << " and l = " << l_ << std::endl
-              << "enu = " << enu_ << ", denu = " << denu;
+              << "enu = " << enu_ << ", denu = " << e_hi - e_lo;
 
             TERMINATE(s);
         }
 
+        switch (rel__) {
+            case relativity_t::none: {
+                integrate_forward_rk4<relativity_t::none, true>(enu_, l_, k_, chi_p, chi_q, p, dpdr_, q, dqdr);
+                break;
+            }
+            case relativity_t::koelling_harmon: {
+                integrate_forward_rk4<relativity_t::koelling_harmon, true>(enu_, l_, k_, chi_p, chi_q, p, dpdr_, q,
+                                                                           dqdr);
+                break;
+            }
+            case relativity_t::zora: {
+                integrate_forward_rk4<relativity_t::zora, true>(enu_, l_, k_, chi_p, chi_q, p, dpdr_, q, dqdr);
+                break;
+            }
+            case relativity_t::dirac: {
+                integrate_forward_rk4<relativity_t::dirac, true>(enu_, l_, k_, chi_p, chi_q, p, dpdr_, q, dqdr);
+                break;
+            }
+            default: {
+                TERMINATE_NOT_IMPLEMENTED
+            }
+        }
+
         /* compute r * u'(r) */
         for (int i = 0; i < num_points(); i++) {
             rdudr[i] = dpdr_[i] - p[i] / radial_grid(i);
@@ -914,7 +1262,7 @@ class Bound_state : public Radial_solver
         /* search for the turning point */
         int idxtp = np - 1;
         for (int i = 0; i < np; i++) {
-            if (ve_(i) - zn_ * radial_grid_.x_inv(i) > enu_) {
+            if (v_[i] > enu_) {
                 idxtp = i;
                 break;
             }
@@ -1058,113 +1406,80 @@ class Enu_finder : public Radial_solver
         std::vector<double> dpdr(np);
         std::vector<double> dqdr(np);
 
-        double enu = enu_start__;
-        double de  = 0.001;
-        bool found = false;
-        int nndp   = 0;
-
         /* We want to find enu such that the wave-function at the muffin-tin boundary is zero
          * and the number of nodes inside muffin-tin is equal to n-l-1. This will be the top
          * of the band. */
-        for (int i = 0; i < 1000; i++) {
-            int nnd{0};
-
-            switch (rel__) {
-                case relativity_t::none: {
-                    nnd = integrate_forward_rk4<relativity_t::none, false>(enu, l_, 0, chi_p, chi_q, p, dpdr, q, dqdr);
-                    break;
-                }
-                case relativity_t::koelling_harmon: {
-                    nnd = integrate_forward_rk4<relativity_t::koelling_harmon, false>(enu, l_, 0, chi_p, chi_q, p, dpdr,
-                                                                                      q, dqdr);
-                    break;
-                }
-                case relativity_t::zora: {
-                    nnd = integrate_forward_rk4<relativity_t::zora, false>(enu, l_, 0, chi_p, chi_q, p, dpdr, q, dqdr);
-                    break;
-                }
-                case relativity_t::iora: {
-                    nnd = integrate_forward_rk4<relativity_t::iora, false>(enu, l_, 0, chi_p, chi_q, p, dpdr, q, dqdr);
-                    break;
-                }
-                default: {
-                    TERMINATE_NOT_IMPLEMENTED
-                }
-            }
-            nnd -= (n_ - l_ - 1);
-
-            enu = (nnd > 0) ? enu - de : enu + de;
-
-            if (i) {
-                de = (nnd != nndp) ? de * 0.5 : de * 1.25;
-            }
-            if (std::abs(de) < 1e-10) {
-                found = true;
-                break;
-            }
-            nndp = nnd;
+        double e_lo{0};
+        double e_hi{0};
+        if (find_node_transition(rel__, l_, 0, n_ - l_ - 1, enu_start__, 0.001, 1e-10, e_lo, e_hi)) {
+            etop_ = e_lo;
+        } else {
+            etop_ = e_hi = enu_start__;
         }
-        etop_ = (!found) ? enu_start__ : enu;
-
-        auto surface_deriv = [this, &dpdr, &p]() {
-            if (true) {
-                /* return  p'(R) */
-                return dpdr.back();
-            } else {
-                /* return R*u'(R) */
-                return dpdr.back() - p.back() / radial_grid_.last();
-            }
-        };
 
-        double sd = surface_deriv();
+        /* surface derivative p'(R) is taken just above the top of the band where its sign is well defined */
+        std::vector<double> e({e_hi, etop_});
+        auto s0   = integrate_surface(rel__, l_, 0, e);
+        double sd = s0.dpdr[0];
 
         /* Now we go down in energy and serach for enu such that the wave-function derivative is zero
-         * at the muffin-tin boundary. This will be the bottom of the band. */
-        de = 1e-4;
-        for (int i = 0; i < 100; i++) {
-            de *= 1.1;
-            enu -= de;
-            switch (rel__) {
-                case relativity_t::none: {
-                    integrate_forward_rk4<relativity_t::none, false>(enu, l_, 0, chi_p, chi_q, p, dpdr, q, dqdr);
-                    break;
-                }
-                case relativity_t::koelling_harmon: {
-                    integrate_forward_rk4<relativity_t::koelling_harmon, false>(enu, l_, 0, chi_p, chi_q, p, dpdr, q,
-                                                                                dqdr);
-                    break;
-                }
-                case relativity_t::zora: {
-                    integrate_forward_rk4<relativity_t::zora, false>(enu, l_, 0, chi_p, chi_q, p, dpdr, q, dqdr);
-                    break;
-                }
-                case relativity_t::iora: {
-                    integrate_forward_rk4<relativity_t::iora, false>(enu, l_, 0, chi_p, chi_q, p, dpdr, q, dqdr);
+         * at the muffin-tin boundary. This will be the bottom of the band. The energies of the geometric
+         * sequence are integrated in batches. */
+        int const nb{8};
+        double enu{etop_};
+        double ln_a = s0.ln_abs(s0.dpdr[1], 1);
+        double ln_b{0};
+        double de{1e-4};
+        double ea{etop_};
+        double eb{etop_};
+        /* for the narrow bands of the core-like states p'(R) = 0 is already inside the bracket of etop */
+        bool found = (s0.dpdr[1] * sd <= 0);
+        for (int i = 0; i < 100 && !found; i += nb) {
+            e.resize(nb);
+            for (int j = 0; j < nb; j++) {
+                de *= 1.1;
+                enu -= de;
+                e[j] = enu;
+            }
+            auto s = integrate_surface(rel__, l_, 0, e);
+            for (int j = 0; j < nb; j++) {
+                if (s.dpdr[j] * sd <= 0) {
+                    eb    = e[j];
+                    ln_b  = s.ln_abs(s.dpdr[j], j);
+                    found = true;
                     break;
                 }
-                default: {
-                    TERMINATE_NOT_IMPLEMENTED
-                }
-            }
-            if (surface_deriv() * sd <= 0) {
-                break;
+                ea   = e[j];
+                ln_a = s.ln_abs(s.dpdr[j], j);
             }
         }
 
         /* refine bottom energy */
-        double e1 = enu;
-        double e0 = enu + de;
+        if (found && eb != ea) {
+            e.resize(1);
+            auto f = [&](double enu) {
+                e[0]   = enu;
+                auto s = integrate_surface(rel__, l_, 0, e);
+                return std::make_pair(s.dpdr[0] * sd > 0, s.ln_abs(s.dpdr[0], 0));
+            };
+            enu = refine_root(f, ea, ln_a, eb, ln_b, 1e-12, 1e-10);
+        }
+
+        ebot_ = enu;
+        /* last check */
+        e.resize(1);
+        e[0]   = enu;
+        int nn = integrate_surface(rel__, l_, 0, e).nn[0];
 
-        for (int i = 0; i < 100; i++) {
-            enu = (e1 + e0) / 2.0;
+        if (nn != n_ - l_ - 1) {
             switch (rel__) {
                 case relativity_t::none: {
                     integrate_forward_rk4<relativity_t::none, false>(enu, l_, 0, chi_p, chi_q, p, dpdr, q, dqdr);
                     break;
                 }
                 case relativity_t::koelling_harmon: {
-                    integrate_forward_rk4<relativity_t::koelling_harmon, false>(enu, l_, 0, chi_p, chi_q, p, dpdr, q,
-                                                                                dqdr);
+                    integrate_forward_rk4<relativity_t::koelling_harmon, false>(enu, l_, 0, chi_p, chi_q, p, dpdr,
+                                                                                q, dqdr);
                     break;
                 }
                 case relativity_t::zora: {
@@ -1179,45 +1494,7 @@ class Enu_finder : public Radial_solver
                     TERMINATE_NOT_IMPLEMENTED
                 }
             }
-            /* derivative at the boundary */
-            if (std::abs(surface_deriv()) < 1e-10) {
-                break;
-            }
-
-            if (surface_deriv() * sd > 0) {
-                e0 = enu;
-            } else {
-                e1 = enu;
-            }
-        }
-
-        ebot_ = enu;
-        /* last check */
-        int nn{0};
-        switch (rel__) {
-            case relativity_t::none: {
-                nn = integrate_forward_rk4<relativity_t::none, false>(enu, l_, 0, chi_p, chi_q, p, dpdr, q, dqdr);
-                break;
-            }
-            case relativity_t::koelling_harmon: {
-                nn = integrate_forward_rk4<relativity_t::koelling_harmon, false>(enu, l_, 0, chi_p, chi_q, p, dpdr, q,
-                                                                                 dqdr);
-                break;
-            }
-            case relativity_t::zora: {
-                nn = integrate_forward_rk4<relativity_t::zora, false>(enu, l_, 0, chi_p, chi_q, p, dpdr, q, dqdr);
-                break;
-            }
-            case relativity_t::iora: {
-                nn = integrate_forward_rk4<relativity_t::iora, false>(enu, l_, 0, chi_p, chi_q, p, dpdr, q, dqdr);
-                break;
-            }
-            default: {
-                TERMINATE_NOT_IMPLEMENTED
-            }
-        }
 
-        if (nn != n_ - l_ - 1) {
             FILE* fout = fopen("p.dat", "w");
             for (int ir = 0; ir < np; ir++) {
                 double x = radial_grid(ir);
@@ -58,23 +58,113 @@ class Spherical_Bessel_functions
             sbessel_[l] = Spline<double>(rgrid__);
         }
 
-        std::vector<double> jl(lmax__ + 2);
+        std::vector<double> x(rgrid__.num_points());
         for (int ir = 0; ir < rgrid__.num_points(); ir++) {
-            double t = rgrid__[ir] * q__;
-            gsl_sf_bessel_jl_array(lmax__ + 1, t, &jl[0]);
-            for (int l = 0; l <= lmax__ + 1; l++) {
-                sbessel_[l](ir) = jl[l];
-            }
+            x[ir] = rgrid__[ir] * q__;
         }
+        /* values are written directly to the splines */
+        sbessel(lmax__ + 1, rgrid__.num_points(), x.data(),
+                [this](int l, int ir) -> double& { return sbessel_[l](ir); });
 
         for (int l = 0; l <= lmax__ + 1; l++) {
             sbessel_[l].interpolate();
         }
     }
 
+    /// Spherical Bessel functions \f$ j_{\ell}(x_i) \f$ for \f$ \ell = 0..\ell_{max} \f$ and an array of arguments.
+    /** The output is written to jl__(l, i), where jl__ is any functor returning a reference to the element, so the
+     *  values can go directly to splines or to the arrays of different layouts.
+     *
+     *  For \f$ \ell \le x \f$ the upward recurrence
+     *  \f[
+     *    j_{\ell+1}(x) = \frac{2\ell + 1}{x} j_{\ell}(x) - j_{\ell-1}(x)
+     *  \f]
+     *  is stable and starts from \f$ j_0(x) = \sin(x)/x \f$ and \f$ j_{-1}(x) = \cos(x)/x \f$. For
+     *  \f$ \ell > x \f$ the ratios \f$ r_{\ell} = j_{\ell}(x) / j_{\ell-1}(x) \f$ are obtained by the downward
+     *  recurrence
+     *  \f[
+     *    r_{\ell} = \frac{x}{2\ell + 1 - x r_{\ell+1}}
+     *  \f]
+     *  started well above \f$ \ell_{max} \f$ and the values are continued from the last stable one. This also
+     *  covers the small arguments without the cancellation in \f$ j_1(x) \f$. The arguments are processed in
+     *  blocks with the inner loops over the arguments, so the branches become selects and the loops vectorize. */
+    template <typename F>
+    static void sbessel(int lmax__, int n__, double const* x__, F&& jl__)
+    {
+        /* number of extra orders in the downward recurrence of ratios */
+        int const nextra{40};
+        /* number of arguments in a block */
+        int const nb{64};
+
+        double xinv[nb];
+        double jm1[nb];
+        double jm2[nb];
+        double c[nb];
+        int lu[nb];
+
+        for (int i0 = 0; i0 < n__; i0 += nb) {
+            int n           = std::min(nb, n__ - i0);
+            double const* x = x__ + i0;
+
+            /* last order of the upward recurrence */
+            bool ratio{false};
+            for (int i = 0; i < n; i++) {
+                assert(x[i] >= 0);
+                lu[i] = (x[i] >= lmax__) ? lmax__ : static_cast<int>(x[i]);
+                ratio = ratio || (lu[i] < lmax__);
+            }
+
+            /* ratios are stored in the output and overwritten by the values in the upward pass */
+            if (ratio) {
+                std::fill(c, c + n, 0);
+                for (int l = lmax__ + nextra; l >= 1; l--) {
+                    #pragma omp simd
+                    for (int i = 0; i < n; i++) {
+                        c[i] = x[i] / (2 * l + 1 - x[i] * c[i]);
+                    }
+                    if (l <= lmax__) {
+                        for (int i = 0; i < n; i++) {
+                            jl__(l, i0 + i) = c[i];
+                        }
+                    }
+                }
+            }
+
+            for (int i = 0; i < n; i++) {
+                if (x[i] == 0) {
+                    xinv[i] = 0;
+                    jm1[i]  = 1;
+                    jm2[i]  = 0;
+                } else {
+                    xinv[i] = 1.0 / x[i];
+                    jm1[i]  = std::sin(x[i]) * xinv[i];
+                    jm2[i]  = std::cos(x[i]) * xinv[i];
+                }
+                c[i]            = jm1[i];
+                jl__(0, i0 + i) = jm1[i];
+            }
+
+            for (int l = 1; l <= lmax__; l++) {
+                #pragma omp simd
+                for (int i = 0; i < n; i++) {
+                    double r  = ratio ? jl__(l, i0 + i) : 0;
+                    double up = (2 * l - 1) * xinv[i] * jm1[i] - jm2[i];
+                    double v  = (l <= lu[i]) ? up : r * c[i];
+                    /* continue the ratios from the larger of the two last upward values; near the zero of
+                     * j_{lu} this keeps the relative accuracy */
+                    c[i]            = (l == lu[i] && std::abs(v) < std::abs(jm1[i])) ? r * jm1[i] : v;
+                    jm2[i]          = jm1[i];
+                    jm1[i]          = v;
+                    jl__(l, i0 + i) = v;
+                }
+            }
+        }
+    }
+
+    /// Spherical Bessel functions \f$ j_{\ell}(t) \f$ for \f$ \ell = 0..\ell_{max} \f$.
     static void sbessel(int lmax__, double t__, double* jl__)
     {
-        gsl_sf_bessel_jl_array(lmax__, t__, jl__);
+        sbessel(lmax__, 1, &t__, [jl__](int l, int) -> double& { return jl__[l]; });
     }
 
     static void sbessel_deriv_q(int lmax__, double q__, double x__, double* jl_dq__)
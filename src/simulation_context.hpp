@@ -35,6 +35,7 @@
 #include "Density/augmentation_operator.hpp"
 #include "Potential/xc_functional.hpp"
 #include "SDDK/GPU/acc.hpp"
+#include "evp_autotune.hpp"
 
 #ifdef __GPU
 extern "C" void generate_phase_factors_gpu(int num_gvec_loc__, int num_atoms__, int const* gvec__,
@@ -190,6 +191,9 @@ class Simulation_context : public Simulation_parameters
     /// Generalized eigen-value problem solver.
     std::unique_ptr<Eigensolver> gen_evp_solver_;
 
+    /// Solver of the small distributed eigen-value problems with the replicated matrices.
+    std::unique_ptr<Eigensolver> replicated_evp_solver_;
+
     /// Type of host memory (pagable or page-locked) for the arrays that participate in host-to-device memory copy.
     memory_t host_memory_t_{memory_t::none};
 
@@ -205,27 +209,49 @@ class Simulation_context : public Simulation_parameters
     /// True if the context is already initialized.
     bool initialized_{false};
 
+    /// True if the G-vectors were created since the last call to update().
+    bool new_gvec_{true};
+
+    /// Dimensions of the fine-grained FFT grid for the current lattice.
+    inline std::array<int, 3> fft_grid_dims() const
+    {
+        auto fft_grid = fft_grid_size_;
+        if (fft_grid[0] * fft_grid[1] * fft_grid[2] == 0) {
+            fft_grid = get_min_fft_grid(pw_cutoff(), unit_cell_.reciprocal_lattice_vectors()).grid_size();
+        }
+        return fft_grid;
+    }
+
+    /// Dimensions of the coarse-grained FFT grid for the current lattice.
+    inline std::array<int, 3> fft_coarse_grid_dims() const
+    {
+        return get_min_fft_grid(2 * gk_cutoff(), unit_cell_.reciprocal_lattice_vectors()).grid_size();
+    }
+
     /// Initialize FFT drivers.
     inline void init_fft()
     {
         PROFILE("sirius::Simulation_context::init_fft");
 
-        auto rlv = unit_cell_.reciprocal_lattice_vectors();
-
         if (!(control().fft_mode_ == "serial" || control().fft_mode_ == "parallel")) {
             TERMINATE("wrong FFT mode");
         }
 
         /* create FFT driver for dense mesh (density and potential) */
-        auto fft_grid = fft_grid_size_;
-        if (fft_grid[0] * fft_grid[1] * fft_grid[2] == 0) {
-            fft_grid = get_min_fft_grid(pw_cutoff(), rlv).grid_size();
-        }
-        fft_ = std::unique_ptr<FFT3D>(new FFT3D(fft_grid, comm_fft(), processing_unit()));
+        fft_ = std::unique_ptr<FFT3D>(new FFT3D(fft_grid_dims(), comm_fft(), processing_unit()));
 
         /* create FFT driver for coarse mesh */
-        fft_coarse_ = std::unique_ptr<FFT3D>(
-            new FFT3D(get_min_fft_grid(2 * gk_cutoff(), rlv).grid_size(), comm_fft_coarse(), processing_unit()));
+        fft_coarse_ = std::unique_ptr<FFT3D>(new FFT3D(fft_coarse_grid_dims(), comm_fft_coarse(), processing_unit()));
+
+        init_gvec();
+    }
+
+    /// Initialize G-vectors of the fine and coarse grids and prepare the fine-grained FFT driver.
+    inline void init_gvec()
+    {
+        PROFILE("sirius::Simulation_context::init_gvec");
+
+        auto rlv = unit_cell_.reciprocal_lattice_vectors();
 
         /* create a list of G-vectors for corase FFT grid */
         gvec_coarse_ = std::unique_ptr<Gvec>(new Gvec(rlv, 2 * gk_cutoff(), comm(), control().reduce_gvec_));
@@ -240,6 +266,8 @@ class Simulation_context : public Simulation_parameters
 
         remap_gvec_ = std::unique_ptr<remap_gvec_to_shells>(new remap_gvec_to_shells(comm(), gvec()));
 
+        new_gvec_ = true;
+
         /* prepare fine-grained FFT driver for the entire simulation */
         fft_->prepare(*gvec_partition_);
 
@@ -545,24 +573,46 @@ class Simulation_context : public Simulation_parameters
         }
     }
 
+    /// Re-bind the initialized context to a new structure with the same atom types and cutoffs.
+    /** In contrast to update(), which keeps the G-vector sets and only changes their lattice vectors (this is
+     *  the right thing to do for small deformations during relaxation), this method regenerates the G-vectors
+     *  for the new lattice. The geometry-independent data (atom types, radial integrals, eigen-value solvers,
+     *  MPI and BLACS grids) are kept, and FFT drivers are reused if the FFT box dimensions do not change.
+     *  All objects that depend on the G-vectors (K-point sets, Density, Potential) must be re-created
+     *  by the caller after this call. */
+    void rebind();
+
     /// Update context after setting new lattice vectors or atomic coordinates.
+    /** Only the parts that depend on the changed quantities are recomputed. If only atomic positions were changed
+     *  (e.g. during the geometry relaxation at fixed lattice), the G-vector lengths, augmentation operator and the
+     *  G-vector coordinates are kept and only the position-dependent phase factors, atom-centered grids, symmetry
+     *  and the step function are updated. */
     void update()
     {
         PROFILE("sirius::Simulation_context::update");
 
-        gvec_->lattice_vectors(unit_cell().reciprocal_lattice_vectors());
-        gvec_coarse_->lattice_vectors(unit_cell().reciprocal_lattice_vectors());
+        utils::timer t0("sirius::Simulation_context::update|total");
 
         unit_cell().update();
 
-        if (unit_cell_.num_atoms() != 0 && use_symmetry() && control().verification_ >= 1) {
-            unit_cell_.symmetry().check_gvec_symmetry(gvec(), comm());
-            if (!full_potential()) {
-                unit_cell_.symmetry().check_gvec_symmetry(gvec_coarse(), comm());
-            }
+        bool lattice_changed   = unit_cell().lattice_changed() || new_gvec_;
+        bool positions_changed = unit_cell().positions_changed() || new_gvec_;
+
+        if (unit_cell().lattice_changed()) {
+            gvec_->lattice_vectors(unit_cell().reciprocal_lattice_vectors());
+            gvec_coarse_->lattice_vectors(unit_cell().reciprocal_lattice_vectors());
         }
 
-        init_atoms_to_grid_idx(control().rmt_max_);
+        if (lattice_changed || positions_changed) {
+            if (unit_cell_.num_atoms() != 0 && use_symmetry() && control().verification_ >= 1) {
+                unit_cell_.symmetry().check_gvec_symmetry(gvec(), comm());
+                if (!full_potential()) {
+                    unit_cell_.symmetry().check_gvec_symmetry(gvec_coarse(), comm());
+                }
+            }
+
+            init_atoms_to_grid_idx(control().rmt_max_);
+        }
 
         std::pair<int, int> limits(0, 0);
         for (int x : {0, 1, 2}) {
@@ -570,33 +620,36 @@ class Simulation_context : public Simulation_parameters
             limits.second = std::max(limits.second, fft().limits(x).second);
         }
 
-        phase_factors_ =
-            mdarray<double_complex, 3>(3, limits, unit_cell().num_atoms(), memory_t::host, "phase_factors_");
-        #pragma omp parallel for
-        for (int i = limits.first; i <= limits.second; i++) {
-            for (int ia = 0; ia < unit_cell_.num_atoms(); ia++) {
-                auto pos = unit_cell_.atom(ia).position();
-                for (int x : {0, 1, 2}) {
-                    phase_factors_(x, i, ia) = std::exp(double_complex(0.0, twopi * (i * pos[x])));
+        if (positions_changed) {
+            phase_factors_ =
+                mdarray<double_complex, 3>(3, limits, unit_cell().num_atoms(), memory_t::host, "phase_factors_");
+            #pragma omp parallel for
+            for (int i = limits.first; i <= limits.second; i++) {
+                for (int ia = 0; ia < unit_cell_.num_atoms(); ia++) {
+                    auto pos = unit_cell_.atom(ia).position();
+                    for (int x : {0, 1, 2}) {
+                        phase_factors_(x, i, ia) = std::exp(double_complex(0.0, twopi * (i * pos[x])));
+                    }
                 }
             }
-        }
 
-        phase_factors_t_ = mdarray<double_complex, 2>(gvec().count(), unit_cell().num_atom_types());
-        #pragma omp parallel for schedule(static)
-        for (int igloc = 0; igloc < gvec().count(); igloc++) {
-            /* global index of G-vector */
-            int ig = gvec().offset() + igloc;
-            for (int iat = 0; iat < unit_cell().num_atom_types(); iat++) {
-                double_complex z(0, 0);
-                for (int ia = 0; ia < unit_cell().atom_type(iat).num_atoms(); ia++) {
-                    z += gvec_phase_factor(ig, unit_cell().atom_type(iat).atom_id(ia));
+            phase_factors_t_ = mdarray<double_complex, 2>(gvec().count(), unit_cell().num_atom_types());
+            #pragma omp parallel for schedule(static)
+            for (int igloc = 0; igloc < gvec().count(); igloc++) {
+                /* global index of G-vector */
+                int ig = gvec().offset() + igloc;
+                for (int iat = 0; iat < unit_cell().num_atom_types(); iat++) {
+                    double_complex z(0, 0);
+                    for (int ia = 0; ia < unit_cell().atom_type(iat).num_atoms(); ia++) {
+                        z += gvec_phase_factor(ig, unit_cell().atom_type(iat).atom_id(ia));
+                    }
+                    phase_factors_t_(igloc, iat) = z;
                 }
-                phase_factors_t_(igloc, iat) = z;
             }
         }
 
-        if (use_symmetry()) {
+        /* symmetry operations can change with the change of lattice or atomic positions */
+        if (use_symmetry() && (lattice_changed || positions_changed)) {
             sym_phase_factors_ = mdarray<double_complex, 3>(3, limits, unit_cell().symmetry().num_mag_sym());
 
             #pragma omp parallel for
@@ -610,7 +663,8 @@ class Simulation_context : public Simulation_parameters
             }
         }
 
-        if (processing_unit() == device_t::GPU) {
+        /* lattice coordinates of G-vectors don't depend on lattice vectors */
+        if (processing_unit() == device_t::GPU && new_gvec_) {
             gvec_coord_ = mdarray<int, 2>(gvec().count(), 3, memory_t::host, "gvec_coord_");
             gvec_coord_.allocate(memory_t::device);
             for (int igloc = 0; igloc < gvec().count(); igloc++) {
@@ -623,11 +677,12 @@ class Simulation_context : public Simulation_parameters
             gvec_coord_.copy_to(memory_t::device);
         }
 
-        if (full_potential()) {
+        if (full_potential() && (lattice_changed || positions_changed)) {
             init_step_function();
         }
 
-        if (!full_potential()) {
+        /* augmentation operator depends only on the lengths and directions of G-vectors */
+        if (!full_potential() && lattice_changed) {
             augmentation_op_.clear();
             memory_pool* mp{nullptr};
             switch (processing_unit()) {
@@ -647,6 +702,14 @@ class Simulation_context : public Simulation_parameters
                 augmentation_op_.back().generate_pw_coeffs(aug_ri(), *mp);
             }
         }
+
+        new_gvec_ = false;
+
+        double t = t0.stop();
+        if (control().verbosity_ >= 1 && comm().rank() == 0) {
+            printf("Simulation_context::update() time: %.6f sec. (lattice changed: %i, positions changed: %i)\n",
+                   t, static_cast<int>(lattice_changed), static_cast<int>(positions_changed));
+        }
     }
 
     std::vector<std::pair<int, double>> const& atoms_to_grid_idx_map(int ia__) const
@@ -824,6 +887,26 @@ class Simulation_context : public Simulation_parameters
         return* gen_evp_solver_;
     }
 
+    /// Standard eigen-value solver for the problem of a given size.
+    /** Distributed problems not larger than Control_input::evp_replicated_max_size_ are solved redundantly on
+     *  each rank of the BLACS grid. */
+    inline Eigensolver& std_evp_solver(int matrix_size__)
+    {
+        if (replicated_evp_solver_ && matrix_size__ <= control().evp_replicated_max_size_) {
+            return *replicated_evp_solver_;
+        }
+        return *std_evp_solver_;
+    }
+
+    /// Generalized eigen-value solver for the problem of a given size.
+    inline Eigensolver& gen_evp_solver(int matrix_size__)
+    {
+        if (replicated_evp_solver_ && matrix_size__ <= control().evp_replicated_max_size_) {
+            return *replicated_evp_solver_;
+        }
+        return *gen_evp_solver_;
+    }
+
     /// Phase factors \f$ e^{i {\bf G} {\bf r}_{\alpha}} \f$
     inline double_complex gvec_phase_factor(vector3d<int> G__, int ia__) const
     {
@@ -903,17 +986,26 @@ class Simulation_context : public Simulation_parameters
     }
 
     /// Compute values of spherical Bessel functions at MT boundary.
+    /** Values are stored for the G-vector shells: \f$ j_{\ell}(G_s R_{\alpha}) \f$ with the shell index s
+     *  given by Gvec::shell(). */
     inline mdarray<double, 3> generate_sbessel_mt(int lmax__) const
     {
         PROFILE("sirius::Simulation_context::generate_sbessel_mt");
 
-        mdarray<double, 3> sbessel_mt(lmax__ + 1, gvec().count(), unit_cell().num_atom_types());
+        int ns = gvec().num_shells();
+        /* number of shells in a batch */
+        int const nb{256};
+
+        mdarray<double, 3> sbessel_mt(lmax__ + 1, ns, unit_cell().num_atom_types());
+        std::vector<double> x(ns);
         for (int iat = 0; iat < unit_cell().num_atom_types(); iat++) {
+            for (int igs = 0; igs < ns; igs++) {
+                x[igs] = gvec().shell_len(igs) * unit_cell().atom_type(iat).mt_radius();
+            }
             #pragma omp parallel for schedule(static)
-            for (int igloc = 0; igloc < gvec().count(); igloc++) {
-                auto gv = gvec().gvec_cart<index_domain_t::local>(igloc);
-                gsl_sf_bessel_jl_array(lmax__, gv.length() * unit_cell().atom_type(iat).mt_radius(),
-                                       &sbessel_mt(0, igloc, iat));
+            for (int i0 = 0; i0 < ns; i0 += nb) {
+                auto f = [&](int l, int igs) -> double& { return sbessel_mt(l, i0 + igs, iat); };
+                Spherical_Bessel_functions::sbessel(lmax__, std::min(nb, ns - i0), &x[i0], f);
             }
         }
         return std::move(sbessel_mt);
@@ -940,9 +1032,11 @@ class Simulation_context : public Simulation_parameters
      *    q_{\ell m}^{\alpha} = \sum_{\bf G} 4\pi \rho({\bf G})
      *     e^{i{\bf G}{\bf r}_{\alpha}}i^{\ell}f_{\ell}^{\alpha}(G) Y_{\ell m}^{*}(\hat{\bf G})
      *  \f]
+     *  The radial functions \f$ f_{\ell}^{\alpha}(G) \f$ are given for the G-vector shells (see
+     *  generate_sbessel_mt()). Spherical harmonics are computed on the fly for the blocks of G-vectors and each block
+     *  is contracted with the phase factors by GEMM, so no \f$ Y_{\ell m}(\hat{\bf G}) \f$ table is stored.
      */
-    inline mdarray<double_complex, 2> sum_fg_fl_yg(int lmax__, double_complex const* fpw__, mdarray<double, 3>& fl__,
-                                                   matrix<double_complex>& gvec_ylm__)
+    inline mdarray<double_complex, 2> sum_fg_fl_yg(int lmax__, double_complex const* fpw__, mdarray<double, 3>& fl__)
     {
         PROFILE("sirius::Simulation_context::sum_fg_fl_yg");
 
@@ -957,15 +1051,21 @@ class Simulation_context : public Simulation_parameters
         /* resuling matrix */
         mdarray<double_complex, 2> flm(lmmax, unit_cell().num_atoms());
 
+        /* size of the block of G-vectors */
+        int nb = std::max(1, std::min(ngv_loc, 1024));
+
         matrix<double_complex> phase_factors;
         matrix<double_complex> zm;
         matrix<double_complex> tmp;
 
+        linalg_t la{linalg_t::blas};
+        memory_t mem{memory_t::host};
+
         switch (processing_unit()) {
             case device_t::CPU: {
                 auto& mp = mem_pool(memory_t::host);
                 phase_factors = matrix<double_complex>(mp, ngv_loc, na_max);
-                zm = matrix<double_complex>(mp, lmmax, ngv_loc);
+                zm = matrix<double_complex>(mp, lmmax, nb);
                 tmp = matrix<double_complex>(mp, lmmax, na_max);
                 break;
             }
@@ -974,10 +1074,12 @@ class Simulation_context : public Simulation_parameters
                 auto& mpd = mem_pool(memory_t::device);
                 phase_factors = matrix<double_complex>(nullptr, ngv_loc, na_max);
                 phase_factors.allocate(mpd);
-                zm = matrix<double_complex>(mp, lmmax, ngv_loc);
+                zm = matrix<double_complex>(mp, lmmax, nb);
                 zm.allocate(mpd);
                 tmp = matrix<double_complex>(mp, lmmax, na_max);
                 tmp.allocate(mpd);
+                la = linalg_t::gpublas;
+                mem = memory_t::device;
                 break;
             }
         }
@@ -990,35 +1092,46 @@ class Simulation_context : public Simulation_parameters
         for (int iat = 0; iat < unit_cell_.num_atom_types(); iat++) {
             int na = unit_cell_.atom_type(iat).num_atoms();
             generate_phase_factors(iat, phase_factors);
-            utils::timer t1("sirius::Simulation_context::sum_fg_fl_yg|zm");
-            #pragma omp parallel for schedule(static)
-            for (int igloc = 0; igloc < ngv_loc; igloc++) {
-                for (int l = 0, lm = 0; l <= lmax__; l++) {
-                    double_complex z = fourpi * fl__(l, igloc, iat) * zil[l] * fpw__[igloc];
-                    for (int m = -l; m <= l; m++, lm++) {
-                        zm(lm, igloc) = z * std::conj(gvec_ylm__(lm, igloc));
+
+            for (int ig0 = 0; ig0 < ngv_loc; ig0 += nb) {
+                int ng = std::min(nb, ngv_loc - ig0);
+
+                utils::timer t1("sirius::Simulation_context::sum_fg_fl_yg|zm");
+                #pragma omp parallel
+                {
+                    std::vector<double_complex> ylm(lmmax);
+                    #pragma omp for schedule(static)
+                    for (int i = 0; i < ng; i++) {
+                        int igloc = ig0 + i;
+                        int igs   = gvec().shell(gvec().offset() + igloc);
+                        auto rtp  = SHT::spherical_coordinates(gvec().gvec_cart<index_domain_t::local>(igloc));
+                        SHT::spherical_harmonics(lmax__, rtp[1], rtp[2], &ylm[0]);
+                        for (int l = 0, lm = 0; l <= lmax__; l++) {
+                            double_complex z = fourpi * fl__(l, igs, iat) * zil[l] * fpw__[igloc];
+                            for (int m = -l; m <= l; m++, lm++) {
+                                zm(lm, i) = z * std::conj(ylm[lm]);
+                            }
+                        }
                     }
                 }
-            }
-            t1.stop();
-            utils::timer t2("sirius::Simulation_context::sum_fg_fl_yg|mul");
-            switch (processing_unit()) {
-                case device_t::CPU: {
-                    linalg<CPU>::gemm(0, 0, lmmax, na, ngv_loc, zm.at(memory_t::host), zm.ld(), phase_factors.at(memory_t::host),
-                                      phase_factors.ld(), tmp.at(memory_t::host), tmp.ld());
-                    break;
-                }
-                case device_t::GPU: {
-#if defined(__GPU)
-                    zm.copy_to(memory_t::device);
-                    linalg<GPU>::gemm(0, 0, lmmax, na, ngv_loc, zm.at(memory_t::device), zm.ld(), phase_factors.at(memory_t::device),
-                                      phase_factors.ld(), tmp.at(memory_t::device), tmp.ld());
-                    tmp.copy_to(memory_t::host);
-#endif
-                    break;
+                t1.stop();
+
+                utils::timer t2("sirius::Simulation_context::sum_fg_fl_yg|mul");
+                if (is_device_memory(mem)) {
+                    zm.copy_to(mem, 0, lmmax * ng);
                 }
+                /* first block initializes the result, the rest are accumulated */
+                auto beta = (ig0 == 0) ? &linalg_const<double_complex>::zero() : &linalg_const<double_complex>::one();
+                linalg2(la).gemm('N', 'N', lmmax, na, ng, &linalg_const<double_complex>::one(), zm.at(mem), zm.ld(),
+                                 phase_factors.at(mem, ig0, 0), phase_factors.ld(), beta, tmp.at(mem), tmp.ld());
+                t2.stop();
+            }
+            if (ngv_loc == 0) {
+                tmp.zero(mem);
+            }
+            if (is_device_memory(mem)) {
+                tmp.copy_to(memory_t::host);
             }
-            t2.stop();
 
             for (int i = 0; i < na; i++) {
                 int ia = unit_cell_.atom_type(iat).atom_id(i);
@@ -1399,6 +1512,20 @@ inline void Simulation_context::initialize()
     int npr = control_input_.mpi_grid_dims_[0];
     int npc = control_input_.mpi_grid_dims_[1];
 
+    /* time the subspace problems and pick the solver and the shape of the BLACS grid within comm_band();
+       the choice of the global rank 0 is used by all k-point groups */
+    if (control().evp_autotune_ && evsn[0] == "" && evsn[1] == "") {
+        int nev = full_potential() ? num_fv_states() : num_bands();
+        int N   = iterative_solver_input().subspace_size_ * nev;
+        Evp_autotune evp_autotune(comm(), comm_band(), N, nev, cyclic_block_size(),
+                                  gamma_point() && !full_potential(), control().evp_autotune_cache_);
+        auto r  = evp_autotune.find();
+        evsn[0] = r.std_evp_solver_name;
+        evsn[1] = r.gen_evp_solver_name;
+        npr     = r.blacs_grid_dims[0];
+        npc     = r.blacs_grid_dims[1];
+    }
+
     /* deduce the default eigen-value solver */
     for (int i : {0, 1}) {
         if (evsn[i] == "") {
@@ -1436,20 +1563,17 @@ inline void Simulation_context::initialize()
     /* setup BLACS grid */
     if (std_solver.is_parallel()) {
         blacs_grid_ = std::unique_ptr<BLACS_grid>(new BLACS_grid(comm_band(), npr, npc));
+        if (control().evp_replicated_max_size_ > 0) {
+            replicated_evp_solver_ = std::unique_ptr<Eigensolver>(new Eigensolver_replicated());
+        }
     } else {
         blacs_grid_ = std::unique_ptr<BLACS_grid>(new BLACS_grid(Communicator::self(), 1, 1));
     }
 
     /* setup the cyclic block size */
     if (cyclic_block_size() < 0) {
-        double a = std::min(std::log2(double(num_bands()) / blacs_grid_->num_ranks_col()),
-                            std::log2(double(num_bands()) / blacs_grid_->num_ranks_row()));
-        if (a < 1) {
-            control_input_.cyclic_block_size_ = 2;
-        } else {
-            control_input_.cyclic_block_size_ =
-                static_cast<int>(std::min(128.0, std::pow(2.0, static_cast<int>(a))) + 1e-12);
-        }
+        control_input_.cyclic_block_size_ = default_cyclic_block_size(num_bands(), blacs_grid_->num_ranks_row(),
+                                                                      blacs_grid_->num_ranks_col());
     }
 
     if (!full_potential()) {
@@ -1500,6 +1624,37 @@ inline void Simulation_context::initialize()
     initialized_ = true;
 }
 
+inline void Simulation_context::rebind()
+{
+    PROFILE("sirius::Simulation_context::rebind");
+
+    if (!initialized_) {
+        TERMINATE("Simulation context is not initialized");
+    }
+
+    /* release the G-vector partition that is going to be destroyed */
+    fft_->dismiss();
+
+    auto fft_grid = fft_grid_dims();
+    if (fft_grid != fft_->grid_size()) {
+        fft_ = std::unique_ptr<FFT3D>(new FFT3D(fft_grid, comm_fft(), processing_unit()));
+    }
+    auto fft_coarse_grid = fft_coarse_grid_dims();
+    if (fft_coarse_grid != fft_coarse_->grid_size()) {
+        fft_coarse_ = std::unique_ptr<FFT3D>(new FFT3D(fft_coarse_grid, comm_fft_coarse(), processing_unit()));
+    }
+
+    init_gvec();
+
+    update();
+
+    if (control().verbosity_ >= 1 && comm().rank() == 0) {
+        printf("rebind: fine FFT grid %i %i %i, coarse FFT grid %i %i %i, number of G-vectors: %i\n",
+               fft().size(0), fft().size(1), fft().size(2), fft_coarse().size(0), fft_coarse().size(1),
+               fft_coarse().size(2), gvec().num_gvec());
+    }
+}
+
 inline void Simulation_context::print_info() const
 {
     tm const* ptm = localtime(&start_time_.tv_sec);
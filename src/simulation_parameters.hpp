@@ -150,10 +150,16 @@ public:
         parameters_input_.ngridk_           = args__.value("parameters.ngridk", parameters_input_.ngridk_);
         parameters_input_.gamma_point_      = args__.value("parameters.gamma_point", parameters_input_.gamma_point_);
         parameters_input_.pw_cutoff_        = args__.value("parameters.pw_cutoff", parameters_input_.pw_cutoff_);
+        parameters_input_.molecule_         = args__.value("parameters.molecule", parameters_input_.molecule_);
+        parameters_input_.molecule_poisson_solver_ = args__.value("parameters.molecule_poisson_solver",
+                                                                  parameters_input_.molecule_poisson_solver_);
 
         iterative_solver_input_.orthogonalize_ = args__.value("iterative_solver.orthogonalize",
                                                               iterative_solver_input_.orthogonalize_);
 
+        settings_input_.extrapolation_order_ = args__.value("settings.extrapolation_order",
+                                                            settings_input_.extrapolation_order_);
+
     }
 
     inline void set_lmax_apw(int lmax_apw__)
@@ -399,6 +399,21 @@ void sirius_update_context(void* const* handler__)
     sim_ctx.update();
 }
 
+/* @fortran begin function void sirius_rebind_context     Re-bind simulation context to a new structure.
+   @fortran argument in required void* handler            Simulation context handler.
+   @fortran details
+   The context must be initialized. New lattice vectors and atomic positions are set before this call using
+   sirius_set_lattice_vectors() and sirius_set_atom_position(). The atom types and cutoffs must stay the same.
+   G-vectors are regenerated for the new lattice while the radial integrals, atom types and FFT drivers
+   (if the FFT box is unchanged) are reused. All handlers of the objects that depend on the context (k-point sets,
+   ground state) must be re-created after this call.
+   @fortran end */
+void sirius_rebind_context(void* const* handler__)
+{
+    GET_SIM_CTX(handler__)
+    sim_ctx.rebind();
+}
+
 /* @fortran begin function void sirius_print_info      Print basic info
    @fortran argument in required void* handler         Simulation context handler.
    @fortran end */
@@ -555,13 +570,103 @@ void sirius_find_ground_state(void* const* gs_handler__, bool const *save__)
 
 /* @fortran begin function void sirius_update_ground_state   Update a ground state object after change of atomic coordinates or lattice vectors.
    @fortran argument in  required void*  gs_handler          Ground-state handler.
+   @fortran argument in  optional int    extrapolation_order Order of density and wave-function extrapolation between ionic steps.
+   @fortran details
+   If the extrapolation order is positive, the density, potential and wave-functions of the new atomic configuration
+   are predicted from the previous ionic steps and used as the starting point of the next call to
+   sirius_find_ground_state().
    @fortran end */
-void sirius_update_ground_state(void** handler__)
+void sirius_update_ground_state(void** handler__,
+                                int const* extrapolation_order__)
 {
     GET_GS(handler__)
+    if (extrapolation_order__ != nullptr) {
+        gs.extrapolation_order(*extrapolation_order__);
+    }
     gs.update();
 }
 
+/* @fortran begin function void sirius_run_batch         Run a batch of independent ground-state calculations.
+   @fortran argument in  required int    fcomm              Communicator shared by all calculations of the batch.
+   @fortran argument in  required string inputs             JSON array with the input dictionaries (or file names).
+   @fortran argument in  optional int    num_groups         Number of groups of MPI ranks.
+   @fortran argument out required string output             JSON array with the results of the calculations.
+   @fortran argument in  required int    output_len         Size of the output buffer.
+   @fortran details
+   The communicator is split into num_groups groups (by default, one group per calculation as long as there are
+   enough MPI ranks). Calculations are distributed between the groups in a round-robin fashion and the groups run
+   concurrently. Each element of the output array is the dictionary returned by DFT_ground_state::find(), i.e. the
+   serialized ground state with the convergence status. The output is identical on all ranks of fcomm.
+   @fortran end */
+void sirius_run_batch(int  const* fcomm__,
+                      char const* inputs__,
+                      int  const* num_groups__,
+                      char*       output__,
+                      int  const* output_len__)
+{
+    PROFILE("sirius_api::sirius_run_batch");
+
+    auto& comm = Communicator::map_fcomm(*fcomm__);
+
+    json inputs = json::parse(std::string(inputs__));
+    if (!inputs.is_array()) {
+        TERMINATE("list of inputs must be a JSON array");
+    }
+    int num_inputs = static_cast<int>(inputs.size());
+
+    int num_groups = (num_groups__ != nullptr) ? *num_groups__ : num_inputs;
+    num_groups     = std::max(1, std::min({num_groups, num_inputs, comm.size()}));
+
+    /* consecutive ranks form a group */
+    auto group_of_rank = [&](int r) { return static_cast<int>(static_cast<long>(r) * num_groups / comm.size()); };
+
+    int my_group = group_of_rank(comm.rank());
+    auto comm_group = comm.split(my_group);
+
+    /* rank of the group leader in the batch communicator */
+    std::vector<int> leader(num_groups, -1);
+    for (int r = comm.size() - 1; r >= 0; r--) {
+        leader[group_of_rank(r)] = r;
+    }
+
+    std::vector<std::string> results(num_inputs);
+
+    for (int i = my_group; i < num_inputs; i += num_groups) {
+        auto str = inputs[i].is_string() ? inputs[i].get<std::string>() : inputs[i].dump();
+
+        sirius::Simulation_context ctx(str, comm_group);
+        ctx.initialize();
+
+        auto& inp = ctx.parameters_input();
+
+        sirius::K_point_set kset(ctx, inp.ngridk_, inp.shiftk_, ctx.use_symmetry());
+        sirius::DFT_ground_state gs(kset);
+        gs.initial_state();
+        auto result = gs.find(inp.potential_tol_, inp.energy_tol_, inp.num_dft_iter_, false);
+
+        if (comm_group.rank() == 0) {
+            results[i] = result.dump();
+        }
+    }
+
+    /* collect results on all ranks */
+    json output = json::array();
+    for (int i = 0; i < num_inputs; i++) {
+        comm.bcast(results[i], leader[i % num_groups]);
+        output.push_back(json::parse(results[i]));
+    }
+
+    auto s = output.dump();
+    if (static_cast<int>(s.size()) + 1 > *output_len__) {
+        std::stringstream ss;
+        ss << "output buffer is too small" << std::endl
+           << "  required size : " << s.size() + 1 << std::endl
+           << "  provided size : " << *output_len__;
+        TERMINATE(ss);
+    }
+    std::copy(s.c_str(), s.c_str() + s.size() + 1, output__);
+}
+
 /* @fortran begin function void sirius_add_atom_type     Add new atom type to the unit cell.
    @fortran argument in  required void*  handler         Simulation context handler.
    @fortran argument in  required string label           Atom type unique label.
@@ -794,6 +899,29 @@ void sirius_set_atom_position(void*  const* handler__,
     sim_ctx.unit_cell().atom(*ia__ - 1).set_position(std::vector<double>(position__, position__ + 3));
 }
 
+/* @fortran begin function void* sirius_create_pw_coeffs_mapping   Create a mapping between the external and SIRIUS G-vectors.
+   @fortran argument in  required void*   handler                   Simulation context handler.
+   @fortran argument in  required int     ngv                       Local number of G-vectors.
+   @fortran argument in  required int     gvl                       List of G-vectors in lattice coordinates (Miller indices).
+   @fortran argument in  required int     comm                      MPI communicator used in distribution of G-vectors.
+   @fortran details
+   The communication plan between the external distribution of G-vectors and the distribution of SIRIUS is computed
+   once and can be passed to sirius_set_pw_coeffs() and sirius_get_pw_coeffs() instead of the list of G-vectors.
+   The communicator must contain the same ranks as the communicator of the simulation context and must stay valid
+   while the mapping is used. The mapping must be re-created after sirius_rebind_context(). The handler is released
+   with sirius_free_handler().
+   @fortran end */
+void* sirius_create_pw_coeffs_mapping(void* const* handler__,
+                                      int   const* ngv__,
+                                      int   const* gvl__,
+                                      int   const* comm__)
+{
+    GET_SIM_CTX(handler__);
+
+    return new utils::any_ptr(new remap_gvec_to_external(Communicator(MPI_Comm_f2c(*comm__)), sim_ctx.gvec(),
+                                                         *ngv__, gvl__));
+}
+
 /* @fortran begin function void sirius_set_pw_coeffs         Set plane-wave coefficients of a periodic function.
    @fortran argument in  required void*   handler            Ground state handler.
    @fortran argument in  required string  label              Label of the function.
@@ -802,6 +930,7 @@ void sirius_set_atom_position(void*  const* handler__,
    @fortran argument in  optional int     ngv                Local number of G-vectors.
    @fortran argument in  optional int     gvl                List of G-vectors in lattice coordinates (Miller indices).
    @fortran argument in  optional int     comm               MPI communicator used in distribution of G-vectors
+   @fortran argument in  optional void*   mapping            Handler of the G-vector mapping (replaces ngv, gvl and comm).
    @fortran end */
 void sirius_set_pw_coeffs(void*                const* handler__,
                           char                 const* label__,
@@ -809,7 +938,8 @@ void sirius_set_pw_coeffs(void*                const* handler__,
                           bool                 const* transform_to_rg__,
                           int                  const* ngv__,
                           int*                        gvl__,
-                          int                  const* comm__)
+                          int                  const* comm__,
+                          void*                const* mapping__)
 {
     PROFILE("sirius_api::sirius_set_pw_coeffs");
 
@@ -828,6 +958,36 @@ void sirius_set_pw_coeffs(void*                const* handler__,
             TERMINATE("wrong label");
         }
     } else {
+        std::map<std::string, sirius::Smooth_periodic_function<double>*> func = {
+            {"rho",   &gs.density().rho()},
+            {"rhoc",  &gs.density().rho_pseudo_core()},
+            {"magz",  &gs.density().magnetization(0)},
+            {"magx",  &gs.density().magnetization(1)},
+            {"magy",  &gs.density().magnetization(2)},
+            {"veff",  &gs.potential().effective_potential()},
+            {"bz",    &gs.potential().effective_magnetic_field(0)},
+            {"bx",    &gs.potential().effective_magnetic_field(1)},
+            {"by",    &gs.potential().effective_magnetic_field(2)},
+            {"vloc",  &gs.potential().local_potential()},
+            {"vxc",   &gs.potential().xc_potential()},
+            {"dveff", &gs.potential().dveff()},
+        };
+
+        if (!func.count(label)) {
+            TERMINATE("wrong label");
+        }
+        auto f = func.at(label);
+
+        if (mapping__ != nullptr) {
+            /* use the precomputed communication plan */
+            auto& m = static_cast<utils::any_ptr*>(*mapping__)->get<remap_gvec_to_external>();
+            m.remap_backward(pw_coeffs__, &f->f_pw_local(0));
+            if (transform_to_rg__ && *transform_to_rg__) {
+                f->fft_transform(1);
+            }
+            return;
+        }
+
         assert(ngv__ != nullptr);
         assert(gvl__ != nullptr);
         assert(comm__ != nullptr);
@@ -863,28 +1023,9 @@ void sirius_set_pw_coeffs(void*                const* handler__,
         }
         comm.allreduce(v.data(), gs.ctx().gvec().num_gvec());
 
-        std::map<std::string, sirius::Smooth_periodic_function<double>*> func = {
-            {"rho",   &gs.density().rho()},
-            {"rhoc",  &gs.density().rho_pseudo_core()},
-            {"magz",  &gs.density().magnetization(0)},
-            {"magx",  &gs.density().magnetization(1)},
-            {"magy",  &gs.density().magnetization(2)},
-            {"veff",  &gs.potential().effective_potential()},
-            {"bz",    &gs.potential().effective_magnetic_field(0)},
-            {"bx",    &gs.potential().effective_magnetic_field(1)},
-            {"by",    &gs.potential().effective_magnetic_field(2)},
-            {"vloc",  &gs.potential().local_potential()},
-            {"vxc",   &gs.potential().xc_potential()},
-            {"dveff", &gs.potential().dveff()},
-        };
-
-        try {
-            func.at(label)->scatter_f_pw(v);
-            if (transform_to_rg__ && *transform_to_rg__) {
-                func.at(label)->fft_transform(1);
-            }
-        } catch(...) {
-            TERMINATE("wrong label");
+        f->scatter_f_pw(v);
+        if (transform_to_rg__ && *transform_to_rg__) {
+            f->fft_transform(1);
         }
     }
 }
@@ -896,13 +1037,15 @@ void sirius_set_pw_coeffs(void*                const* handler__,
    @fortran argument in  optional int     ngv             Local number of G-vectors.
    @fortran argument in  optional int     gvl             List of G-vectors in lattice coordinates (Miller indices).
    @fortran argument in  optional int     comm            MPI communicator used in distribution of G-vectors
+   @fortran argument in  optional void*   mapping         Handler of the G-vector mapping (replaces ngv, gvl and comm).
    @fortran end */
 void sirius_get_pw_coeffs(void*                const* handler__,
                           char                 const* label__,
                           std::complex<double>*       pw_coeffs__,
                           int                  const* ngv__,
                           int*                        gvl__,
-                          int                  const* comm__)
+                          int                  const* comm__,
+                          void*                const* mapping__)
 {
     PROFILE("sirius_api::sirius_get_pw_coeffs");
 
@@ -912,13 +1055,6 @@ void sirius_get_pw_coeffs(void*                const* handler__,
     if (gs.ctx().full_potential()) {
         STOP();
     } else {
-        assert(ngv__ != NULL);
-        assert(gvl__ != NULL);
-        assert(comm__ != NULL);
-
-        Communicator comm(MPI_Comm_f2c(*comm__));
-        mdarray<int, 2> gvec(gvl__, 3, *ngv__);
-
         std::map<std::string, sirius::Smooth_periodic_function<double>*> func = {
             {"rho",  &gs.density().rho()},
             {"magz", &gs.density().magnetization(0)},
@@ -929,13 +1065,26 @@ void sirius_get_pw_coeffs(void*                const* handler__,
             {"rhoc", &gs.density().rho_pseudo_core()}
         };
 
-        std::vector<double_complex> v;
-        try {
-            v = func.at(label)->gather_f_pw();
-        } catch(...) {
+        if (!func.count(label)) {
             TERMINATE("wrong label");
         }
 
+        if (mapping__ != nullptr) {
+            /* use the precomputed communication plan */
+            auto& m = static_cast<utils::any_ptr*>(*mapping__)->get<remap_gvec_to_external>();
+            m.remap_forward(&func.at(label)->f_pw_local(0), pw_coeffs__);
+            return;
+        }
+
+        assert(ngv__ != NULL);
+        assert(gvl__ != NULL);
+        assert(comm__ != NULL);
+
+        Communicator comm(MPI_Comm_f2c(*comm__));
+        mdarray<int, 2> gvec(gvl__, 3, *ngv__);
+
+        auto v = func.at(label)->gather_f_pw();
+
         for (int i = 0; i < *ngv__; i++) {
             vector3d<int> G(gvec(0, i), gvec(1, i), gvec(2, i));
 
@@ -146,6 +146,60 @@ class Spheric_function: public mdarray<T, 2>
 
 };
 
+/// Set of spheric functions stored one after another in a single array.
+/** The functions have the same angular domain size and the same radial grid. Because the storage is contiguous,
+ *  the whole set is transformed between the spectral and spatial domains by a single in-place GEMM. */
+template <function_domain_t domain_t, typename T = double_complex>
+class Spheric_function_set
+{
+    private:
+
+        /// Storage for all functions.
+        mdarray<T, 3> data_;
+
+        /// Individual functions wrapping the slices of data_.
+        std::vector<Spheric_function<domain_t, T>> f_;
+
+        Spheric_function_set(Spheric_function_set<domain_t, T> const& src__) = delete;
+
+        Spheric_function_set<domain_t, T>& operator=(Spheric_function_set<domain_t, T> const& src__) = delete;
+
+    public:
+
+        Spheric_function_set()
+        {
+        }
+
+        Spheric_function_set(int num_functions__, int angular_domain_size__, Radial_grid<double> const& radial_grid__)
+            : data_(angular_domain_size__, radial_grid__.num_points(), num_functions__)
+        {
+            for (int i = 0; i < num_functions__; i++) {
+                f_.push_back(Spheric_function<domain_t, T>(&data_(0, 0, i), angular_domain_size__, radial_grid__));
+            }
+        }
+
+        Spheric_function_set(Spheric_function_set<domain_t, T>&& src__) = default;
+
+        Spheric_function_set<domain_t, T>& operator=(Spheric_function_set<domain_t, T>&& src__) = default;
+
+        inline int size() const
+        {
+            return static_cast<int>(f_.size());
+        }
+
+        inline Spheric_function<domain_t, T>& operator[](int i__)
+        {
+            assert(i__ >= 0 && i__ < size());
+            return f_[i__];
+        }
+
+        inline Spheric_function<domain_t, T> const& operator[](int i__) const
+        {
+            assert(i__ >= 0 && i__ < size());
+            return f_[i__];
+        }
+};
+
 /// Multiplication of two functions in spatial domain.
 template <typename T>
 Spheric_function<spatial, T> operator*(Spheric_function<spatial, T> const& a__, Spheric_function<spatial, T> const& b__)
@@ -258,13 +312,11 @@ T inner(Spheric_function<domain_t, T> const& f1, Spheric_function<domain_t, T> c
  *  \f]
  */
 template <typename T>
-Spheric_function<spectral, T> laplacian(Spheric_function<spectral, T> const& f__)
+void laplacian(Spheric_function<spectral, T> const& f__, Spheric_function<spectral, T>& g__)
 {
-    Spheric_function<spectral, T> g;
     auto& rgrid = f__.radial_grid();
     int lmmax = f__.angular_domain_size();
     int lmax = utils::lmax(lmmax);
-    g = Spheric_function<spectral, T>(lmmax, rgrid);
 
     Spline<T> s1(rgrid);
     for (int l = 0; l <= lmax; l++) {
@@ -280,11 +332,18 @@ Spheric_function<spectral, T> laplacian(Spheric_function<spectral, T> const& f__
             s1.interpolate();
 
             for (int ir = 0; ir < s.num_points(); ir++) {
-                g(lm, ir) = 2 * s1(ir) * rgrid.x_inv(ir) + s1.deriv(1, ir) - s(ir) * ll / std::pow(rgrid[ir], 2);
+                g__(lm, ir) = 2 * s1(ir) * rgrid.x_inv(ir) + s1.deriv(1, ir) - s(ir) * ll / std::pow(rgrid[ir], 2);
             }
         }
     }
+}
 
+/// Compute Laplacian of the spheric function.
+template <typename T>
+Spheric_function<spectral, T> laplacian(Spheric_function<spectral, T> const& f__)
+{
+    Spheric_function<spectral, T> g(f__.angular_domain_size(), f__.radial_grid());
+    laplacian(f__, g);
     return std::move(g);
 }
 
@@ -383,7 +442,70 @@ Spheric_function<spectral, T> transform(SHT* sht__, Spheric_function<spatial, T>
     return std::move(g);
 }
 
+/// Transform a set of functions to spatial domain and store the result in the existing set.
+template <typename T>
+void transform(SHT* sht__, Spheric_function_set<spectral, T> const& f__, Spheric_function_set<spatial, T>& g__)
+{
+    assert(f__.size() == g__.size());
+
+    int nf = f__.size();
+    if (nf == 0) {
+        return;
+    }
+    auto& rgrid = f__[0].radial_grid();
+    int ld = f__[0].angular_domain_size();
+
+    std::vector<T const*> flm;
+    std::vector<T*> ftp;
+    for (int i = 0; i < nf; i++) {
+        flm.push_back(&f__[i](0, 0));
+        ftp.push_back(&g__[i](0, 0));
+    }
+    sht__->backward_transform(ld, flm, rgrid.num_points(), std::min(sht__->lmmax(), ld), ftp);
+}
+
+/// Transform a set of functions to spectral domain and store the result in the existing set.
+template <typename T>
+void transform(SHT* sht__, Spheric_function_set<spatial, T> const& f__, Spheric_function_set<spectral, T>& g__)
+{
+    assert(f__.size() == g__.size());
+
+    int nf = f__.size();
+    if (nf == 0) {
+        return;
+    }
+    auto& rgrid = f__[0].radial_grid();
+
+    std::vector<T const*> ftp;
+    std::vector<T*> flm;
+    for (int i = 0; i < nf; i++) {
+        ftp.push_back(&f__[i](0, 0));
+        flm.push_back(&g__[i](0, 0));
+    }
+    sht__->forward_transform(ftp, rgrid.num_points(), sht__->lmmax(), sht__->lmmax(), flm);
+}
+
+/// Transform a set of functions to spatial domain.
+template <typename T>
+Spheric_function_set<spatial, T> transform(SHT* sht__, Spheric_function_set<spectral, T> const& f__)
+{
+    Spheric_function_set<spatial, T> g(f__.size(), sht__->num_points(), f__[0].radial_grid());
+    transform(sht__, f__, g);
+    return std::move(g);
+}
+
+/// Transform a set of functions to spectral domain.
+template <typename T>
+Spheric_function_set<spectral, T> transform(SHT* sht__, Spheric_function_set<spatial, T> const& f__)
+{
+    Spheric_function_set<spectral, T> g(f__.size(), sht__->lmmax(), f__[0].radial_grid());
+    transform(sht__, f__, g);
+    return std::move(g);
+}
+
 /// Gradient of a spheric function.
+/** The three components are stored in a Spheric_function_set and are transformed between the spectral and spatial
+ *  domains at once. */
 template <function_domain_t domain_t, typename T = double_complex>
 class Spheric_function_gradient
 {
@@ -391,15 +513,20 @@ class Spheric_function_gradient
 
         Radial_grid<double> const* radial_grid_{nullptr};
 
-        int angular_domain_size_;
+        int angular_domain_size_{0};
 
-        std::array<Spheric_function<domain_t, T>, 3> grad_;
+        Spheric_function_set<domain_t, T> grad_;
     
     public:
 
+        Spheric_function_gradient()
+        {
+        }
+
         Spheric_function_gradient(int angular_domain_size__, Radial_grid<double> const& radial_grid__) 
             : radial_grid_(&radial_grid__)
             , angular_domain_size_(angular_domain_size__)
+            , grad_(3, angular_domain_size__, radial_grid__)
         {
         }
 
@@ -424,14 +551,32 @@ class Spheric_function_gradient
             assert(x >= 0 && x < 3);
             return grad_[x];
         }
+
+        inline Spheric_function_set<domain_t, T>& components()
+        {
+            return grad_;
+        }
+
+        inline Spheric_function_set<domain_t, T> const& components() const
+        {
+            return grad_;
+        }
 };
 
+/// Transform the gradient to spatial domain.
+template <typename T>
+Spheric_function_gradient<spatial, T> transform(SHT* sht__, Spheric_function_gradient<spectral, T> const& f__)
+{
+    Spheric_function_gradient<spatial, T> g(sht__->num_points(), f__.radial_grid());
+    transform(sht__, f__.components(), g.components());
+    return std::move(g);
+}
+
 /// Gradient of the function in complex spherical harmonics.
 inline Spheric_function_gradient<spectral, double_complex> gradient(Spheric_function<spectral, double_complex>& f)
 {
     Spheric_function_gradient<spectral, double_complex> g(f.angular_domain_size(), f.radial_grid());
     for (int i = 0; i < 3; i++) {
-        g[i] = Spheric_function<spectral, double_complex>(f.angular_domain_size(), f.radial_grid());
         g[i].zero();
     }
 
@@ -490,7 +635,8 @@ inline Spheric_function_gradient<spectral, double> gradient(Spheric_function<spe
     auto zg = gradient(zf);
     Spheric_function_gradient<spectral, double> g(f.angular_domain_size(), f.radial_grid());
     for (int x: {0, 1, 2}) {
-        g[x] = convert(zg[x]);
+        auto gx = convert(zg[x]);
+        std::copy(&gx(0, 0), &gx(0, 0) + gx.size(), &g[x](0, 0));
     }
     return g;
 }
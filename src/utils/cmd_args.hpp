@@ -217,6 +217,16 @@ inline std::vector<double> cmd_args::value<std::vector<double>>(const std::strin
     return get_vector<double>(key__);
 }
 
+template <>
+inline std::vector<double> cmd_args::value<std::vector<double>>(std::string const key__,
+                                                                std::vector<double> const default_val__) const
+{
+    if (!exist(key__)) {
+        return default_val__;
+    }
+    return get_vector<double>(key__);
+}
+
 template <>
 inline std::vector<int> cmd_args::value<std::vector<int>>(const std::string key__) const
 {
@@ -30,6 +30,7 @@
 #if defined(__APEX)
 #include <apex_api.hpp>
 #endif
+#include <omp.h>
 #include <string>
 #include <sstream>
 #include <chrono>
@@ -145,6 +146,11 @@ class timer
         : label_(label__)
         , active_(true)
     {
+        /* timer stack and statistics are shared; don't time the calls from inside the parallel regions */
+        if (omp_in_parallel()) {
+            active_ = false;
+            return;
+        }
         /* measure the starting time */
         starting_time_ = std::chrono::high_resolution_clock::now();
         /* add timer label to the list of called timers */
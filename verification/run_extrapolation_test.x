@@ -0,0 +1,44 @@
+#!/bin/bash
+
+# Short relaxation of the displaced LiF (PAW) with and without the extrapolation of density and wave-functions
+# between the ionic steps; the extrapolation must reduce the number of SCF iterations.
+
+if [ -z "$SIRIUS_BINARIES" ];
+then
+    export SIRIUS_BINARIES=$(pwd)/../build/apps/dft_loop
+fi
+
+if [[ $HOST == nid* ]]; then
+    SRUN_CMD=srun
+else
+    SRUN_CMD=""
+fi
+
+exe=${SIRIUS_BINARIES}/sirius.scf
+# check if path is correct
+type -f ${exe} || exit 1
+
+cd ./test15
+
+num_iter=()
+for order in 0 2; do
+    echo "running relaxation with extrapolation_order=${order}"
+    ${SRUN_CMD} ${exe} --relax_steps=3 --settings.extrapolation_order=${order} --output=output_extrapolation_${order}.json
+    err=$?
+    if [ ${err} != 0 ]; then
+      echo "relaxation with extrapolation_order=${order} failed"
+      exit ${err}
+    fi
+    # number of SCF iterations of the ionic steps after the first one
+    n=$(python3 -c "import json; d = json.load(open('output_extrapolation_${order}.json')); print(sum(d['ground_state']['relax']['num_scf_iterations'][1:]))")
+    num_iter+=(${n})
+done
+rm -f output_extrapolation_*.json
+
+echo "number of SCF iterations: ${num_iter[0]} (extrapolation_order=0), ${num_iter[1]} (extrapolation_order=2)"
+if [ ${num_iter[1]} -ge ${num_iter[0]} ]; then
+    echo "extrapolation did not reduce the number of SCF iterations"
+    exit 1
+fi
+
+echo "OK"
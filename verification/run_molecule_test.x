@@ -0,0 +1,54 @@
+#!/bin/bash
+
+# He atom in a box (input of test2) with the free-boundary (Hockney) Poisson solver against the periodic solver;
+# for the compact, neutral and spherical charge both must give the same total energy.
+# The free-boundary solver is not compatible with the periodic local potential and Ewald energy of the
+# pseudopotential case (input of test1), where it must be rejected.
+
+if [ -z "$SIRIUS_BINARIES" ];
+then
+    export SIRIUS_BINARIES=$(pwd)/../build/apps/dft_loop
+fi
+
+if [[ $HOST == nid* ]]; then
+    SRUN_CMD=srun
+else
+    SRUN_CMD=""
+fi
+
+exe=${SIRIUS_BINARIES}/sirius.scf
+# check if path is correct
+type -f ${exe} || exit 1
+
+cd ./test2
+
+echo "running with the periodic Poisson solver"
+${SRUN_CMD} ${exe} --parameters.molecule=0 --output=output_periodic.json || exit 1
+echo "running with the free-boundary Poisson solver"
+${SRUN_CMD} ${exe} --parameters.molecule=1 --parameters.molecule_poisson_solver=hockney --output=output_hockney.json || exit 1
+
+python3 - <<PY
+import json, sys
+e1 = json.load(open('output_periodic.json'))['ground_state']['energy']['total']
+e2 = json.load(open('output_hockney.json'))['ground_state']['energy']['total']
+print('total energy: %18.10f (periodic), %18.10f (free boundary), difference: %12.6e' % (e1, e2, abs(e1 - e2)))
+sys.exit(0 if abs(e1 - e2) < 1e-5 else 1)
+PY
+err=$?
+rm -f output_periodic.json output_hockney.json
+if [ ${err} != 0 ]; then
+    echo "free-boundary and periodic solvers give different energies"
+    exit ${err}
+fi
+
+cd ../test1
+
+echo "running the pseudopotential case with the free-boundary Poisson solver"
+if ${SRUN_CMD} ${exe} --parameters.molecule=1 --parameters.molecule_poisson_solver=hockney --output=output_hockney.json; then
+    rm -f output_hockney.json
+    echo "free-boundary solver is not rejected in the pseudopotential case"
+    exit 1
+fi
+rm -f output_hockney.json
+
+echo "OK"